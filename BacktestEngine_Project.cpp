@@ -1,17 +1,33 @@
+#include <algorithm>
 #include <vector>
 #include <iostream>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <random>
 
 #include "Tick.h"
 #include "TimeFrame.h"
+#include "BatchGBMGenerator.h"
+#include "DatasetCache.h"
 #include "GBMJumpGenerator.h"
 #include "QuoteGBMJumpGenerator.h"
 #include "BacktestEngine.h"
+#include "BacktestServer.h"
+#include "SweepCoordinator.h"
+#include "MonteCarlo.h"
 #include "MeanReversionSimpleStrategy.h"
 #include "BreakoutStrategy.h"
 #include "SpreadStrategy.h"
 
+// Above this many ticks, generated data is streamed instead of held in memory
+constexpr size_t MAX_IN_MEMORY_TICKS = 1000000;
+
+// Longest path the generators can produce
+constexpr size_t MAX_TICKS = size_t(1) << 33;
+
 /**
  * @brief Parses command line arguments or environment variables
  * 
@@ -49,8 +65,8 @@ bool parseArguments(int argc, char* argv[], size_t& numTicks, double& initialCap
     }
     
     // Validate inputs
-    if (numTicks < 10 || numTicks > 100000) {
-        std::cerr << "Error: num_ticks must be between 10 and 100000\n";
+    if (numTicks < 10 || numTicks > MAX_TICKS) {
+        std::cerr << "Error: num_ticks must be between 10 and " << MAX_TICKS << "\n";
         return false;
     }
     if (initialCapital <= 0 || initialCapital > 100000000) {
@@ -61,12 +77,237 @@ bool parseArguments(int argc, char* argv[], size_t& numTicks, double& initialCap
     return true;
 }
 
+/**
+ * @brief Returns the seed of the generated data: SEED if set, random otherwise
+ */
+uint64_t readSeed() {
+    if (const char* envSeed = std::getenv("SEED")) return std::stoull(envSeed);
+    std::random_device rd;
+    return (uint64_t(rd()) << 32) | rd();
+}
+
+/**
+ * @brief Runs each strategy over many generated paths and prints the distribution of its statistics
+ * 
+ * Paths are generated on the fly by every worker, so memory doesn't depend on
+ * the number of paths. Each strategy's summary is saved as <name>_montecarlo.csv.
+ * 
+ * @param numTicks Ticks per path
+ * @param initialCapital Starting capital on every path
+ * @param paths Number of paths (value of MONTE_CARLO_PATHS)
+ * @return 0 on success, 1 on error
+ */
+int runMonteCarlo(size_t numTicks, double initialCapital, const char* paths) {
+    try {
+        const size_t pathCount = std::stoul(paths);
+        const uint64_t seed = readSeed();
+        std::cout << "Seed: " << seed << "\n";
+
+        const MonteCarlo monteCarlo(BatchGBMGenerator(numTicks, TimeFrame::MINUTE, seed));
+        const std::vector<std::pair<std::string, StrategyBuilder>> strategies = {
+            { "Mean_Reversion", [] { return std::make_unique<MeanReversionSimple>(); } },
+            { "Breakout_Win20", [] { return std::make_unique<BreakoutStrategy<20>>(); } },
+            { "Spread", [] { return std::make_unique<SpreadStrategy>(); } },
+        };
+
+        for (const auto& [name, builder] : strategies) {
+            const std::vector<MonteCarloReport> reports = summarizeMonteCarlo(monteCarlo.run(0, pathCount, builder, TimeFrame::MINUTE, initialCapital));
+            exportMonteCarloToCSV(name + "_montecarlo.csv", reports);
+            for (const MonteCarloReport& report : reports) {
+                std::cout << name << " " << report.metric << ": mean " << report.mean << ", p5 " << report.p05
+                          << ", p50 " << report.p50 << ", p95 " << report.p95 << ", CVaR(5%) " << report.cvar
+                          << " (" << report.paths << " paths)\n";
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns true if a data file path names a CSV file (by its extension)
+ */
+bool isCsvPath(const char* path) {
+    const size_t length = std::strlen(path);
+    return length >= 4 && std::strcmp(path + length - 4, ".csv") == 0;
+}
+
+/**
+ * @brief Converts a CSV tick file into a binary tick file, so later runs map it instead of parsing it
+ * 
+ * Usage: ./BacktestEngine --convert-csv trades|quotes <input.csv> <output.ticks>
+ * 
+ * @return 0 on success, 1 on error
+ */
+int runConvertCsv(int argc, char* argv[]) {
+    if (argc != 5 || (std::strcmp(argv[2], "trades") != 0 && std::strcmp(argv[2], "quotes") != 0)) {
+        std::cerr << "Usage: " << argv[0] << " --convert-csv trades|quotes <input.csv> <output.ticks>\n";
+        return 1;
+    }
+    try {
+        const TickRecordType type = std::strcmp(argv[2], "quotes") == 0 ? TickRecordType::QUOTE : TickRecordType::TRADE;
+        const size_t records = convertCsvToTickFile(argv[3], argv[4], type);
+        std::cout << "Converted " << records << " " << argv[2] << " to " << argv[4] << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Runs the engine as a long-lived backtest server until it is shut down
+ * 
+ * Usage: ./BacktestEngine --serve [port]
+ * Environment variables:
+ *   SERVE_BIND: Address to listen on (default 127.0.0.1, use 0.0.0.0 inside a container)
+ *   SERVE_WORKERS: Number of backtests run at the same time (default: one per hardware thread)
+ *   SERVE_CACHE_DIR: Directory where generated datasets are cached across restarts
+ * 
+ * See BacktestServer for the JSON protocol.
+ * 
+ * @return 0 after a clean shutdown, 1 on error
+ */
+int runServer(int argc, char* argv[]) {
+    ServerConfig config;
+    try {
+        if (argc >= 3) config.port = static_cast<uint16_t>(std::stoul(argv[2]));
+        if (const char* bind = std::getenv("SERVE_BIND")) config.bindAddress = bind;
+        if (const char* workers = std::getenv("SERVE_WORKERS")) config.workerCount = std::stoul(workers);
+        if (const char* cacheDir = std::getenv("SERVE_CACHE_DIR")) config.cacheDirectory = cacheDir;
+
+        BacktestServer server(config);
+        server.run([&](uint16_t port) {
+            std::cout << "Listening on " << config.bindAddress << ":" << port << std::endl;
+        });
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Parses one sweep axis: name=start:stop:step or name=v1,v2,...
+ */
+void addSweepAxis(ParameterGrid& grid, std::vector<std::string>& names, const std::string& axis) {
+    const size_t equals = axis.find('=');
+    if (equals == std::string::npos || equals == 0) {
+        throw std::invalid_argument("Sweep axis '" + axis + "' must be name=start:stop:step or name=v1,v2,...");
+    }
+    const std::string name = axis.substr(0, equals);
+    const std::string values = axis.substr(equals + 1);
+
+    if (std::count(values.begin(), values.end(), ':') == 2) {
+        const size_t first = values.find(':');
+        const size_t second = values.find(':', first + 1);
+        grid.addRange(name, std::stod(values.substr(0, first)), std::stod(values.substr(first + 1, second - first - 1)), std::stod(values.substr(second + 1)));
+    } else {
+        std::vector<double> list;
+        for (size_t begin = 0; begin <= values.size(); ) {
+            size_t end = values.find(',', begin);
+            if (end == std::string::npos) end = values.size();
+            list.push_back(std::stod(values.substr(begin, end - begin)));
+            begin = end + 1;
+        }
+        grid.add(name, std::move(list));
+    }
+    names.push_back(name);
+}
+
+/**
+ * @brief Runs a parameter sweep on a cluster of backtest servers and saves the statistics of every variant
+ * 
+ * Usage: ./BacktestEngine --coordinate <host:port,...> <strategy> [name=start:stop:step | name=v1,v2,...]...
+ * Each worker is a BacktestEngine --serve process; see SweepCoordinator for the scheduling.
+ * The strategies and parameters are the sweepable ones of BacktestServer.
+ * Environment variables:
+ *   NUM_TICKS, SEED, INITIAL_CAPITAL: Dataset and capital, as for a local run
+ *   SHARD_SIZE: Variants per request sent to a worker (default: chosen from the grid and the cluster)
+ *   SHARD_THREADS: Threads a worker gives each shard (default 1)
+ * 
+ * Results are saved as <strategy>_sweep.csv, one row per variant.
+ * 
+ * @return 0 on success, 1 on error
+ */
+int runCoordinator(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " --coordinate <host:port,...> <strategy> [name=start:stop:step | name=v1,v2,...]...\n";
+        return 1;
+    }
+    try {
+        CoordinatorConfig config;
+        const std::string workers = argv[2];
+        for (size_t begin = 0; begin <= workers.size(); ) {
+            size_t end = workers.find(',', begin);
+            if (end == std::string::npos) end = workers.size();
+            if (end > begin) config.workers.push_back(workers.substr(begin, end - begin));
+            begin = end + 1;
+        }
+        if (const char* shardSize = std::getenv("SHARD_SIZE")) config.shardSize = std::stoul(shardSize);
+        if (const char* threads = std::getenv("SHARD_THREADS")) config.threadsPerShard = std::stoul(threads);
+
+        const std::string strategy = argv[3];
+        ParameterGrid grid;
+        std::vector<std::string> names;
+        for (int a = 4; a < argc; a++) addSweepAxis(grid, names, argv[a]);
+        if (names.empty()) throw std::invalid_argument("A sweep needs at least one parameter axis.");
+
+        const size_t numTicks = std::getenv("NUM_TICKS") ? std::stoul(std::getenv("NUM_TICKS")) : 1000;
+        const double capital = std::getenv("INITIAL_CAPITAL") ? std::stod(std::getenv("INITIAL_CAPITAL")) : 10000.0;
+        const uint64_t seed = readSeed() & ((uint64_t(1) << 53) - 1);  // Seeds travel as JSON numbers
+        std::cout << "Seed: " << seed << "\n";
+
+        SweepCoordinator coordinator(config);
+        const std::vector<SweepResult> results = coordinator.run(numTicks, seed, strategy, grid, capital);
+        const CoordinatorReport& report = coordinator.getReport();
+        for (const std::string& failure : report.unreachable) std::cerr << "Warning: worker left out: " << failure << "\n";
+        std::cout << results.size() << " variants on " << report.workers << " workers (" << report.unreachable.size()
+                  << " unreachable), " << report.shards << " shards ("
+                  << report.backups << " backups, " << report.requeued << " requeued)\n";
+
+        // Columns: the parameters in axis order, then the metrics by name
+        std::map<std::string, double> firstStats;
+        if (!results.empty()) firstStats.insert(results.front().stats.begin(), results.front().stats.end());
+        const std::string filename = strategy + "_sweep.csv";
+        std::ofstream file(filename);
+        if (!file.is_open()) throw std::runtime_error("Cannot open sweep file '" + filename + "'");
+        file << "Index";
+        for (const std::string& name : names) file << "," << name;
+        for (const auto& [metric, value] : firstStats) file << "," << metric;
+        file << "\n";
+        for (const SweepResult& result : results) {
+            file << result.index;
+            for (const std::string& name : names) file << "," << result.params.at(name);
+            for (const auto& [metric, value] : firstStats) file << "," << result.stats.at(metric);
+            file << "\n";
+        }
+        if (!file) throw std::runtime_error("Cannot write sweep file '" + filename + "'");
+        std::cout << "Saved " << filename << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
 /**
  * @brief Main entry point of the backtesting engine
  * 
  * This program demonstrates the complete backtesting workflow:
  * 1. Parse command line arguments or environment variables for configuration
- * 2. Generate synthetic market data (ticks) using GBM + Jump model
+ * 2. Generate synthetic market data (ticks) using GBM + Jump model,
+ *    or memory-map recorded ticks from binary tick files. Beyond
+ *    MAX_IN_MEMORY_TICKS, generated ticks are streamed chunk by chunk and
+ *    only the online statistics are kept (the PnL CSV holds just its header),
+ *    so the data and the results stay bounded however many ticks are requested.
+ *    Streaming only changes where the ticks come from, never what the
+ *    strategies do: Spread keeps stacking a new pair of orders on every tick,
+ *    and the ones left resting (about 0.5 per tick on generated data, some
+ *    75 bytes of book per tick: 50 MB at 1M ticks, 370 MB at 5M) are the one
+ *    cost that still grows with the run
  * 3. Create a backtest engine and load the market data
  * 4. Register multiple trading strategies to test
  * 5. Run all strategies in parallel on the same market data
@@ -77,10 +318,28 @@ bool parseArguments(int argc, char* argv[], size_t& numTicks, double& initialCap
  * 
  * Command line usage:
  *   ./BacktestEngine [num_ticks] [initial_capital]
+ *   ./BacktestEngine --serve [port]     (server mode, see runServer())
+ *   ./BacktestEngine --convert-csv ...  (CSV to binary tick file, see runConvertCsv())
+ *   ./BacktestEngine --coordinate ...   (sweep on worker servers, see runCoordinator())
  * 
  * Environment variables (used by web interface):
  *   NUM_TICKS: Number of ticks to generate
  *   INITIAL_CAPITAL: Starting capital for each strategy
+ *   TICK_FILE: Binary (or .csv) trade tick file to backtest on instead of generated ticks
+ *   QUOTE_FILE: Binary (or .csv) quote tick file to backtest on instead of generated quotes
+ *   SEED: Seed of the generated data (default: random, printed so the run can be repeated)
+ *   DATASET_CACHE: Directory caching generated datasets, reused by runs with the same seed
+ *   RESULT_FORMAT: "binary" to save <name>_results.bin instead of <name>_pnl.csv
+ *   RESULT_MAX_POINTS: Add the PnL series decimated to at most this many points to the binary results
+ *   LATENCY, SLIPPAGE, FEE_RATE, FEE_PER_UNIT: Simulate fills with an ExecutionModel
+ *     (any of them set: latency, queue positions, partial fills and costs)
+ *   PORTFOLIO_CAPITAL: Run the strategies as one book sharing this capital, with the
+ *     pre-trade limits MAX_ORDER_VOLUME, MAX_POSITION and MAX_LEVERAGE (all optional)
+ *   PROFILE_INTERVAL: Time one tick out of this many (builds with BACKTEST_INSTRUMENT only)
+ *   THREAD_PLACEMENT: "pinned" to pin the workers to CPUs spread over the NUMA nodes,
+ *     "numa" to also give each node its own copy of the ticks
+ *   MONTE_CARLO_PATHS: Instead of one backtest, run every strategy over this many
+ *     generated paths of num_ticks ticks and report its statistics' distribution
  * 
  * @param argc Number of command line arguments
  * @param argv Command line arguments array
@@ -88,6 +347,16 @@ bool parseArguments(int argc, char* argv[], size_t& numTicks, double& initialCap
  */
 int main(int argc, char* argv[])
 {
+    if (argc >= 2 && std::strcmp(argv[1], "--serve") == 0) {
+        return runServer(argc, argv);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "--convert-csv") == 0) {
+        return runConvertCsv(argc, argv);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "--coordinate") == 0) {
+        return runCoordinator(argc, argv);
+    }
+
     // Parse configuration from command line or environment variables
     size_t numTicks;
     double initialCapital;
@@ -95,53 +364,147 @@ int main(int argc, char* argv[])
         return 1;
     }
 
+    if (const char* paths = std::getenv("MONTE_CARLO_PATHS")) {
+        return runMonteCarlo(numTicks, initialCapital, paths);
+    }
+
     // ========================================================================
-    // STEP 1: Generate synthetic market data (ticks)
-    // ========================================================================
-    
-    // Create a generator for regular trade ticks using Geometric Brownian Motion + Jump model
-    // Parameters: numTicks (from command line/env), 1-minute time frame
-    // This simulates realistic price movements with random jumps
-    std::unique_ptr<GBMJumpGenerator> jumpGenerator = 
-        std::make_unique<GBMJumpGenerator>(numTicks, TimeFrame::MINUTE);
-    std::vector<Tick> ticks = jumpGenerator->generateTicks();
-
-    // Create a generator for quote ticks (bid/ask prices)
-    // Some strategies need to see the bid-ask spread, not just trade prices
-    std::unique_ptr<QuoteGBMJumpGenerator> quoteJumpGenerator = 
-        std::make_unique<QuoteGBMJumpGenerator>(numTicks, TimeFrame::MINUTE);
-    std::vector<QuoteTick> quoteTicks = quoteJumpGenerator->generateTicks();
-    
-    // ========================================================================
-    // STEP 2: Initialize the backtest engine and load market data
+    // STEP 1 & 2: Load market data into the backtest engine
     // ========================================================================
     
     BacktestEngine engine;
-    // Load regular trade ticks (for strategies that use Tick)
-    engine.setTickData(std::move(ticks));
-    // Load quote ticks (for strategies that use QuoteTick, like SpreadStrategy)
-    engine.setTickData(std::move(quoteTicks));
+
+    // Use recorded market data from binary tick files if given (memory-mapped, not loaded into RAM)
+    // or from CSV files (parsed in parallel), otherwise generate synthetic data
+    const char* tickFile = std::getenv("TICK_FILE");
+    const char* quoteFile = std::getenv("QUOTE_FILE");
+
+    // Large runs: generate the paths on the fly while the strategies consume them
+    const bool streaming = numTicks > MAX_IN_MEMORY_TICKS;
+    if (streaming) engine.setStoreSeries(false);
+
+    try {
+        // One seed for trades and quotes (the quotes' mid-price is the trade path)
+        const uint64_t seed = readSeed();
+        if (!tickFile || !quoteFile) std::cout << "Seed: " << seed << "\n";
+
+        // Generated datasets are looked up on disk first, keyed by their parameters and seed
+        std::unique_ptr<DatasetCache> cache;
+        const char* cacheDir = std::getenv("DATASET_CACHE");
+        if (cacheDir && !streaming) cache = std::make_unique<DatasetCache>(1, cacheDir);
+        const DatasetKey key{ numTicks, TimeFrame::MINUTE, seed };
+
+        if (tickFile && isCsvPath(tickFile)) {
+            engine.loadTickCsv(tickFile);
+        } else if (tickFile) {
+            engine.loadTickFile(tickFile);
+        } else if (streaming) {
+            engine.setTickStream(BatchGBMGenerator(numTicks, TimeFrame::MINUTE, seed).streamTicks());
+        } else if (cache) {
+            engine.setTickData(cache->ticks(key));
+        } else {
+            // Create a generator for regular trade ticks using Geometric Brownian Motion + Jump model
+            // Parameters: numTicks (from command line/env), 1-minute time frame
+            // This simulates realistic price movements with random jumps
+            std::unique_ptr<GBMJumpGenerator> jumpGenerator = 
+                std::make_unique<GBMJumpGenerator>(numTicks, TimeFrame::MINUTE);
+            jumpGenerator->setSeed(seed);
+            // Load regular trade ticks (for strategies that use Tick)
+            engine.setTickData(jumpGenerator->generateTicks());
+        }
+
+        if (quoteFile && isCsvPath(quoteFile)) {
+            engine.loadQuoteCsv(quoteFile);
+        } else if (quoteFile) {
+            engine.loadQuoteFile(quoteFile);
+        } else if (streaming) {
+            engine.setQuoteStream(BatchGBMGenerator(numTicks, TimeFrame::MINUTE, seed).streamQuotes());
+        } else if (cache) {
+            engine.setTickData(cache->quotes(key));
+        } else {
+            // Create a generator for quote ticks (bid/ask prices)
+            // Some strategies need to see the bid-ask spread, not just trade prices
+            std::unique_ptr<QuoteGBMJumpGenerator> quoteJumpGenerator = 
+                std::make_unique<QuoteGBMJumpGenerator>(numTicks, TimeFrame::MINUTE);
+            quoteJumpGenerator->setSeed(seed);
+            // Load quote ticks (for strategies that use QuoteTick, like SpreadStrategy)
+            engine.setTickData(quoteJumpGenerator->generateTicks());
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
     
+    // Binary results (columnar PnL, returns and fills), optionally with a decimated copy for charts, and fill simulation
+    const char* resultFormat = std::getenv("RESULT_FORMAT");
+    const char* resultMaxPoints = std::getenv("RESULT_MAX_POINTS");
+    try {
+        if (resultFormat && std::strcmp(resultFormat, "binary") == 0) {
+            engine.setResultFormat(ResultFormat::BINARY);
+        }
+        if (resultMaxPoints) {
+            engine.setResultMaxPoints(std::stoul(resultMaxPoints));
+        }
+
+        // Realistic fills instead of the naive matcher
+        const char* latency = std::getenv("LATENCY");
+        const char* slippage = std::getenv("SLIPPAGE");
+        const char* feeRate = std::getenv("FEE_RATE");
+        const char* feePerUnit = std::getenv("FEE_PER_UNIT");
+        if (latency || slippage || feeRate || feePerUnit) {
+            ExecutionModel model;
+            if (latency) model.latency = std::stoull(latency);
+            if (slippage) model.slippage = std::stod(slippage);
+            if (feeRate) model.feeRate = std::stod(feeRate);
+            if (feePerUnit) model.feePerUnit = std::stod(feePerUnit);
+            engine.setExecutionModel(model);
+        }
+
+        if (const char* capital = std::getenv("PORTFOLIO_CAPITAL")) {
+            RiskLimits limits;
+            if (const char* v = std::getenv("MAX_ORDER_VOLUME")) limits.maxOrderVolume = std::stod(v);
+            if (const char* v = std::getenv("MAX_POSITION")) limits.maxPosition = std::stod(v);
+            if (const char* v = std::getenv("MAX_LEVERAGE")) limits.maxLeverage = std::stod(v);
+            engine.setPortfolioMode(std::stod(capital), TimeFrame::MINUTE, limits);
+        }
+
+        if (const char* interval = std::getenv("PROFILE_INTERVAL")) engine.setProfileInterval(std::stoull(interval));
+
+        if (const char* extended = std::getenv("EXTENDED_STATS")) engine.setExtendedStats(std::strcmp(extended, "0") != 0);
+
+        if (const char* placement = std::getenv("THREAD_PLACEMENT")) {
+            if (std::strcmp(placement, "pinned") == 0) engine.setThreadPlacement(ThreadPlacement::PINNED);
+            else if (std::strcmp(placement, "numa") == 0) engine.setThreadPlacement(ThreadPlacement::NUMA);
+            else if (std::strcmp(placement, "os") != 0) throw std::invalid_argument(std::string("Unknown THREAD_PLACEMENT '") + placement + "'");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
     // ========================================================================
     // STEP 3: Register trading strategies to test
     // ========================================================================
     
     // Strategy 1: Mean Reversion - buys on price drops, sells on price rises
     // Parameters: name, strategy instance, time frame, initial capital
-    engine.addStrategy("Mean_Reversion", 
+    // addTypedStrategy() runs the strategy in a loop compiled for its exact type (no virtual call per tick)
+    engine.addTypedStrategy("Mean_Reversion", 
                        std::make_unique<MeanReversionSimple>(), 
                        TimeFrame::MINUTE, 
                        initialCapital);
     
     // Strategy 2: Breakout - enters positions when price breaks through a window
     // The template parameter <20> is the window size for the breakout detection
-    engine.addStrategy("Breakout_Win20", 
+    engine.addTypedStrategy("Breakout_Win20", 
                        std::make_unique<BreakoutStrategy<20>>(), 
                        TimeFrame::MINUTE, 
                        initialCapital);
     
     // Strategy 3: Spread - profits from bid-ask spread (uses QuoteTick data)
-    engine.addStrategy("Spread", 
+    // The same on every run length: its stacked orders are the only state that grows with the
+    // number of ticks (see the memory note of main())
+    engine.addTypedStrategy("Spread", 
                        std::make_unique<SpreadStrategy>(), 
                        TimeFrame::MINUTE, 
                        initialCapital);
@@ -152,7 +515,19 @@ int main(int argc, char* argv[])
     
     // Run all strategies in parallel threads
     // Parameter: saveToCSV = true (generate CSV files with results)
-    engine.runAll(true);
+    try {
+        engine.runAll(true);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    // Hot-path latencies (instrumented builds only, also saved as <name>_profile.csv)
+    for (const ProfileReport& report : engine.getProfileReports()) {
+        std::cout << "Profile " << report.strategy << " " << probeName(report.probe)
+                  << ": p50 " << report.p50Ns << " ns, p99 " << report.p99Ns
+                  << " ns, max " << report.maxNs << " ns (" << report.samples << " samples)\n";
+    }
     
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,665 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "BacktestEngine.h"
+#include "BarAggregator.h"
+#include "BarPipeline.h"
+#include "BatchGBMGenerator.h"
+#include "BreakoutStrategy.h"
+#include "DatasetCache.h"
+#include "GBMJumpGenerator.h"
+#include "Indicators/ATR.h"
+#include "Indicators/EMA.h"
+#include "Indicators/RSI.h"
+#include "Indicators/RollingExtrema.h"
+#include "Indicators/RollingVariance.h"
+#include "Indicators/SMA.h"
+#include "Indicators/SharedIndicator.h"
+#include "Indicators/VWAP.h"
+#include "MeanReversionSimpleStrategy.h"
+#include "MeanReversionBlockStrategy.h"
+#include "MonteCarlo.h"
+#include "OrderManager.h"
+#include "QuoteGBMJumpGenerator.h"
+#include "ResultFile.h"
+#include "RunArena.h"
+#include "SpreadStrategy.h"
+#include "Statistiques.h"
+#include "StatsCollector.h"
+#include "StrategyContext.h"
+#include "TickCsv.h"
+#include "TickMerger.h"
+#include "WalkForward.h"
+
+/**
+ * @brief Microbenchmarks of the engine hot paths
+ *
+ * Market data comes from BatchGBMGenerator with a fixed seed, so every run
+ * measures the same prices. Throughput is reported as items/s (one item = one
+ * tick), and the end-to-end runs also report ticks_per_strategy (ticks/s going
+ * through each strategy).
+ *
+ * Usage:
+ *   ./backtest_bench                                # everything
+ *   ./backtest_bench --benchmark_filter=OrderManager
+ */
+
+namespace {
+
+constexpr uint64_t BENCH_SEED = 20240501;
+
+std::vector<Tick> benchTicks(size_t count) {
+	return BatchGBMGenerator(count, TimeFrame::MINUTE, BENCH_SEED).generateTicks();
+}
+
+std::vector<QuoteTick> benchQuotes(size_t count) {
+	return BatchGBMGenerator(count, TimeFrame::MINUTE, BENCH_SEED).generateQuotes();
+}
+
+/**
+ * @brief Fills the book with `depth` limit orders on each side, far from the market
+ *
+ * The orders never fill, so every tick pays for the crossing check against a
+ * book of the given depth.
+ */
+void restOrders(OrderManager& om, size_t depth) {
+	for (size_t i = 0; i < depth; i++) {
+		Order bid{ Order::Side::BUY, OrderType::LIMIT, 0, 1.0, 1.0 + 0.001 * i };
+		Order ask{ Order::Side::SELL, OrderType::LIMIT, 0, 1.0, 1e6 - 0.001 * i };
+		om.submit(bid);
+		om.submit(ask);
+	}
+}
+
+} // namespace
+
+// ============================================================================
+// OrderManager
+// ============================================================================
+
+/**
+ * @brief Trade tick matching with a resting book. Args: ticks, orders per side
+ */
+static void BM_OrderManagerHandleTick(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+	OrderManager om(100000);
+	restOrders(om, state.range(1));
+
+	for (auto _ : state) {
+		for (const Tick& tick : ticks) om.handleTick(tick);
+		benchmark::DoNotOptimize(om.getPendingCount());
+	}
+	state.SetItemsProcessed(state.iterations() * ticks.size());
+}
+BENCHMARK(BM_OrderManagerHandleTick)->ArgsProduct({ { 10'000, 100'000 }, { 0, 16, 1024 } });
+
+/**
+ * @brief Quote tick matching with a resting book. Args: ticks, orders per side
+ */
+static void BM_OrderManagerHandleQuote(benchmark::State& state) {
+	const std::vector<QuoteTick> quotes = benchQuotes(state.range(0));
+	OrderManager om(100000);
+	restOrders(om, state.range(1));
+
+	for (auto _ : state) {
+		for (const QuoteTick& quote : quotes) om.handleTick(quote);
+		benchmark::DoNotOptimize(om.getPendingCount());
+	}
+	state.SetItemsProcessed(state.iterations() * quotes.size());
+}
+BENCHMARK(BM_OrderManagerHandleQuote)->ArgsProduct({ { 10'000, 100'000 }, { 0, 16, 1024 } });
+
+/**
+ * @brief Submit + cancel of one limit order on top of a resting book. Args: orders per side
+ */
+static void BM_OrderManagerSubmitCancel(benchmark::State& state) {
+	OrderManager om(100000);
+	restOrders(om, state.range(0));
+
+	for (auto _ : state) {
+		Order order{ Order::Side::BUY, OrderType::LIMIT, 0, 1.0, 50.0 };
+		const OrderId id = om.submit(order);
+		benchmark::DoNotOptimize(om.cancel(id));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OrderManagerSubmitCancel)->Arg(0)->Arg(16)->Arg(1024)->Arg(65536);
+
+namespace {
+
+/**
+ * @brief Fills and final value of a SpreadStrategy run
+ */
+struct SpreadRun {
+	size_t fills;
+	double value;
+};
+
+/**
+ * @brief Runs a SpreadStrategy over the quotes in the engine's tick order (onTick, then matching)
+ */
+SpreadRun runSpread(const std::vector<QuoteTick>& quotes, bool requote) {
+	OrderManager om(100000);
+	om.setRecordFills(true);
+	SpreadStrategy strategy(1.0, 0.01, 0.005, requote);
+	strategy.setOrderManager(&om);
+	for (const QuoteTick& quote : quotes) {
+		strategy.onTick(quote);
+		om.handleTick(quote);
+	}
+	return SpreadRun{ om.getFills().size(), om.getPnL() };
+}
+
+} // namespace
+
+/**
+ * @brief SpreadStrategy quoting modes. Args: quotes, requote (0 = stack a new pair every tick, 1 = move one quote per side)
+ *
+ * Also checks requote mode: it must trade, and gain or lose like the default
+ * mode on the same quotes (the default mode's stacked orders run its
+ * position far past the limit of 5, so the amounts differ).
+ */
+static void BM_SpreadQuoting(benchmark::State& state) {
+	const std::vector<QuoteTick> quotes = benchQuotes(state.range(0));
+	const bool requote = state.range(1) != 0;
+
+	SpreadRun run{};
+	for (auto _ : state) {
+		run = runSpread(quotes, requote);
+		benchmark::DoNotOptimize(run.value);
+	}
+	if (requote) {
+		const SpreadRun stacked = runSpread(quotes, false);
+		if (run.fills == 0) state.SkipWithError("Requote mode never filled");
+		else if ((run.value < 100000) != (stacked.value < 100000)) state.SkipWithError("Requote mode doesn't track the default mode");
+	}
+	state.SetItemsProcessed(state.iterations() * quotes.size());
+	state.counters["fills"] = static_cast<double>(run.fills);
+	state.counters["return"] = run.value / 100000 - 1.0;
+}
+BENCHMARK(BM_SpreadQuoting)->ArgsProduct({ { 200'000 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Limit orders placed at the market and filled on later ticks.
+ * Args: ticks, fill model (0 = naive matcher, 1 = ExecutionModel with 1 tick of latency, queue positions, partial fills and fees)
+ */
+static void BM_OrderManagerFill(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+
+	for (auto _ : state) {
+		OrderManager om(100000);
+		if (state.range(1) != 0) om.setExecutionModel(ExecutionModel{ .latency = 1, .slippage = 0.0005, .feeRate = 0.0001 });
+		for (const Tick& tick : ticks) {
+			om.handleTick(tick);
+			Order order{ tick.timestamp % 2 ? Order::Side::BUY : Order::Side::SELL, OrderType::LIMIT, tick.timestamp, 1.0, tick.price };
+			om.submit(order);
+		}
+		benchmark::DoNotOptimize(om.getPosition());
+	}
+	state.SetItemsProcessed(state.iterations() * ticks.size());
+}
+BENCHMARK(BM_OrderManagerFill)->ArgsProduct({ { 10'000, 100'000 }, { 0, 1 } });
+
+// ============================================================================
+// StatsCollector
+// ============================================================================
+
+/**
+ * @brief Recording a PnL per tick. Args: ticks, store series (0/1)
+ */
+static void BM_StatsCollectorRecordPnL(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+
+	for (auto _ : state) {
+		StatsCollector stats(state.range(1) != 0);
+		for (const Tick& tick : ticks) stats.recordPnL(tick.price);
+		benchmark::DoNotOptimize(stats.getMaxDrawdown());
+	}
+	state.SetItemsProcessed(state.iterations() * ticks.size());
+}
+BENCHMARK(BM_StatsCollectorRecordPnL)->ArgsProduct({ { 10'000, 1'000'000 }, { 0, 1 } });
+
+/**
+ * @brief End-of-run statistics. Args: ticks, statistics (0 = default, 1 = default + series statistics)
+ *
+ * A PnL is recorded before each computeStats() so the shared drawdown curve
+ * and sorted returns are rebuilt every iteration, as at the end of a run.
+ */
+static void BM_StatsCollectorComputeStats(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+	StatsCollector stats;
+	registerUserStats(stats, TimeFrame::MINUTE);
+	if (state.range(1) != 0) registerSeriesStats(stats, TimeFrame::MINUTE);
+	for (const Tick& tick : ticks) stats.recordPnL(tick.price);
+
+	for (auto _ : state) {
+		stats.recordPnL(ticks.back().price);
+		benchmark::DoNotOptimize(stats.computeStats());
+	}
+	state.SetItemsProcessed(state.iterations() * ticks.size());
+}
+BENCHMARK(BM_StatsCollectorComputeStats)->ArgsProduct({ { 1'000'000 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Saving a PnL series to disk. Args: ticks, format (0 = CSV, 1 = binary, 2 = binary with 2000 chart points)
+ */
+static void BM_ExportResults(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+	StatsCollector stats;
+	for (const Tick& tick : ticks) stats.recordPnL(tick.price);
+	const char* path = "bench_results.tmp";
+
+	for (auto _ : state) {
+		if (state.range(1) == 0) stats.exportPnLToCSV(path);
+		else writeResultFile(path, stats, {}, state.range(1) == 2 ? 2000 : 0);
+	}
+	std::remove(path);
+	state.SetItemsProcessed(state.iterations() * ticks.size());
+}
+BENCHMARK(BM_ExportResults)->ArgsProduct({ { 1'000'000 }, { 0, 1, 2 } })->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// BarAggregator
+// ============================================================================
+
+/**
+ * @brief Aggregating ticks into bars. Args: ticks, ticks per bar
+ */
+static void BM_BarAggregatorUpdate(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+
+	for (auto _ : state) {
+		BarAggregator aggregator(state.range(1));  // Timestamps are tick indices
+		size_t bars = 0;
+		for (const Tick& tick : ticks) bars += aggregator.update(tick).has_value();
+		benchmark::DoNotOptimize(bars);
+	}
+	state.SetItemsProcessed(state.iterations() * ticks.size());
+}
+BENCHMARK(BM_BarAggregatorUpdate)->ArgsProduct({ { 10'000, 1'000'000 }, { 1, 60 } });
+
+/**
+ * @brief Shared bar pipeline with 1, 5 and 60 tick windows cascaded. Args: ticks
+ */
+static void BM_BarPipeline(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+	constexpr size_t block = 4096;
+
+	for (auto _ : state) {
+		BarPipeline pipeline;
+		pipeline.addWindow(1);
+		pipeline.addWindow(5);
+		pipeline.addWindow(60);
+		pipeline.build(block);
+
+		size_t bars = 0;
+		for (size_t begin = 0; begin < ticks.size(); begin += block) {
+			pipeline.process(std::span<const Tick>(ticks).subspan(begin, std::min(block, ticks.size() - begin)));
+			bars += pipeline.events(2).size();
+		}
+		benchmark::DoNotOptimize(bars);
+	}
+	state.SetItemsProcessed(state.iterations() * ticks.size());
+}
+BENCHMARK(BM_BarPipeline)->Arg(10'000)->Arg(1'000'000);
+
+// ============================================================================
+// Indicators
+// ============================================================================
+
+/**
+ * @brief Per-tick update of one indicator. Args: ticks, period
+ */
+template<typename IndicatorT>
+static void BM_Indicator(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+
+	for (auto _ : state) {
+		IndicatorT indicator(state.range(1));
+		for (const Tick& tick : ticks) indicator.update(tick);
+		benchmark::DoNotOptimize(indicator.value());
+	}
+	state.SetItemsProcessed(state.iterations() * ticks.size());
+}
+BENCHMARK(BM_Indicator<SMA>)->ArgsProduct({ { 1'000'000 }, { 20, 1000 } });
+BENCHMARK(BM_Indicator<EMA>)->ArgsProduct({ { 1'000'000 }, { 20, 1000 } });
+BENCHMARK(BM_Indicator<RollingVariance>)->ArgsProduct({ { 1'000'000 }, { 20, 1000 } });
+BENCHMARK(BM_Indicator<RSI>)->ArgsProduct({ { 1'000'000 }, { 14 } });
+BENCHMARK(BM_Indicator<ATR>)->ArgsProduct({ { 1'000'000 }, { 14 } });
+BENCHMARK(BM_Indicator<VWAP>)->ArgsProduct({ { 1'000'000 }, { 0, 1000 } });
+BENCHMARK(BM_Indicator<RollingHigh>)->ArgsProduct({ { 1'000'000 }, { 20, 1000 } });
+
+/**
+ * @brief One SMA read by several readers, one block at a time as the engine does. Args: ticks, readers
+ */
+static void BM_SharedIndicator(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+	constexpr size_t block = 4096;
+
+	for (auto _ : state) {
+		auto shared = SharedIndicator<SMA>::create(2 * block, 1000);
+		std::vector<SharedIndicator<SMA>::Reader> readers;
+		for (int64_t i = 0; i < state.range(1); i++) readers.push_back(SharedIndicator<SMA>::reader(shared));
+
+		for (size_t begin = 0; begin < ticks.size(); begin += block) {
+			const size_t end = std::min(ticks.size(), begin + block);
+			for (auto& reader : readers) {
+				for (size_t i = begin; i < end; i++) reader.update(ticks[i]);
+			}
+		}
+		benchmark::DoNotOptimize(readers.back().value());
+	}
+	state.SetItemsProcessed(state.iterations() * ticks.size() * state.range(1));
+}
+BENCHMARK(BM_SharedIndicator)->ArgsProduct({ { 1'000'000 }, { 1, 8 } });
+
+// ============================================================================
+// TickMerger
+// ============================================================================
+
+/**
+ * @brief k-way merge of per-symbol streams into one ordered stream. Args: symbols, ticks per symbol
+ */
+static void BM_TickMerger(benchmark::State& state) {
+	const size_t symbols = state.range(0);
+	std::vector<std::vector<Tick>> streams;
+	for (size_t s = 0; s < symbols; s++) {
+		streams.push_back(BatchGBMGenerator(state.range(1), TimeFrame::MINUTE, BENCH_SEED).generateTicks(s));
+	}
+	std::vector<Tick> out(4096);
+
+	for (auto _ : state) {
+		std::vector<SpanTickSource<Tick>> sources(streams.begin(), streams.end());
+		TickMerger<Tick> merger(256);
+		for (size_t s = 0; s < symbols; s++) merger.addSource(sources[s], static_cast<SymbolId>(s));
+
+		size_t merged = 0;
+		while (size_t count = merger.read(out)) merged += count;
+		benchmark::DoNotOptimize(merged);
+	}
+	state.SetItemsProcessed(state.iterations() * symbols * state.range(1));
+}
+BENCHMARK(BM_TickMerger)->Args({ 1, 1'000'000 })->Args({ 16, 100'000 })->Args({ 500, 10'000 });
+
+// ============================================================================
+// Generators
+// ============================================================================
+
+/**
+ * @brief Trade tick generation. Args: ticks
+ */
+static void BM_GBMJumpGenerator(benchmark::State& state) {
+	for (auto _ : state) {
+		std::vector<Tick> ticks = GBMJumpGenerator(state.range(0), TimeFrame::MINUTE).generateTicks();
+		benchmark::DoNotOptimize(ticks.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GBMJumpGenerator)->Arg(10'000)->Arg(1'000'000);
+
+/**
+ * @brief Quote tick generation. Args: ticks
+ */
+static void BM_QuoteGBMJumpGenerator(benchmark::State& state) {
+	for (auto _ : state) {
+		std::vector<QuoteTick> quotes = QuoteGBMJumpGenerator(state.range(0), TimeFrame::MINUTE).generateTicks();
+		benchmark::DoNotOptimize(quotes.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_QuoteGBMJumpGenerator)->Arg(10'000)->Arg(1'000'000);
+
+/**
+ * @brief Getting a quote dataset from DatasetCache. Args: ticks, level (0 = generated, 1 = disk, 2 = memory)
+ */
+static void BM_DatasetCache(benchmark::State& state) {
+	const DatasetKey key{ static_cast<size_t>(state.range(0)), TimeFrame::MINUTE, BENCH_SEED };
+	const std::string directory = "bench_dataset_cache.tmp";
+	DatasetCache cache(1, state.range(1) == 0 ? "" : directory);
+	cache.quotes(key);  // Warm the levels below the one measured
+
+	for (auto _ : state) {
+		if (state.range(1) != 2) cache.clear();
+		benchmark::DoNotOptimize(cache.quotes(key)->data());
+	}
+	std::filesystem::remove_all(directory);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DatasetCache)->ArgsProduct({ { 1'000'000 }, { 0, 1, 2 } })->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Loading recorded trades from CSV. Args: ticks, threads (0 = map the converted binary file instead)
+ */
+static void BM_ReadTradeCsv(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+	const char* csvPath = "bench_ticks.csv.tmp";
+	const char* tickPath = "bench_ticks.bin.tmp";
+	{
+		FILE* file = std::fopen(csvPath, "w");
+		std::fprintf(file, "timestamp,price,volume\n");
+		for (const Tick& tick : ticks) std::fprintf(file, "%llu,%.17g,%.17g\n", static_cast<unsigned long long>(tick.timestamp), tick.price, tick.volume);
+		std::fclose(file);
+	}
+	convertCsvToTickFile(csvPath, tickPath, TickRecordType::TRADE);
+
+	for (auto _ : state) {
+		if (state.range(1) == 0) {
+			MappedTickFile<Tick> file(tickPath);
+			double sum = 0.0;
+			for (const Tick& tick : file.ticks()) sum += tick.price;  // Touch the pages, as a run would
+			benchmark::DoNotOptimize(sum);
+		} else {
+			benchmark::DoNotOptimize(readTradeCsv(csvPath, { ',', static_cast<size_t>(state.range(1)) }).data());
+		}
+	}
+	std::remove(csvPath);
+	std::remove(tickPath);
+	state.SetItemsProcessed(state.iterations() * ticks.size());
+}
+BENCHMARK(BM_ReadTradeCsv)->ArgsProduct({ { 1'000'000 }, { 0, 1, 4 } })->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Multi-path price generation on all cores. Args: ticks per path, paths
+ */
+static void BM_BatchGBMPaths(benchmark::State& state) {
+	BatchGBMGenerator generator(state.range(0), TimeFrame::MINUTE, BENCH_SEED);
+
+	for (auto _ : state) {
+		std::vector<double> prices = generator.generatePaths(0, state.range(1));
+		benchmark::DoNotOptimize(prices.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK(BM_BatchGBMPaths)->ArgsProduct({ { 10'000 }, { 1, 64 } })->UseRealTime();
+
+// ============================================================================
+// End to end
+// ============================================================================
+
+/**
+ * @brief Full runAll() of one strategy type. Args: ticks, strategy instances
+ *
+ * Typed = true registers the strategies with addTypedStrategy() (compile-time
+ * dispatch), false with addStrategy() (virtual dispatch).
+ *
+ * Loading the data into the engine is excluded from the timing. Every
+ * instance processes all ticks, so ticks_per_strategy = ticks / run time.
+ */
+template<typename StrategyT, bool Typed>
+static void BM_RunAll(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+	const std::vector<QuoteTick> quotes = benchQuotes(state.range(0));
+	const size_t strategyCount = state.range(1);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		BacktestEngine engine;
+		engine.setStoreSeries(false);
+		engine.setTickData(std::vector<Tick>(ticks));
+		engine.setTickData(std::vector<QuoteTick>(quotes));
+		for (size_t i = 0; i < strategyCount; i++) {
+			if constexpr (Typed) {
+				engine.addTypedStrategy("bench_" + std::to_string(i), std::make_unique<StrategyT>(), TimeFrame::MINUTE, 100000);
+			} else {
+				engine.addStrategy("bench_" + std::to_string(i), std::make_unique<StrategyT>(), TimeFrame::MINUTE, 100000);
+			}
+		}
+		state.ResumeTiming();
+
+		engine.runAll(false);
+	}
+	state.SetItemsProcessed(state.iterations() * ticks.size() * strategyCount);
+	state.counters["ticks_per_strategy"] = benchmark::Counter(double(state.iterations() * ticks.size()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_RunAll<MeanReversionSimple, false>)->ArgsProduct({ { 100'000, 1'000'000 }, { 1, 8 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RunAll<MeanReversionSimple, true>)->ArgsProduct({ { 100'000, 1'000'000 }, { 1, 8 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RunAll<MeanReversionBlock, false>)->ArgsProduct({ { 100'000, 1'000'000 }, { 1, 8 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RunAll<MeanReversionBlock, true>)->ArgsProduct({ { 100'000, 1'000'000 }, { 1, 8 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RunAll<BreakoutStrategy<20>, false>)->ArgsProduct({ { 100'000, 1'000'000 }, { 1, 8 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RunAll<BreakoutStrategy<20>, true>)->ArgsProduct({ { 100'000, 1'000'000 }, { 1, 8 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RunAll<SpreadStrategy, false>)->ArgsProduct({ { 100'000, 1'000'000 }, { 1, 8 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RunAll<SpreadStrategy, true>)->ArgsProduct({ { 100'000, 1'000'000 }, { 1, 8 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief runAll() of a book of MeanReversionSimple strategies on one thread. Args: ticks, strategies, portfolio
+ *
+ * Portfolio = 0 runs the strategies independently (block by block), 1 as one
+ * book with shared capital and a position limit (tick by tick, every order
+ * checked and netted).
+ */
+static void BM_Portfolio(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+	const size_t strategyCount = state.range(1);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		BacktestEngine engine;
+		engine.setStoreSeries(false);
+		engine.setThreadCount(1);
+		engine.setTickData(std::vector<Tick>(ticks));
+		for (size_t i = 0; i < strategyCount; i++) {
+			engine.addTypedStrategy("bench_" + std::to_string(i), std::make_unique<MeanReversionSimple>(), TimeFrame::MINUTE, 100000);
+		}
+		if (state.range(2)) {
+			RiskLimits limits;
+			limits.maxPosition = 10.0 * strategyCount;
+			engine.setPortfolioMode(100000.0 * strategyCount, TimeFrame::MINUTE, limits);
+		}
+		state.ResumeTiming();
+
+		engine.runAll(false);
+	}
+	state.SetItemsProcessed(state.iterations() * ticks.size() * strategyCount);
+}
+BENCHMARK(BM_Portfolio)->ArgsProduct({ { 100'000 }, { 8, 128 }, { 0, 1 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief MeanReversionSimple without checkpoint support: walk-forward forks replay their training
+ */
+class ReplayedMeanReversion : public MeanReversionSimple {
+public:
+	bool saveState(StateWriter&) const override { return false; }
+};
+
+/**
+ * @brief Anchored walk-forward analysis. Args: ticks, checkpoints (0 = replay every training window), threads
+ *
+ * 8 folds: training from tick 0 to 20%, 30%, ... of the data, each followed
+ * by a test window of 10%.
+ */
+static void BM_WalkForward(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+	const std::vector<WalkForwardFold> folds = WalkForward::anchored(ticks.size(), ticks.size() / 5, ticks.size() / 10);
+	WalkForward walkForward{ TradeSeries(std::span<const Tick>(ticks)) };
+	walkForward.setThreadCount(state.range(2));
+
+	const StrategyBuilder checkpointed = [] { return std::make_unique<MeanReversionSimple>(); };
+	const StrategyBuilder replayed = [] { return std::make_unique<ReplayedMeanReversion>(); };
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(walkForward.run(folds, state.range(1) ? checkpointed : replayed, TimeFrame::MINUTE, 100000));
+	}
+}
+BENCHMARK(BM_WalkForward)->ArgsProduct({ { 1'000'000 }, { 0, 1 }, { 1, 4 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Back-to-back short runs, as in a large sweep. Args: ticks per run, arena (0 = global heap)
+ *
+ * Each run builds a StrategyContext, processes the ticks and computes its
+ * statistics; with the arena, its engine state comes from one RunArena that
+ * is reset between runs.
+ */
+static void BM_ShortRuns(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+	RunArena arena;
+
+	for (auto _ : state) {
+		{
+			StrategyContext context("bench", std::make_unique<MeanReversionSimple>(), TimeFrame::MINUTE, 100000,
+				state.range(1) ? arena.resource() : std::pmr::get_default_resource());
+			context.statistics.setStoreSeries(false);
+			context.setup();
+			context.strategy->onStart();
+			context.process(std::span<const Tick>(ticks));
+			benchmark::DoNotOptimize(context.finish());
+		}
+		arena.reset();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShortRuns)->ArgsProduct({ { 100, 1'000 }, { 0, 1 } });
+
+/**
+ * @brief Monte Carlo run of MeanReversionSimple, paths generated on the fly. Args: ticks per path, threads
+ */
+static void BM_MonteCarlo(benchmark::State& state) {
+	MonteCarlo monteCarlo(BatchGBMGenerator(state.range(0), TimeFrame::MINUTE, 42));
+	monteCarlo.setThreadCount(state.range(1));
+	const StrategyBuilder builder = [] { return std::make_unique<MeanReversionSimple>(); };
+
+	constexpr size_t PATHS = 256;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(monteCarlo.run(0, PATHS, builder, TimeFrame::MINUTE, 100000));
+	}
+	state.SetItemsProcessed(state.iterations() * PATHS);
+}
+BENCHMARK(BM_MonteCarlo)->ArgsProduct({ { 10'000 }, { 1, 4 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief runAll() of 8 MeanReversionSimple strategies with and without a progress observer. Args: ticks, period
+ *
+ * Period is the observer's drain period in milliseconds (0 = no observer),
+ * so the cost of publishing progress and fills, and of the drainer thread,
+ * shows up against the unobserved run.
+ */
+static void BM_Progress(benchmark::State& state) {
+	const std::vector<Tick> ticks = benchTicks(state.range(0));
+	size_t events = 0;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		BacktestEngine engine;
+		engine.setStoreSeries(false);
+		engine.setTickData(std::vector<Tick>(ticks));
+		for (size_t i = 0; i < 8; i++) {
+			engine.addTypedStrategy("bench_" + std::to_string(i), std::make_unique<MeanReversionSimple>(), TimeFrame::MINUTE, 100000);
+		}
+		if (state.range(1)) {
+			engine.setProgressObserver([&](const std::string&, std::span<const ProgressEvent> batch, uint64_t) {
+				events += batch.size();
+			}, std::chrono::milliseconds(state.range(1)));
+		}
+		state.ResumeTiming();
+
+		engine.runAll(false);
+	}
+	state.SetItemsProcessed(state.iterations() * ticks.size() * 8);
+	state.counters["events"] = benchmark::Counter(double(events), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_Progress)->ArgsProduct({ { 1'000'000 }, { 0, 1, 100 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
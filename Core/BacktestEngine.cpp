@@ -1,23 +1,26 @@
+#include <algorithm>
+#include <barrier>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
 #include "BacktestEngine.h"
+#include "ChunkBuffer.h"
 #include "Statistiques.h"
 
-/**
- * @brief Constructs a StrategyContext with all necessary components
- * 
- * Initializes all members and moves the strategy into this context.
- * The OrderManager is initialized with the starting cash amount.
- */
-StrategyContext::StrategyContext(const std::string& name,
-	std::unique_ptr<Strategy> strategy,
-	const TimeFrame& tf,
-	const double initialCash) : name(name), strategy(std::move(strategy)), tf(tf), orderManager(initialCash) {
-}
-
 /**
  * @brief Sets market data by copying (less efficient)
  */
 void BacktestEngine::setTickData(std::vector<Tick>& ticks) {
 	data = ticks;
+	tickFile.reset();
+	tradeColumns = {};
+	sharedTicks.reset();
+	tickStream.reset();
+	tickView = std::span<const Tick>(data);
 }
 
 /**
@@ -25,6 +28,11 @@ void BacktestEngine::setTickData(std::vector<Tick>& ticks) {
  */
 void BacktestEngine::setTickData(std::vector<Tick>&& ticks) {
 	data = std::move(ticks);
+	tickFile.reset();
+	tradeColumns = {};
+	sharedTicks.reset();
+	tickStream.reset();
+	tickView = std::span<const Tick>(data);
 }
 
 /**
@@ -32,6 +40,11 @@ void BacktestEngine::setTickData(std::vector<Tick>&& ticks) {
  */
 void BacktestEngine::setTickData(std::vector<QuoteTick>& quoteTicks) {
 	quoteData = quoteTicks;
+	quoteFile.reset();
+	quoteColumns = {};
+	sharedQuotes.reset();
+	quoteStream.reset();
+	quoteView = std::span<const QuoteTick>(quoteData);
 }
 
 /**
@@ -39,6 +52,176 @@ void BacktestEngine::setTickData(std::vector<QuoteTick>& quoteTicks) {
  */
 void BacktestEngine::setTickData(std::vector<QuoteTick>&& quoteTicks) {
 	quoteData = std::move(quoteTicks);
+	quoteFile.reset();
+	quoteColumns = {};
+	sharedQuotes.reset();
+	quoteStream.reset();
+	quoteView = std::span<const QuoteTick>(quoteData);
+}
+
+/**
+ * @brief Shares ownership of resident trade ticks and iterates them in place
+ */
+void BacktestEngine::setTickData(std::shared_ptr<const std::vector<Tick>> ticks) {
+	if (!ticks) throw std::invalid_argument("Shared tick data must not be null.");
+	data = {};
+	tickFile.reset();
+	tradeColumns = {};
+	tickStream.reset();
+	sharedTicks = std::move(ticks);
+	tickView = std::span<const Tick>(*sharedTicks);
+}
+
+/**
+ * @brief Shares ownership of resident quote ticks and iterates them in place
+ */
+void BacktestEngine::setTickData(std::shared_ptr<const std::vector<QuoteTick>> quoteTicks) {
+	if (!quoteTicks) throw std::invalid_argument("Shared quote data must not be null.");
+	quoteData = {};
+	quoteFile.reset();
+	quoteColumns = {};
+	quoteStream.reset();
+	sharedQuotes = std::move(quoteTicks);
+	quoteView = std::span<const QuoteTick>(*sharedQuotes);
+}
+
+namespace {
+
+/**
+ * @brief Reads a source to its end, one block-sized chunk at a time
+ */
+template<typename TickT>
+std::vector<TickT> readAll(TickSource<TickT>& source, size_t chunkSize) {
+	std::vector<TickT> ticks;
+	size_t count;
+	do {
+		const size_t used = ticks.size();
+		ticks.resize(used + chunkSize);
+		count = source.read(std::span<TickT>(ticks).subspan(used));
+		ticks.resize(used + count);
+	} while (count > 0);
+	return ticks;
+}
+
+} // namespace
+
+/**
+ * @brief Drains a trade tick source (e.g. a multi-symbol TickMerger) into memory
+ */
+void BacktestEngine::setTickData(TickSource<Tick>& source) {
+	setTickData(readAll(source, blockSize));
+}
+
+/**
+ * @brief Drains a quote tick source into memory
+ */
+void BacktestEngine::setTickData(TickSource<QuoteTick>& source) {
+	setTickData(readAll(source, blockSize));
+}
+
+/**
+ * @brief Maps a trade tick file and iterates it in place (zero-copy)
+ * 
+ * Any in-memory trade ticks are released, so memory use doesn't depend on the
+ * size of the file.
+ */
+void BacktestEngine::loadTickFile(const std::string& path) {
+	tickFile = std::make_unique<MappedTickFile<Tick>>(path);
+	data = {};
+	tradeColumns = {};
+	sharedTicks.reset();
+	tickStream.reset();
+	tickView = tickFile->ticks();
+}
+
+/**
+ * @brief Maps a quote tick file and iterates it in place (zero-copy)
+ */
+void BacktestEngine::loadQuoteFile(const std::string& path) {
+	quoteFile = std::make_unique<MappedTickFile<QuoteTick>>(path);
+	quoteData = {};
+	quoteColumns = {};
+	sharedQuotes.reset();
+	quoteStream.reset();
+	quoteView = quoteFile->ticks();
+}
+
+void BacktestEngine::loadTickCsv(const std::string& path, const CsvOptions& options) {
+	setTickData(readTradeCsv(path, options));
+}
+
+void BacktestEngine::loadQuoteCsv(const std::string& path, const CsvOptions& options) {
+	setTickData(readQuoteCsv(path, options));
+}
+
+/**
+ * @brief Sets trade data in column layout
+ */
+void BacktestEngine::setTickData(TradeColumns&& columns) {
+	tradeColumns = std::move(columns);
+	sharedTicks.reset();
+	data = {};
+	tickFile.reset();
+	tickStream.reset();
+	tickView = TradeSeries(tradeColumns);
+}
+
+/**
+ * @brief Sets quote data in column layout
+ */
+void BacktestEngine::setTickData(QuoteColumns&& columns) {
+	quoteColumns = std::move(columns);
+	sharedQuotes.reset();
+	quoteData = {};
+	quoteFile.reset();
+	quoteStream.reset();
+	quoteView = QuoteSeries(quoteColumns);
+}
+
+/**
+ * @brief Replaces the trade data with a stream read during runAll()
+ */
+void BacktestEngine::setTickStream(std::unique_ptr<TickSource<Tick>> source) {
+	tickStream = std::move(source);
+	data = {};
+	tickFile.reset();
+	tradeColumns = {};
+	sharedTicks.reset();
+	tickView = {};
+}
+
+/**
+ * @brief Replaces the quote data with a stream read during runAll()
+ */
+void BacktestEngine::setQuoteStream(std::unique_ptr<TickSource<QuoteTick>> source) {
+	quoteStream = std::move(source);
+	quoteData = {};
+	quoteFile.reset();
+	quoteColumns = {};
+	sharedQuotes.reset();
+	quoteView = {};
+}
+
+/**
+ * @brief Sets the number of ticks per streamed chunk
+ */
+void BacktestEngine::setStreamChunkSize(size_t ticks) {
+	if (ticks == 0) throw std::invalid_argument("Stream chunk size must be greater than 0.");
+	streamChunkSize = ticks;
+}
+
+/**
+ * @brief Returns the trade columns if trade data is columnar
+ */
+const TradeColumns* BacktestEngine::getTradeColumns() const {
+	return tickView.getColumns();
+}
+
+/**
+ * @brief Returns the quote columns if quote data is columnar
+ */
+const QuoteColumns* BacktestEngine::getQuoteColumns() const {
+	return quoteView.getColumns();
 }
 
 /**
@@ -48,99 +231,565 @@ void BacktestEngine::setTickData(std::vector<QuoteTick>&& quoteTicks) {
  * Each strategy gets its own OrderManager and StatsCollector.
  */
 void BacktestEngine::addStrategy(const std::string& name, std::unique_ptr<Strategy> strategy, const TimeFrame& tf, double initialCash) {
-	strategies.emplace_back(std::make_unique<StrategyContext>(name, std::move(strategy), tf, initialCash));
+	strategies.emplace_back(std::make_unique<StrategyContext>(name, std::move(strategy), tf, initialCash, memoryResource));
+}
+
+/**
+ * @brief Sets the number of worker threads used by runAll()
+ */
+void BacktestEngine::setThreadCount(size_t count) {
+	threadCount = count;
+}
+
+void BacktestEngine::setThreadPlacement(ThreadPlacement placement) {
+	threadPlacement = placement;
+}
+
+/**
+ * @brief Sets the number of ticks per block
+ */
+void BacktestEngine::setBlockSize(size_t ticks) {
+	if (ticks == 0) throw std::invalid_argument("Block size must be greater than 0.");
+	blockSize = ticks;
+}
+
+/**
+ * @brief Sets whether the full PnL series are stored
+ */
+void BacktestEngine::setStoreSeries(bool store) {
+	storeSeries = store;
+}
+
+void BacktestEngine::setExtendedStats(bool enabled) {
+	extendedStats = enabled;
+}
+
+/**
+ * @brief Enables or disables the shared bar pipeline
+ */
+void BacktestEngine::setSharedBars(bool shared) {
+	sharedBars = shared;
+}
+
+/**
+ * @brief Sets the function receiving each strategy's results
+ */
+void BacktestEngine::setResultCallback(ResultCallback callback) {
+	resultCallback = std::move(callback);
+}
+
+/**
+ * @brief Sets the observer of the progress channels and how often they are drained
+ */
+void BacktestEngine::setProgressObserver(ProgressObserver observer, std::chrono::milliseconds period) {
+	if (period.count() <= 0) throw std::invalid_argument("Progress period must be positive.");
+	progressObserver = std::move(observer);
+	progressPeriod = period;
+}
+
+/**
+ * @brief Asks the run to stop; the workers see it at the next block boundary
+ */
+void BacktestEngine::cancel() {
+	cancelRequested.store(true, std::memory_order_relaxed);
+}
+
+bool BacktestEngine::wasCancelled() const {
+	return lastRunCancelled;
+}
+
+/**
+ * @brief Sets the format of the saved per-tick results
+ */
+void BacktestEngine::setResultFormat(ResultFormat format) {
+	resultFormat = format;
+}
+
+/**
+ * @brief Sets the decimation limit of binary results
+ */
+void BacktestEngine::setResultMaxPoints(size_t points) {
+	if (points != 0 && points < 4) throw std::invalid_argument("Result max points must be 0 or at least 4.");
+	resultMaxPoints = points;
 }
 
 /**
- * @brief Runs all registered strategies in parallel threads
+ * @brief Sets the fill simulation applied to every strategy's OrderManager
+ */
+void BacktestEngine::setExecutionModel(const ExecutionModel& model) {
+	model.validate();
+	executionModel = model;
+}
+
+/**
+ * @brief Sets the sampling interval of the hot-path probes
+ */
+void BacktestEngine::setProfileInterval(size_t interval) {
+	if (interval == 0 || interval > UINT32_MAX) throw std::invalid_argument("Profile interval must be between 1 and 2^32 - 1.");
+	profileInterval = interval;
+}
+
+/**
+ * @brief Sets the memory resource used by addStrategy()
+ */
+void BacktestEngine::setMemoryResource(std::pmr::memory_resource* resource) {
+	if (!resource) throw std::invalid_argument("Memory resource must not be null.");
+	memoryResource = resource;
+}
+
+/**
+ * @brief Returns the latency reports of the last run
+ */
+const std::vector<ProfileReport>& BacktestEngine::getProfileReports() const {
+	return profileReports;
+}
+
+/**
+ * @brief Switches runAll() to a single book with shared capital
+ */
+void BacktestEngine::setPortfolioMode(double capital, const TimeFrame& tf, const RiskLimits& limits) {
+	if (!(capital > 0.0)) throw std::invalid_argument("Portfolio capital must be positive.");
+	limits.validate();
+	portfolioMode = true;
+	portfolioCapital = capital;
+	portfolioTf = tf;
+	riskLimits = limits;
+}
+
+/**
+ * @brief Switches runAll() back to independent strategies
+ */
+void BacktestEngine::clearPortfolioMode() {
+	portfolioMode = false;
+}
+
+/**
+ * @brief Returns the book of the last portfolio run
+ */
+const Portfolio* BacktestEngine::getPortfolio() const {
+	return portfolio.get();
+}
+
+/**
+ * @brief Runs all registered strategies on a fixed pool of worker threads
  * 
- * This is the main execution method. For each strategy:
+ * This is the main execution method.
  * 
  * 1. Setup phase:
- *    - Connect strategy to its OrderManager
+ *    - Connect each strategy to its OrderManager
  *    - Register statistics collection callbacks
+ *    - Check that the data the strategy needs is loaded
+ *    - Register the bar window of each BarStrategy in the shared bar pipeline
+ *    - Assign strategies round-robin to the workers
  * 
- * 2. Execution phase (in worker thread):
- *    - Call strategy->onStart() for initialization
- *    - Process all ticks:
- *      * Call strategy->onTick() to let strategy make decisions
- *      * Call orderManager->handleTick() to execute pending orders
- *      * Record PnL for statistics
- *    - Call strategy->onEnd() for cleanup
- *    - Compute final statistics
+ * 2. Execution phase (in each worker):
+ *    - Call strategy->onStart() for each of the worker's strategies
+ *    - For each block of ticks:
+ *      * Run every one of the worker's strategies over the block
+ *        (onTick, handleTick, recordPnL for each tick)
+ *      * Wait at the barrier until every worker has finished the block;
+ *        the last one to arrive moves the streams to their next chunk when
+ *        the block was the last of the chunk, then builds the bars of the next block
+ *    - Call strategy->onEnd() and compute final statistics
  * 
- * 3. Reporting phase:
- *    - Export to CSV if requested
+ * 3. Reporting phase (in each worker, strategy by strategy):
+ *    - Pass the results to the result callback, if any
+ *    - Export to CSV or binary result files if requested
  * 
- * All strategies run in parallel, so execution time is roughly the time
- * of the slowest strategy, not the sum of all strategies.
+ * Keeping the workers in lockstep means a block is fetched from memory once
+ * and then served from cache to every strategy on every core, instead of each
+ * strategy streaming the whole tick array on its own.
  */
 void BacktestEngine::runAll(const bool saveToCSV) {
-	// Setup and launch each strategy in its own thread
+	profileReports.clear();
+	lastRunCancelled = false;
+	if (strategies.empty()) return;
+#if BACKTEST_INSTRUMENT
+	const ProfileClockCalibration profileCalibration;  // Measures the clock rate over the run
+#endif
+
+	// A fresh book per portfolio run, valued once per tick
+	portfolio.reset();
+	if (portfolioMode) {
+		portfolio = std::make_unique<Portfolio>(portfolioCapital, riskLimits);
+		portfolioStatistics = StatsCollector(storeSeries);
+		registerUserStats(portfolioStatistics, portfolioTf);
+		if (extendedStats) registerSeriesStats(portfolioStatistics, portfolioTf);
+	}
+
+	// Setup each strategy before any worker starts
 	for (auto& context : strategies) {
-		// Give the strategy access to its OrderManager so it can submit orders
-		context->strategy->setOrderManager(&context->orderManager);
-		
-		// Register statistics collection callbacks (for custom metrics)
-		registerUserStats(context->statistics, context->tf);
-
-		// Launch worker thread for this strategy
-		// Capture context by value (ctx) to avoid lifetime issues
-		context->worker = std::thread([&, ctx = context.get()] {
-			// Initialize strategy
-			ctx->strategy->onStart();
-
-			// Check if this is a QuoteStrategy (needs bid/ask data)
-			if (auto* quoteStrat = dynamic_cast<QuoteStrategy*>(ctx->strategy.get())) {
-				// Process quote ticks for quote-based strategies
-				if (!quoteData.empty()) {
-					for (const QuoteTick& tick : quoteData) {
-						// Let strategy analyze the quote and make trading decisions
-						quoteStrat->onTick(tick);
-						
-						// Check if any pending LIMIT orders should execute
-						ctx->orderManager.handleTick(tick);
-						
-						// Record PnL using mid-price (average of bid and ask)
-						ctx->statistics.recordPnL(ctx->orderManager.getPnL((tick.bid + tick.ask) / 2.0));
-					}
+		// Connect OrderManager, register statistics, detect quote strategies
+		context->statistics.setStoreSeries(storeSeries);
+		context->orderManager.setRecordFills(saveToCSV && resultFormat == ResultFormat::BINARY);
+		if (executionModel) context->orderManager.setExecutionModel(*executionModel);
+		context->orderManager.setPortfolio(portfolio.get());
+		context->progress = progressObserver ? std::make_unique<ProgressChannel>() : nullptr;
+		context->orderManager.setProgressChannel(context->progress.get());
+		context->setup();
+		if (extendedStats) registerSeriesStats(context->statistics, context->tf);
+#if BACKTEST_INSTRUMENT
+		context->profile->reset();
+		context->profileInterval = static_cast<uint32_t>(profileInterval);
+		context->profileCountdown = context->profileInterval;
+#endif
+
+		// Check that the data this strategy consumes is loaded
+		if (context->quoteStrategy ? quoteView.empty() && !quoteStream : tickView.empty() && !tickStream) {
+			throw std::runtime_error("No data available for backtest.");
+		}
+
+		// Give access to the raw columns when the data is columnar
+		if (tickView.getColumns() || quoteView.getColumns()) {
+			context->strategy->setColumnarData(tickView.getColumns(), quoteView.getColumns());
+		}
+	}
+
+	// Bar strategies read their bars from one pipeline instead of aggregating on their own
+	BarPipeline barPipeline;
+	for (auto& context : strategies) {
+		context->barStrategy = sharedBars && !portfolio ? dynamic_cast<BarStrategy*>(context->strategy.get()) : nullptr;
+		if (context->barStrategy) context->barLevel = barPipeline.addWindow(context->barStrategy->getWindowSize());
+	}
+	barPipeline.build(blockSize);
+
+	// Never start more workers than there are strategies
+	size_t workerCount = threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+	workerCount = portfolio ? 1 : std::min(workerCount, strategies.size());
+
+	// Round-robin assignment of strategies to workers
+	std::vector<std::vector<StrategyContext*>> assignments(workerCount);
+	for (size_t i = 0; i < strategies.size(); i++) {
+		assignments[i % workerCount].push_back(strategies[i].get());
+	}
+
+	// Thread placement: a CPU per worker and, for NUMA, the rows of the data in the memory of each worker's node
+	std::vector<int> workerCpus;
+	std::vector<TradeSeries> workerTicks(workerCount, tickView);
+	std::vector<QuoteSeries> workerQuotes(workerCount, quoteView);
+	std::vector<std::vector<Tick>> tickReplicas;
+	std::vector<std::vector<QuoteTick>> quoteReplicas;
+	if (threadPlacement != ThreadPlacement::OS) {
+		const CpuTopology topology = CpuTopology::detect();
+		std::vector<size_t> workerNode;
+		workerCpus = topology.placeWorkers(workerCount, workerNode);
+
+		if (threadPlacement == ThreadPlacement::NUMA && topology.nodes.size() > 1) {
+			std::vector<bool> needed(topology.nodes.size(), false);
+			for (size_t node : workerNode) needed[node] = true;
+			if (!tickStream) tickReplicas = replicateOnNodes(tickView.getRows(), topology, needed);
+			if (!quoteStream) quoteReplicas = replicateOnNodes(quoteView.getRows(), topology, needed);
+			for (size_t w = 0; w < workerCount; w++) {
+				if (!tickReplicas.empty() && !tickReplicas[workerNode[w]].empty()) workerTicks[w] = TradeSeries(std::span<const Tick>(tickReplicas[workerNode[w]]));
+				if (!quoteReplicas.empty() && !quoteReplicas[workerNode[w]].empty()) workerQuotes[w] = QuoteSeries(std::span<const QuoteTick>(quoteReplicas[workerNode[w]]));
+			}
+		}
+	}
+
+	// Streams are read in whole blocks, two chunks in memory per stream (the first one is loaded here)
+	const size_t chunkSize = (streamChunkSize + blockSize - 1) / blockSize * blockSize;
+	std::unique_ptr<ChunkBuffer<Tick>> tickChunks;
+	std::unique_ptr<ChunkBuffer<QuoteTick>> quoteChunks;
+	if (tickStream) tickChunks = std::make_unique<ChunkBuffer<Tick>>(*tickStream, chunkSize);
+	if (quoteStream) quoteChunks = std::make_unique<ChunkBuffer<QuoteTick>>(*quoteStream, chunkSize);
+
+	// Trade and quote data may have different lengths - blocks cover the longer one.
+	// A stream's length is only known once it is exhausted: its end is that of the chunk in memory
+	auto hasBlock = [&](size_t begin) {
+		return begin < (tickChunks ? tickChunks->end() : tickView.size()) ||
+			begin < (quoteChunks ? quoteChunks->end() : quoteView.size());
+	};
+	std::vector<Tick> barScratch;
+	barScratch.reserve(blockSize);  // No allocation inside the noexcept completion
+	auto barTicks = [&](size_t begin) {
+		return tickChunks ? tickChunks->block(begin, blockSize) : tickView.block(begin, blockSize, barScratch);
+	};
+
+	// Bars of block 0 are built up front, the bars of each next block by the barrier completion
+	// (runs on one thread once every worker is done with the current block, so chunks can be
+	// swapped and events replaced). A stream error stops the run and is rethrown at the end;
+	// a cancellation stops it the same way, between two blocks.
+	size_t nextBegin = 0;
+	std::exception_ptr streamError;
+	if (cancelRequested.load(std::memory_order_relaxed)) {
+		nextBegin = SIZE_MAX;
+		lastRunCancelled = true;
+	}
+	if (!barPipeline.empty() && !lastRunCancelled) barPipeline.process(barTicks(0));
+
+	auto nextBlock = [&]() noexcept {
+		if (cancelRequested.load(std::memory_order_relaxed) && hasBlock(nextBegin + blockSize)) {
+			nextBegin = SIZE_MAX;
+			lastRunCancelled = true;
+			return;
+		}
+		nextBegin += blockSize;
+		try {
+			if (tickChunks && nextBegin == tickChunks->end()) tickChunks->advance();
+			if (quoteChunks && nextBegin == quoteChunks->end()) quoteChunks->advance();
+		} catch (...) {
+			streamError = std::current_exception();
+			nextBegin = SIZE_MAX;  // No worker starts another block
+			return;
+		}
+		if (!barPipeline.empty() && hasBlock(nextBegin)) barPipeline.process(barTicks(nextBegin));
+	};
+	std::barrier blockBarrier(static_cast<std::ptrdiff_t>(workerCount), nextBlock);
+
+	// First reporting failure of any worker (callback or export), rethrown once all workers are done
+	std::mutex reportMutex;
+	std::exception_ptr reportError;
+
+	// Portfolio mode: trades and quotes merged by timestamp (ties go to the trade, as in TickMerger),
+	// tick by tick, every strategy reacting to a timestamp before the book is valued.
+	// A block holds as many trades as quotes, not the same stretch of time: the ticks a stream
+	// has past the other one's last timestamp wait in pending for the other's next block
+	std::vector<Tick> pendingTicks;
+	std::vector<QuoteTick> pendingQuotes;
+	if (portfolio) {
+		pendingTicks.reserve(2 * blockSize);
+		pendingQuotes.reserve(2 * blockSize);
+	}
+	auto portfolioBlock = [&](const std::vector<StrategyContext*>& contexts, std::span<const Tick> ticks, std::span<const QuoteTick> quotes) {
+		// A short block is the end of its stream (chunks hold whole blocks)
+		const bool ticksEnded = ticks.size() < blockSize;
+		const bool quotesEnded = quotes.size() < blockSize;
+		pendingTicks.insert(pendingTicks.end(), ticks.begin(), ticks.end());
+		pendingQuotes.insert(pendingQuotes.end(), quotes.begin(), quotes.end());
+
+		// Every tick of a timestamp has arrived once each stream is past it (or has ended)
+		const uint64_t tickHorizon = pendingTicks.empty() ? 0 : pendingTicks.back().timestamp;
+		const uint64_t quoteHorizon = pendingQuotes.empty() ? 0 : pendingQuotes.back().timestamp;
+		auto complete = [&](uint64_t timestamp) {
+			return (ticksEnded || timestamp < tickHorizon) && (quotesEnded || timestamp < quoteHorizon);
+		};
+
+		size_t t = 0, q = 0;
+		while (t < pendingTicks.size() || q < pendingQuotes.size()) {
+			const uint64_t now = std::min(t < pendingTicks.size() ? pendingTicks[t].timestamp : UINT64_MAX,
+				q < pendingQuotes.size() ? pendingQuotes[q].timestamp : UINT64_MAX);
+			if (!complete(now)) break;
+
+			size_t tickEnd = t, quoteEnd = q;
+			while (tickEnd < pendingTicks.size() && pendingTicks[tickEnd].timestamp == now) tickEnd++;
+			while (quoteEnd < pendingQuotes.size() && pendingQuotes[quoteEnd].timestamp == now) quoteEnd++;
+
+			// Marks first, so the risk checks of this timestamp's orders see its prices
+			for (size_t i = t; i < tickEnd; i++) portfolio->mark(pendingTicks[i].symbol, pendingTicks[i].price);
+			for (size_t i = q; i < quoteEnd; i++) portfolio->mark(pendingQuotes[i].symbol, (pendingQuotes[i].bid + pendingQuotes[i].ask) / 2.0);
+
+			const std::span<const Tick> allTicks(pendingTicks);
+			const std::span<const QuoteTick> allQuotes(pendingQuotes);
+			for (; t < tickEnd; t++) {
+				for (StrategyContext* ctx : contexts) {
+					if (!ctx->quoteStrategy) ctx->process(allTicks.subspan(t, 1));
 				}
 			}
-			// Regular strategy (uses trade ticks)
-			else if (!data.empty()) {
-				for (const Tick& tick : data) {
-					// Let strategy analyze the tick and make trading decisions
-					ctx->strategy->onTick(tick);
-					
-					// Check if any pending LIMIT orders should execute
-					ctx->orderManager.handleTick(tick);
-					
-					// Record PnL using current tick price
-					ctx->statistics.recordPnL(ctx->orderManager.getPnL(tick.price));
+			for (; q < quoteEnd; q++) {
+				for (StrategyContext* ctx : contexts) {
+					if (ctx->quoteStrategy) ctx->process(allQuotes.subspan(q, 1));
 				}
-			} else {
-				throw std::runtime_error("No data available for backtest.");
 			}
+			portfolioStatistics.recordPnL(portfolio->getValue());
+		}
+		pendingTicks.erase(pendingTicks.begin(), pendingTicks.begin() + t);
+		pendingQuotes.erase(pendingQuotes.begin(), pendingQuotes.begin() + q);
+	};
 
-			// Finalize strategy
-			ctx->strategy->onEnd();
-			
-			// Compute final statistics (Sharpe ratio, max drawdown, etc.)
-			auto stats = ctx->statistics.computeStats();
+	auto worker = [&](size_t self) {
+		const std::vector<StrategyContext*>& contexts = assignments[self];
+		const TradeSeries& localTicks = workerTicks[self];    // tickView, or its copy on the worker's node
+		const QuoteSeries& localQuotes = workerQuotes[self];
+		if (!workerCpus.empty()) pinCurrentThread(workerCpus[self]);
 
-			// Export results to CSV files if requested
-			if (saveToCSV) {
-				ctx->statistics.exportPnLToCSV(ctx->name + "_pnl.csv");
-				ctx->statistics.exportStatsToCSV(ctx->name + "_statistics.csv", stats);
+		// Row buffers for columnar data - one block each, reused for every block
+		std::vector<Tick> tickScratch;
+		std::vector<QuoteTick> quoteScratch;
+
+		// Initialize strategies
+		for (StrategyContext* ctx : contexts) ctx->strategy->onStart();
+
+		// nextBegin and the chunks only change in the barrier completion, which every worker waits for
+		for (size_t begin = 0; nextBegin != SIZE_MAX && hasBlock(begin); begin += blockSize) {
+			// Fetch this block once for all of the worker's strategies (gathered only if columnar)
+			std::span<const Tick> ticks = tickChunks ? tickChunks->block(begin, blockSize) : localTicks.block(begin, blockSize, tickScratch);
+			std::span<const QuoteTick> quotes = quoteChunks ? quoteChunks->block(begin, blockSize) : localQuotes.block(begin, blockSize, quoteScratch);
+
+			if (portfolio) {
+				portfolioBlock(contexts, ticks, quotes);
+			} else for (StrategyContext* ctx : contexts) {
+				if (ctx->quoteStrategy) {
+					// Process quote ticks for quote-based strategies
+					if (!quotes.empty()) ctx->process(quotes);
+				}
+				// Bar strategy fed by the shared pipeline
+				else if (ctx->barStrategy) {
+					if (!ticks.empty()) ctx->process(ticks, barPipeline.events(ctx->barLevel));
+				}
+				// Regular strategy (uses trade ticks)
+				else if (!ticks.empty()) {
+					ctx->process(ticks);
+				}
+			}
+			for (StrategyContext* ctx : contexts) ctx->publishProgress();
+
+			// Wait for the other workers so everyone moves to the next block together
+			blockBarrier.arrive_and_wait();
+		}
+		// Streams ending on a block boundary leave the last ticks pending (unless the run was stopped)
+		if (portfolio && nextBegin != SIZE_MAX) portfolioBlock(contexts, {}, {});
+
+		for (StrategyContext* ctx : contexts) {
+			// Finalize strategy and compute final statistics (Sharpe ratio, max drawdown, etc.)
+			auto stats = ctx->finish();
+			if (portfolio) stats["Rejected_Orders"] = static_cast<double>(ctx->orderManager.getRejectedCount());
+
+			try {
+				// Hand the results to the caller as soon as this strategy is done
+				if (resultCallback) resultCallback(ctx->name, ctx->statistics, stats);
+
+				// Export results if requested
+				if (saveToCSV) {
+					if (resultFormat == ResultFormat::BINARY) {
+						writeResultFile(ctx->name + "_results.bin", ctx->statistics, ctx->orderManager.getFills(), resultMaxPoints);
+					} else {
+						ctx->statistics.exportPnLToCSV(ctx->name + "_pnl.csv");
+					}
+					ctx->statistics.exportStatsToCSV(ctx->name + "_statistics.csv", stats);
+				}
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(reportMutex);
+				if (!reportError) reportError = std::current_exception();
+			}
+		}
+	};
+
+	// Progress observer: drains every channel on its own thread while the workers run,
+	// then a last time once they are done
+	std::mutex drainMutex;
+	std::condition_variable drainWake;
+	bool workersDone = false;
+	std::exception_ptr observerError;
+	std::vector<ProgressEvent> drained;
+	auto drainAll = [&]() {
+		for (auto& context : strategies) {
+			drained.clear();
+			context->progress->drain(drained);
+			if (!drained.empty()) progressObserver(context->name, drained, context->progress->getDropped());
+		}
+	};
+	std::thread drainer;
+	if (progressObserver) {
+		drainer = std::thread([&] {
+			std::unique_lock<std::mutex> lock(drainMutex);
+			while (!drainWake.wait_for(lock, progressPeriod, [&] { return workersDone; })) {
+				lock.unlock();
+				try {
+					drainAll();
+				} catch (...) {
+					observerError = std::current_exception();
+					return;
+				}
+				lock.lock();
 			}
 		});
 	}
 
-	// Wait for all strategy threads to complete
+	// Launch the extra workers, run the first one on the calling thread
+	std::vector<std::thread> workers;
+	workers.reserve(workerCount - 1);
+	for (size_t w = 1; w < workerCount; w++) {
+		workers.emplace_back(worker, w);
+	}
+	{
+		const AffinityGuard callerAffinity;  // worker 0 may pin the calling thread
+		worker(0);
+	}
+
+	// Wait for all worker threads to complete
 	// This ensures we don't exit before all strategies finish
+	for (auto& thread : workers) {
+		thread.join();
+	}
+
+	if (drainer.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(drainMutex);
+			workersDone = true;
+		}
+		drainWake.notify_one();
+		drainer.join();
+		if (!observerError) {
+			try {
+				drainAll();
+			} catch (...) {
+				observerError = std::current_exception();
+			}
+		}
+	}
+	cancelRequested.store(false, std::memory_order_relaxed);  // This run was the one asked to stop
+
+	// Results of the book as a whole, after those of its strategies
+	if (portfolio && !streamError) {
+		try {
+			auto stats = portfolioStatistics.computeStats();
+			stats["Rejected_Orders"] = static_cast<double>(portfolio->getRejectedCount());
+			if (resultCallback) resultCallback("Portfolio", portfolioStatistics, stats);
+			if (saveToCSV) {
+				if (resultFormat == ResultFormat::BINARY) {
+					writeResultFile("Portfolio_results.bin", portfolioStatistics, {}, resultMaxPoints);
+				} else {
+					portfolioStatistics.exportPnLToCSV("Portfolio_pnl.csv");
+				}
+				portfolioStatistics.exportStatsToCSV("Portfolio_statistics.csv", stats);
+			}
+		} catch (...) {
+			if (!reportError) reportError = std::current_exception();
+		}
+	}
+
+#if BACKTEST_INSTRUMENT
+	// Convert the histograms with the clock rate measured over the whole run
+	const double nanosPerCount = profileCalibration.nanosPerCount();
 	for (auto& context : strategies) {
-		if (context->worker.joinable()) {
-			context->worker.join();
+		std::vector<ProfileReport> reports = summarizeProfile(context->name, *context->profile, nanosPerCount);
+		if (saveToCSV) {
+			try {
+				exportProfileToCSV(context->name + "_profile.csv", reports);
+			} catch (...) {
+				if (!reportError) reportError = std::current_exception();
+			}
 		}
+		profileReports.insert(profileReports.end(), reports.begin(), reports.end());
 	}
+#endif
+
+	// Streams are single-use
+	tickStream.reset();
+	quoteStream.reset();
+	if (streamError) std::rethrow_exception(streamError);
+	if (reportError) std::rethrow_exception(reportError);
+	if (observerError) std::rethrow_exception(observerError);
+}
+
+/**
+ * @brief Runs a parameter sweep over the engine's data
+ * 
+ * The sweep only holds views of the loaded ticks (in memory or mapped), so no tick is copied.
+ */
+std::vector<SweepResult> BacktestEngine::runSweep(const ParameterGrid& grid, const StrategyFactory& factory, const TimeFrame& tf, double initialCash) const {
+	if (tickStream || quoteStream) throw std::logic_error("Parameter sweeps need the data in memory or mapped, not streamed.");
+	ParameterSweep sweep(tickView, quoteView);
+	sweep.setThreadCount(threadCount);
+	return sweep.run(grid, factory, tf, initialCash);
+}
+
+/**
+ * @brief Runs a walk-forward analysis over the engine's data (views only, as for sweeps)
+ */
+std::vector<WalkForwardResult> BacktestEngine::runWalkForward(std::span<const WalkForwardFold> folds, const StrategyBuilder& builder, const TimeFrame& tf, double initialCash) const {
+	if (tickStream || quoteStream) throw std::logic_error("Walk-forward analyses need the data in memory or mapped, not streamed.");
+	WalkForward walkForward(tickView, quoteView);
+	walkForward.setThreadCount(threadCount);
+	return walkForward.run(folds, builder, tf, initialCash);
 }
@@ -2,63 +2,103 @@
 
 #include <vector>
 #include <functional>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
 #include <string>
-#include <thread>
+#include <typeinfo>
 
-#include "Strategy.h"
-#include "QuoteStrategy.h"
-#include "TimeFrame.h"
-#include "OrderManager.h"
-#include "StatsCollector.h"
+#include "StrategyContext.h"
+#include "Portfolio.h"
+#include "ParameterSweep.h"
+#include "WalkForward.h"
+#include "ResultFile.h"
+#include "TickCsv.h"
+#include "TickFile.h"
+#include "TickSeries.h"
+#include "TickSource.h"
+#include "ThreadPlacement.h"
 
 /**
- * @brief Container for all components needed to run a single strategy
+ * @brief Receives the results of one strategy at the end of runAll()
  * 
- * Each strategy runs in its own context with:
- * - name: Identifier for this strategy instance
- * - strategy: The actual strategy implementation
- * - tf: Time frame this strategy operates on
- * - orderManager: Handles order execution and position tracking for this strategy
- * - statistics: Collects performance metrics during backtesting
- * - worker: Thread handle for parallel execution
+ * Arguments: strategy name, its StatsCollector (PnL series if stored), its computed statistics.
  */
-struct StrategyContext {
-	std::string name;                    // Strategy identifier (e.g., "Mean_Reversion")
-	std::unique_ptr<Strategy> strategy;  // The strategy implementation
-	TimeFrame tf;                        // Time frame for this strategy
-	OrderManager orderManager;            // Manages orders and positions for this strategy
-	StatsCollector statistics;            // Collects performance statistics
-	std::thread worker;                  // Thread handle for parallel execution
+using ResultCallback = std::function<void(const std::string&, const StatsCollector&, const StatsMap&)>;
 
-	/**
-	 * @brief Constructs a StrategyContext with all necessary components
-	 * 
-	 * @param name Strategy name/identifier
-	 * @param strategy The strategy instance (moved into this context)
-	 * @param tf Time frame for this strategy
-	 * @param initialCash Starting capital for this strategy
-	 */
-	StrategyContext(const std::string& name, std::unique_ptr<Strategy> strategy, const TimeFrame& tf, const double initialCash);
-};
+/**
+ * @brief Receives the live events of one strategy while runAll() is in progress
+ * 
+ * Arguments: strategy name, the events published since the previous call
+ * (oldest first, valid during the call only), and the number of events the
+ * strategy's channel has dropped so far because it was full.
+ */
+using ProgressObserver = std::function<void(const std::string&, std::span<const ProgressEvent>, uint64_t)>;
 
 /**
  * @brief Core backtesting engine that orchestrates strategy execution
  * 
  * The BacktestEngine is the main coordinator that:
- * 1. Stores market data (ticks) to backtest on
+ * 1. Stores market data (ticks) to backtest on, in memory (rows or columns), memory-mapped from a tick file,
+ *    or streamed chunk by chunk from a TickSource
  * 2. Registers multiple strategies to test
- * 3. Runs all strategies in parallel threads on the same data
+ * 3. Runs all strategies on a fixed-size pool of worker threads over the same data
  * 4. Collects and reports performance statistics
  * 
  * Each strategy runs independently with its own OrderManager and StatsCollector,
  * so strategies don't interfere with each other. This allows easy comparison
  * of different strategies on the same historical data.
+ * 
+ * Execution model:
+ * - Strategies are spread across a fixed number of workers (not one thread per strategy)
+ * - The tick stream is cut into cache-sized blocks. Each worker runs a block
+ *   through all of its strategies while the block is still hot in L1/L2
+ * - Workers move from block to block in lockstep (std::barrier), so all cores
+ *   read the same region of the shared tick array at the same time and it is
+ *   only streamed from memory once
  */
 class BacktestEngine {
 private:
-	std::vector<Tick> data;                              // Regular trade ticks for standard strategies
-	std::vector<QuoteTick> quoteData;                     // Quote ticks (bid/ask) for quote-based strategies
+	std::vector<Tick> data;                              // Regular trade ticks for standard strategies (owned copy)
+	std::vector<QuoteTick> quoteData;                     // Quote ticks (bid/ask) for quote-based strategies (owned copy)
+	std::unique_ptr<MappedTickFile<Tick>> tickFile;       // Mapped trade tick file (if loaded from disk)
+	std::unique_ptr<MappedTickFile<QuoteTick>> quoteFile; // Mapped quote tick file (if loaded from disk)
+	std::shared_ptr<const std::vector<Tick>> sharedTicks;        // Trade ticks shared with other owners (if set as shared)
+	std::shared_ptr<const std::vector<QuoteTick>> sharedQuotes;  // Quote ticks shared with other owners (if set as shared)
+	TradeColumns tradeColumns;                            // Trade ticks in column layout (if set as columns)
+	QuoteColumns quoteColumns;                            // Quote ticks in column layout (if set as columns)
+	TradeSeries tickView;                                 // Trade ticks the run iterates (data, tickFile or tradeColumns)
+	QuoteSeries quoteView;                                // Quote ticks the run iterates (quoteData, quoteFile or quoteColumns)
+	std::unique_ptr<TickSource<Tick>> tickStream;         // Trade ticks pulled chunk by chunk by runAll() (if streaming)
+	std::unique_ptr<TickSource<QuoteTick>> quoteStream;   // Quote ticks pulled chunk by chunk by runAll() (if streaming)
+	size_t streamChunkSize = 65536;                       // Ticks per streamed chunk (rounded up to whole blocks)
 	std::vector<std::unique_ptr<StrategyContext>> strategies;  // All registered strategies
+	std::pmr::memory_resource* memoryResource = std::pmr::get_default_resource();  // Engine state of strategies added from now on
+	size_t threadCount = 0;                               // Number of workers (0 = one per hardware thread)
+	ThreadPlacement threadPlacement = ThreadPlacement::OS;  // CPUs of the workers, node-local copies of the data
+	size_t blockSize = 4096;                              // Ticks per block (4096 trade ticks = 128 KB)
+	bool storeSeries = true;                              // Keep full PnL/returns series in each StatsCollector
+	bool extendedStats = false;                           // Also compute the statistics of registerSeriesStats()
+	bool sharedBars = true;                               // Build bars once per window for all BarStrategy instances
+	ResultFormat resultFormat = ResultFormat::CSV;        // Format of the per-tick results saved by runAll()
+	size_t resultMaxPoints = 0;                           // Chart rows of binary results (0 = no chart columns)
+	ResultCallback resultCallback;                        // Called with each strategy's results (if set)
+	ProgressObserver progressObserver;                    // Drains the strategies' progress channels (if set)
+	std::chrono::milliseconds progressPeriod{ 100 };      // Time between two drains
+	std::atomic<bool> cancelRequested{ false };           // Set by cancel(), consumed by the run it stops
+	bool lastRunCancelled = false;                        // The last runAll() stopped before the end of the data
+	std::optional<ExecutionModel> executionModel;         // Fill simulation of every strategy (naive matcher if unset)
+	size_t profileInterval = 16;                          // Ticks per timed tick (instrumented builds)
+	std::vector<ProfileReport> profileReports;            // Latencies of the last run (instrumented builds)
+	bool portfolioMode = false;                           // Run the strategies as one book (see setPortfolioMode())
+	double portfolioCapital = 0.0;                        // Shared starting cash (portfolio mode)
+	TimeFrame portfolioTf = TimeFrame::MINUTE;            // Time frame of the portfolio statistics
+	RiskLimits riskLimits;                                // Pre-trade limits of the book
+	std::unique_ptr<Portfolio> portfolio;                 // Book of the current or last run (portfolio mode)
+	StatsCollector portfolioStatistics;                   // PnL of the book, one point per tick
 	
 public:
 	/**
@@ -91,6 +131,159 @@ public:
 	 */
 	void setTickData(std::vector<QuoteTick>&& quoteTicks);
 
+	/**
+	 * @brief Backtests on trade ticks owned jointly with other engines
+	 * 
+	 * Nothing is copied: the engine keeps a reference to the vector and
+	 * iterates it in place, so one resident dataset can serve many engines
+	 * at once (e.g. concurrent jobs of the backtest server). The ticks must
+	 * not be modified while any engine uses them.
+	 * 
+	 * @param ticks Trade ticks (must not be null)
+	 * @throws std::invalid_argument If ticks is null
+	 */
+	void setTickData(std::shared_ptr<const std::vector<Tick>> ticks);
+
+	/**
+	 * @brief Backtests on quote ticks owned jointly with other engines
+	 * 
+	 * @param quoteTicks Quote ticks (must not be null)
+	 * @throws std::invalid_argument If quoteTicks is null
+	 */
+	void setTickData(std::shared_ptr<const std::vector<QuoteTick>> quoteTicks);
+
+	/**
+	 * @brief Sets the market data (regular ticks) in column layout
+	 * 
+	 * Per-tick strategies still receive Tick objects: each worker gathers one
+	 * block at a time into a small row buffer. Strategies can also read the
+	 * columns directly (see Strategy::setColumnarData()), as can any code
+	 * holding getTradeColumns().
+	 * 
+	 * @param columns Trade tick columns (will be moved)
+	 */
+	void setTickData(TradeColumns&& columns);
+
+	/**
+	 * @brief Sets the quote data (bid/ask ticks) in column layout
+	 * 
+	 * @param columns Quote tick columns (will be moved)
+	 */
+	void setTickData(QuoteColumns&& columns);
+
+	/**
+	 * @brief Reads a tick source to its end and uses its ticks as market data
+	 * 
+	 * Typically a TickMerger combining one source per symbol into a single
+	 * timestamp-ordered stream whose ticks carry their SymbolId. Every strategy
+	 * then sees the ticks of all symbols, and its OrderManager keeps a position
+	 * per symbol. Bar aggregation (BarStrategy, shared bars) still treats the
+	 * stream as a single instrument.
+	 * 
+	 * @param source Trade tick source (read until exhausted)
+	 */
+	void setTickData(TickSource<Tick>& source);
+
+	/**
+	 * @brief Reads a quote tick source to its end and uses its quotes as quote data
+	 * 
+	 * @param source Quote tick source (read until exhausted)
+	 */
+	void setTickData(TickSource<QuoteTick>& source);
+
+	/**
+	 * @brief Streams trade ticks from a source instead of holding them in memory
+	 * 
+	 * runAll() pulls the ticks in fixed-size chunks, double-buffered: while the
+	 * strategies work on one chunk, the next one is read from the source on a
+	 * background thread. Memory then depends on the chunk size, not on the
+	 * length of the stream (combine with setStoreSeries(false) so the
+	 * statistics don't keep a value per tick either).
+	 * 
+	 * The source is consumed by the next runAll(). Replaces any trade ticks set
+	 * with setTickData() or loadTickFile(). Parameter sweeps need the data in
+	 * memory or mapped, so they don't work on streams.
+	 * 
+	 * @param source Trade tick source, in time order (e.g. BatchGBMGenerator::streamTicks())
+	 */
+	void setTickStream(std::unique_ptr<TickSource<Tick>> source);
+
+	/**
+	 * @brief Streams quote ticks from a source instead of holding them in memory
+	 * 
+	 * Same as setTickStream() for quote ticks.
+	 * 
+	 * @param source Quote tick source, in time order
+	 */
+	void setQuoteStream(std::unique_ptr<TickSource<QuoteTick>> source);
+
+	/**
+	 * @brief Sets how many ticks are read from a stream at a time
+	 * 
+	 * Two chunks per stream are in memory during a run. The size is rounded up
+	 * to a whole number of blocks.
+	 * 
+	 * @param ticks Ticks per chunk (must be > 0, default 65536)
+	 */
+	void setStreamChunkSize(size_t ticks);
+
+	/**
+	 * @brief Returns the trade columns, or nullptr if trade data isn't columnar
+	 */
+	const TradeColumns* getTradeColumns() const;
+
+	/**
+	 * @brief Returns the quote columns, or nullptr if quote data isn't columnar
+	 */
+	const QuoteColumns* getQuoteColumns() const;
+
+	/**
+	 * @brief Uses a binary trade tick file as market data, without loading it into memory
+	 * 
+	 * The file is memory-mapped and the run iterates the mapping directly, so
+	 * this returns immediately whatever the file size. Replaces any trade
+	 * ticks set with setTickData(). See writeTickFile() for the format.
+	 * 
+	 * @param path Path of a trade tick file
+	 * @throws std::runtime_error If the file can't be mapped or doesn't hold trade ticks
+	 */
+	void loadTickFile(const std::string& path);
+
+	/**
+	 * @brief Uses a binary quote tick file as quote data, without loading it into memory
+	 * 
+	 * Same as loadTickFile() for quote ticks.
+	 * 
+	 * @param path Path of a quote tick file
+	 * @throws std::runtime_error If the file can't be mapped or doesn't hold quote ticks
+	 */
+	void loadQuoteFile(const std::string& path);
+
+	/**
+	 * @brief Parses a CSV file of trade ticks and uses them as market data
+	 * 
+	 * The file is parsed in parallel straight into the engine's tick array
+	 * (see readTradeCsv() for the format). Replaces any trade ticks set
+	 * before. To parse only once, convert the file with convertCsvToTickFile()
+	 * and use loadTickFile() in later runs.
+	 * 
+	 * @param path Path of the CSV file
+	 * @param options Delimiter and number of parsing threads
+	 * @throws std::runtime_error If the file can't be read or a line is malformed
+	 */
+	void loadTickCsv(const std::string& path, const CsvOptions& options = {});
+
+	/**
+	 * @brief Parses a CSV file of quote ticks and uses them as quote data
+	 * 
+	 * Same as loadTickCsv() for quote ticks.
+	 * 
+	 * @param path Path of the CSV file
+	 * @param options Delimiter and number of parsing threads
+	 * @throws std::runtime_error If the file can't be read or a line is malformed
+	 */
+	void loadQuoteCsv(const std::string& path, const CsvOptions& options = {});
+
 	/**
 	 * @brief Registers a strategy to be backtested
 	 * 
@@ -104,21 +297,320 @@ public:
 	 */
 	void addStrategy(const std::string& name, std::unique_ptr<Strategy> strategy, const TimeFrame& tf, double initialCash);
 
+	/**
+	 * @brief Registers a strategy that runs with compile-time dispatch
+	 * 
+	 * Same as addStrategy(), but the strategy's ticks are processed by a loop
+	 * instantiated for StrategyT: onTick() is called without going through the
+	 * vtable, and the trade/quote choice is made at compile time, so the
+	 * compiler can inline the strategy, the order matching and the PnL
+	 * recording into one loop. Results are identical to addStrategy().
+	 * 
+	 * Example: engine.addTypedStrategy("Breakout", std::make_unique<BreakoutStrategy<20>>(), TimeFrame::MINUTE, 10000);
+	 * 
+	 * @tparam StrategyT Concrete strategy type (deduced)
+	 * @param name Unique identifier for this strategy instance
+	 * @param strategy The strategy implementation - its dynamic type must be exactly StrategyT
+	 * @param tf Time frame this strategy operates on
+	 * @param initialCash Starting capital for this strategy
+	 * @throws std::invalid_argument If strategy is null or is of a type derived from StrategyT
+	 */
+	template<typename StrategyT>
+	void addTypedStrategy(const std::string& name, std::unique_ptr<StrategyT> strategy, const TimeFrame& tf, double initialCash) {
+		// A qualified StrategyT::onTick() call would skip the override of a derived class
+		if (!strategy || typeid(*strategy) != typeid(StrategyT)) {
+			throw std::invalid_argument("Strategy '" + name + "' is not exactly of the type it was registered with.");
+		}
+		addStrategy(name, std::move(strategy), tf, initialCash);
+		strategies.back()->useTypedDispatch<StrategyT>();
+	}
+
+	/**
+	 * @brief Sets how many worker threads runAll() uses
+	 * 
+	 * Strategies are distributed round-robin over the workers. The engine never
+	 * starts more workers than there are strategies.
+	 * 
+	 * @param count Number of workers (0 = std::thread::hardware_concurrency())
+	 */
+	void setThreadCount(size_t count);
+
+	/**
+	 * @brief Chooses where runAll() runs its workers and where their ticks live
+	 * 
+	 * - OS: the scheduler places the threads (default)
+	 * - PINNED: worker w is pinned to a CPU of NUMA node w % nodes, so the
+	 *   workers (and their strategies) are spread evenly over the sockets and
+	 *   stay where their caches are warm
+	 * - NUMA: as PINNED, and every node running workers reads its own copy of
+	 *   the trade and quote rows, written by a thread of that node so the pages
+	 *   are local (the node already holding the data reads it in place)
+	 * 
+	 * Only the CPUs of the process's affinity mask are used. The copies cost
+	 * one pass over the data and as much memory per extra node, at every run;
+	 * columnar and streamed data are not copied (streamed chunks are loaded
+	 * once for all workers). On a single-node machine NUMA is the same as
+	 * PINNED. The calling thread runs a worker too: its affinity is restored
+	 * when runAll() returns.
+	 * 
+	 * @param placement Placement policy
+	 */
+	void setThreadPlacement(ThreadPlacement placement);
+
+	/**
+	 * @brief Sets how many ticks each worker processes before moving to the next block
+	 * 
+	 * The block should fit comfortably in L2 together with the strategies' state.
+	 * 
+	 * @param ticks Ticks per block (must be > 0)
+	 */
+	void setBlockSize(size_t ticks);
+
+	/**
+	 * @brief Chooses whether each strategy's StatsCollector keeps the full PnL series
+	 * 
+	 * With storage off, statistics come from the online accumulators only and
+	 * memory per strategy stays constant however long the run is. The PnL CSV
+	 * export then contains only its header.
+	 * 
+	 * @param store true to keep the series (default), false for streaming statistics
+	 */
+	void setStoreSeries(bool store);
+
+	/**
+	 * @brief Adds the statistics that read the whole series (registerSeriesStats()) to every strategy
+	 * 
+	 * Drawdown duration, Ulcer index, Calmar, VaR, expected shortfall and hit
+	 * rate. They share one drawdown pass and one sort of the returns, built at
+	 * the end of the run; without stored series they are reported as NaN.
+	 * 
+	 * @param enabled true to compute them, false for the default statistics only
+	 */
+	void setExtendedStats(bool enabled);
+
+	/**
+	 * @brief Chooses whether bar strategies share one bar pipeline
+	 * 
+	 * With sharing on, runAll() builds the bars of each distinct window size
+	 * once per block (cascading e.g. 5m bars from 1m bars) and hands them to
+	 * every BarStrategy of that window. With sharing off, each BarStrategy
+	 * aggregates ticks on its own. Bars and their timing are the same either way.
+	 * 
+	 * @param shared true to share bars (default), false for per-strategy aggregation
+	 */
+	void setSharedBars(bool shared);
+
+	/**
+	 * @brief Sets a function to receive each strategy's results as soon as it finishes
+	 * 
+	 * Called by runAll() from the worker that ran the strategy, right after
+	 * its statistics are computed and before any file export - so results can
+	 * be streamed out strategy by strategy while the others are completing.
+	 * Calls for strategies on different workers may run concurrently.
+	 * An exception thrown by the callback is rethrown by runAll() once all
+	 * workers are done.
+	 * 
+	 * @param callback Function called once per strategy (empty to remove)
+	 */
+	void setResultCallback(ResultCallback callback);
+
+	/**
+	 * @brief Watches runs while they are in progress
+	 * 
+	 * During runAll(), every strategy publishes its progress (ticks processed
+	 * and PnL, once per block) and its fills into its own lock-free
+	 * ProgressChannel. A separate thread drains the channels every period and
+	 * calls the observer once per strategy with new events, and a last time
+	 * after the workers have finished. The workers never wait for the
+	 * observer: events it doesn't drain in time are dropped and counted.
+	 * 
+	 * The observer is only ever called from one thread at a time, and may call
+	 * cancel(). An exception thrown by the observer stops the draining and is
+	 * rethrown by runAll() once all workers are done.
+	 * 
+	 * @param observer Function called with each strategy's new events (empty to remove)
+	 * @param period Time between two drains
+	 * @throws std::invalid_argument If period is not positive
+	 */
+	void setProgressObserver(ProgressObserver observer, std::chrono::milliseconds period = std::chrono::milliseconds(100));
+
+	/**
+	 * @brief Stops the current run at the end of the block in progress (thread-safe)
+	 * 
+	 * The strategies then finish as if the data ended there: their results
+	 * cover the ticks processed, are reported and exported as usual, and
+	 * wasCancelled() returns true. When no run is in progress, the next
+	 * runAll() stops before its first block.
+	 */
+	void cancel();
+
+	/**
+	 * @brief Returns true if the last runAll() was stopped by cancel()
+	 */
+	bool wasCancelled() const;
+
+	/**
+	 * @brief Chooses the format of the per-tick results saved by runAll(true)
+	 * 
+	 * CSV writes <name>_pnl.csv. BINARY writes <name>_results.bin instead (see
+	 * writeResultFile()): PnL, returns and every fill in binary columns, which
+	 * costs a few block writes where the CSV formats one text line per tick.
+	 * Fills are only logged during the run when they will be saved. The
+	 * <name>_statistics.csv summary is written either way.
+	 * 
+	 * @param format CSV (default) or BINARY
+	 */
+	void setResultFormat(ResultFormat format);
+
+	/**
+	 * @brief Adds the PnL series decimated for charting to binary results
+	 * 
+	 * The chart columns hold at most this many points, keeping the lowest and
+	 * highest PnL of each stretch, next to the full series (see
+	 * writeResultFile()). Statistics are computed on every tick regardless.
+	 * 
+	 * @param points Largest number of chart rows (0 = no chart columns, the default; otherwise at least 4)
+	 * @throws std::invalid_argument If points is 1, 2 or 3
+	 */
+	void setResultMaxPoints(size_t points);
+
+	/**
+	 * @brief Simulates latency, queue positions, partial fills and costs for every strategy
+	 * 
+	 * Without a model, orders fill instantly and in full, free of charge. See
+	 * ExecutionModel for what the model simulates.
+	 * 
+	 * @param model Latency, slippage and fee parameters
+	 * @throws std::invalid_argument If the slippage is outside [0, 1) or a fee is negative
+	 */
+	void setExecutionModel(const ExecutionModel& model);
+
+	/**
+	 * @brief Sets how often the hot path is timed in instrumented builds
+	 * 
+	 * Built with BACKTEST_INSTRUMENT, runAll() times onTick, handleTick and
+	 * the PnL recording of one tick out of interval, per strategy. Has no
+	 * effect otherwise.
+	 * 
+	 * @param interval Ticks per timed tick (1 = every tick, 16 by default)
+	 * @throws std::invalid_argument If interval is 0 or above 2^32 - 1
+	 */
+	void setProfileInterval(size_t interval);
+
+	/**
+	 * @brief Returns the latency summaries of the last run
+	 * 
+	 * Three reports (onTick, handleTick, recordPnL) per strategy, in
+	 * registration order. Always empty unless built with BACKTEST_INSTRUMENT.
+	 */
+	const std::vector<ProfileReport>& getProfileReports() const;
+
+	/**
+	 * @brief Sets the memory resource of the strategies added from now on
+	 * 
+	 * Their OrderManager and StatsCollector (book, per-symbol state, fills,
+	 * series, registered statistics) allocate from it - typically a RunArena,
+	 * reset once the engine is destroyed. runAll() runs the strategies on
+	 * several threads, so a resource shared by more than one strategy must be
+	 * thread-safe (a RunArena is not) unless setThreadCount(1) is used.
+	 * 
+	 * @param resource Memory resource (must outlive the engine)
+	 * @throws std::invalid_argument If resource is null
+	 */
+	void setMemoryResource(std::pmr::memory_resource* resource);
+
+	/**
+	 * @brief Runs the strategies as one book sharing capital and risk limits
+	 * 
+	 * In portfolio mode runAll() replaces the parallel, strategy-by-strategy
+	 * blocks with a single event loop over the trades and quotes merged by
+	 * timestamp (a trade before a quote of the same time): the book is marked
+	 * at every price of a timestamp, then every strategy reacts to each of its
+	 * ticks in registration order, so each order is checked against the
+	 * positions and prices of the whole book at that instant (see Portfolio and
+	 * RiskLimits). Positions are netted per symbol into one position table, and
+	 * the value of the book is recorded once per timestamp, reported as an extra result named
+	 * "Portfolio" (callback and Portfolio_* files). Each strategy's own
+	 * results, on its initialCash, attribute the book's PnL to it, and gain a
+	 * "Rejected_Orders" statistic.
+	 * 
+	 * The loop runs on one thread, and bar strategies aggregate their own bars
+	 * (setSharedBars() doesn't apply).
+	 * 
+	 * @param capital Starting cash of the book
+	 * @param tf Time frame used for the portfolio statistics
+	 * @param limits Pre-trade limits (none by default)
+	 * @throws std::invalid_argument If capital or a limit is not positive
+	 */
+	void setPortfolioMode(double capital, const TimeFrame& tf, const RiskLimits& limits = {});
+
+	/**
+	 * @brief Returns to independent strategies, each trading on its own cash (the default)
+	 */
+	void clearPortfolioMode();
+
+	/**
+	 * @brief Returns the book of the last portfolio run (nullptr if the last run was not one)
+	 */
+	const Portfolio* getPortfolio() const;
+
 	/**
 	 * @brief Runs all registered strategies in parallel and collects results
 	 * 
 	 * For each strategy:
 	 * 1. Sets up the OrderManager connection
 	 * 2. Registers statistics collection
-	 * 3. Spawns a worker thread
-	 * 4. In the thread: processes all ticks, calls strategy callbacks
+	 * 3. Assigns it to one of the worker threads
+	 * 4. In the worker: processes all ticks block by block, calls strategy callbacks
 	 * 5. Collects and computes statistics
-	 * 6. Optionally exports results to CSV files
+	 * 6. Optionally exports results to files (see setResultFormat())
+	 * 
+	 * All strategies see the same market data for fair comparison.
 	 * 
-	 * All strategies run in parallel threads, so they execute simultaneously
-	 * on the same market data for fair comparison.
+	 * In portfolio mode, the strategies run as one book instead (see
+	 * setPortfolioMode()).
 	 * 
-	 * @param saveToCSV If true, exports PnL and statistics to CSV files
+	 * In instrumented builds, the latency reports are available from
+	 * getProfileReports() afterwards, and saved as <name>_profile.csv next to
+	 * the statistics when saving.
+	 * 
+	 * @param saveToCSV If true, exports the per-tick results and the statistics to files
+	 * @throws std::runtime_error If a strategy has no data of the kind it consumes, or a binary result file can't be written
+	 * @throws Whatever the result callback threw
+	 * @throws Whatever a tick stream threw while being read (the run stops at the failed chunk)
 	 */
 	void runAll(const bool saveToCSV = false);
+
+	/**
+	 * @brief Runs a parameter sweep over the loaded data
+	 * 
+	 * Every point of the grid is built with the factory and backtested on the
+	 * engine's tick/quote data, using the engine's thread count. Registered
+	 * strategies (addStrategy) are not involved. See ParameterSweep.
+	 * 
+	 * @param grid Parameter space to sweep
+	 * @param factory Builds the strategy for each point of the grid
+	 * @param tf Time frame used for the statistics
+	 * @param initialCash Starting capital of every variant
+	 * @return One result per grid point, ordered by grid index
+	 * @throws std::logic_error If the data is streamed (see setTickStream())
+	 */
+	std::vector<SweepResult> runSweep(const ParameterGrid& grid, const StrategyFactory& factory, const TimeFrame& tf, double initialCash) const;
+
+	/**
+	 * @brief Runs a walk-forward analysis over the loaded data
+	 * 
+	 * Every fold is evaluated with a strategy from the builder on the engine's
+	 * tick/quote data, using the engine's thread count; folds sharing their
+	 * training start fork from checkpoints of one training pass. Registered
+	 * strategies (addStrategy) are not involved. See WalkForward.
+	 * 
+	 * @param folds Train/test splits (e.g. WalkForward::anchored())
+	 * @param builder Builds the strategy
+	 * @param tf Time frame used for the statistics
+	 * @param initialCash Starting capital of every training window
+	 * @return One result per fold, in the order of folds
+	 * @throws std::logic_error If the data is streamed (see setTickStream())
+	 */
+	std::vector<WalkForwardResult> runWalkForward(std::span<const WalkForwardFold> folds, const StrategyBuilder& builder, const TimeFrame& tf, double initialCash) const;
 };
\ No newline at end of file
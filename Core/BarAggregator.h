@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <optional>
 #include "Tick.h"
 #include "Bar.h"
@@ -26,13 +27,26 @@
  * Example: If windowSize = 60000 (60 seconds in milliseconds),
  * ticks at timestamps 1000, 1500, 2000 (all in same 60s window)
  * are aggregated into one bar.
+ * 
+ * Bars can also be built from finer bars (merge()), which is how the
+ * BarPipeline cascades 1m -> 5m -> 1h without touching every tick again.
  */
 class BarAggregator {
 private:
 	uint64_t windowSize;              // Time window size in milliseconds (e.g., 60000 for 1 minute)
-	uint64_t currentWindow = 0;        // Current window's start timestamp
-	std::optional<Bar> currentBar;    // The bar being built for the current window
-	
+	Bar currentBar{};                 // The bar being built for the current window
+	bool building = false;            // True if currentBar holds a bar
+	Bar completedBar{};               // Last completed bar (returned by pointer from push/merge/close)
+
+	/**
+	 * @brief Moves the current bar to completedBar and returns it
+	 */
+	const Bar* complete() {
+		completedBar = currentBar;
+		building = false;
+		return &completedBar;
+	}
+
 public:
 	/**
 	 * @brief Constructs a BarAggregator with the specified window size
@@ -42,7 +56,12 @@ public:
 	BarAggregator(uint64_t windowSize) : windowSize(windowSize) {}
 
 	/**
-	 * @brief Updates the aggregator with a new tick
+	 * @brief Returns the window size in milliseconds
+	 */
+	uint64_t getWindowSize() const { return windowSize; }
+
+	/**
+	 * @brief Updates the aggregator with a new tick, without copying bars
 	 * 
 	 * If the tick belongs to the current window, it updates the current bar.
 	 * If the tick belongs to a new window, it:
@@ -50,48 +69,99 @@ public:
 	 * 2. Starts a new bar for the new window
 	 * 
 	 * @param tick The new tick to process
-	 * @return Completed bar if we moved to a new window, nullopt otherwise
+	 * @return Completed bar if we moved to a new window (valid until the next call), nullptr otherwise
 	 */
-	std::optional<Bar> update(const Tick& tick) {
+	const Bar* push(const Tick& tick) {
 		// Calculate which window this tick belongs to
 		// Round down timestamp to nearest window boundary
 		// Example: tick.timestamp=125000, windowSize=60000 -> tickWindow=120000
-		uint64_t tickWindow = tick.timestamp / windowSize * windowSize;
+		const uint64_t tickWindow = tick.timestamp / windowSize * windowSize;
+
+		if (building && tickWindow == currentBar.startTimestamp) {
+			// Update the current bar with this tick
+			currentBar.high = std::max(currentBar.high, tick.price);
+			currentBar.low = std::min(currentBar.low, tick.price);
+			currentBar.close = tick.price;         // Close: always the last price in the window
+			currentBar.volume += tick.volume;      // Volume: accumulate all volumes in the window
+			return nullptr;                        // Still in the same window
+		}
 
-		// Check if this tick starts a new window
-		if (!currentBar || tickWindow != currentWindow) {
-			// Save the completed bar from previous window (if any)
-			std::optional<Bar> completed = currentBar;
-			
-			// Start a new bar for the new window
-			// Initialize OHLC all to the first tick's price
-			currentBar = Bar{
-				.startTimestamp = tickWindow,                    // Window start time
-				.endTimestamp = tickWindow + windowSize,         // Window end time
-				.open = tick.price,                              // First price = open
-				.high = tick.price,                               // First price = initial high
-				.low = tick.price,                                // First price = initial low
-				.close = tick.price,                              // First price = initial close
-				.volume = tick.volume,                           // First tick's volume
-			};
-			currentWindow = tickWindow;
+		// This tick starts a new window: save the completed bar from the previous window (if any)
+		const Bar* completed = building ? complete() : nullptr;
 
-			// Return the completed bar from previous window (if any)
-			return completed;
+		// Start a new bar, OHLC all initialized to the first tick's price
+		currentBar = Bar{
+			.startTimestamp = tickWindow,                    // Window start time
+			.endTimestamp = tickWindow + windowSize,         // Window end time
+			.open = tick.price,                              // First price = open
+			.high = tick.price,                              // First price = initial high
+			.low = tick.price,                               // First price = initial low
+			.close = tick.price,                             // First price = initial close
+			.volume = tick.volume,                           // First tick's volume
+		};
+		building = true;
+		return completed;
+	}
+
+	/**
+	 * @brief Adds a finer bar (e.g. a 1-minute bar into a 5-minute aggregator)
+	 * 
+	 * The finer window size must divide this aggregator's window size, so that
+	 * each finer bar falls entirely inside one window. Unlike push(), a window
+	 * is not closed by the next bar but by close(), so the coarse bar can be
+	 * emitted on the same tick as the last finer bar it contains.
+	 * 
+	 * @param bar Completed finer bar
+	 * @return Completed bar if bar belongs to a new window and the previous one wasn't closed, nullptr otherwise
+	 */
+	const Bar* merge(const Bar& bar) {
+		const uint64_t barWindow = bar.startTimestamp / windowSize * windowSize;
+
+		if (building && barWindow == currentBar.startTimestamp) {
+			currentBar.high = std::max(currentBar.high, bar.high);
+			currentBar.low = std::min(currentBar.low, bar.low);
+			currentBar.close = bar.close;
+			currentBar.volume += bar.volume;
+			return nullptr;
 		}
 
-		// Update the current bar with this tick
-		// High: maximum of current high and this tick's price
-		currentBar->high = std::max(currentBar->high, tick.price);
-		// Low: minimum of current low and this tick's price
-		currentBar->low = std::min(currentBar->low, tick.price);
-		// Close: always the last price in the window
-		currentBar->close = tick.price;
-		// Volume: accumulate all volumes in the window
-		currentBar->volume += tick.volume;
+		const Bar* completed = building ? complete() : nullptr;
+		currentBar = Bar{
+			.startTimestamp = barWindow,
+			.endTimestamp = barWindow + windowSize,
+			.open = bar.open,
+			.high = bar.high,
+			.low = bar.low,
+			.close = bar.close,
+			.volume = bar.volume,
+		};
+		building = true;
+		return completed;
+	}
+
+	/**
+	 * @brief Completes the current bar if the given time is past its window
+	 * 
+	 * @param timestamp Current time (timestamp of the latest tick)
+	 * @return Completed bar (valid until the next call), or nullptr if the window is still open
+	 */
+	const Bar* close(uint64_t timestamp) {
+		if (building && timestamp >= currentBar.endTimestamp) return complete();
+		return nullptr;
+	}
 
-		// No completed bar yet (still in same window)
-		return std::nullopt;
+	/**
+	 * @brief Updates the aggregator with a new tick
+	 * 
+	 * Same as push(), returning a copy of the completed bar.
+	 * 
+	 * @param tick The new tick to process
+	 * @return Completed bar if we moved to a new window, nullopt otherwise
+	 */
+	std::optional<Bar> update(const Tick& tick) {
+		const Bar* completed = push(tick);
+		if (!completed) return std::nullopt;
+		return *completed;
 	}
 
 	/**
@@ -103,6 +173,7 @@ public:
 	 * @return The current incomplete bar, or nullopt if no bar exists
 	 */
 	std::optional<Bar> flush() const {
+		if (!building) return std::nullopt;
 		return currentBar;
 	}
-};
\ No newline at end of file
+};
@@ -0,0 +1,88 @@
+#include <stdexcept>
+
+#include "BarPipeline.h"
+
+/**
+ * @brief Adds a level for the window size unless it already exists
+ */
+size_t BarPipeline::addWindow(uint64_t windowSize) {
+	if (windowSize == 0) throw std::invalid_argument("Bar window size must be greater than 0.");
+
+	for (size_t i = 0; i < levels.size(); i++) {
+		if (levels[i].aggregator.getWindowSize() == windowSize) return i;
+	}
+	levels.push_back(Level{ BarAggregator(windowSize), {}, {}, true });
+	return levels.size() - 1;
+}
+
+/**
+ * @brief Builds the cascade
+ *
+ * The parent of a level is the largest other window that divides its size
+ * exactly - every bar of the parent then falls inside one bar of the child.
+ * Levels without such a window are fed from ticks.
+ */
+void BarPipeline::build(size_t maxBlockTicks) {
+	roots.clear();
+	for (Level& level : levels) {
+		level.children.clear();
+		level.fromTicks = true;
+	}
+
+	for (size_t i = 0; i < levels.size(); i++) {
+		const uint64_t window = levels[i].aggregator.getWindowSize();
+		size_t parent = levels.size();
+		for (size_t j = 0; j < levels.size(); j++) {
+			const uint64_t candidate = levels[j].aggregator.getWindowSize();
+			if (candidate < window && window % candidate == 0 &&
+				(parent == levels.size() || candidate > levels[parent].aggregator.getWindowSize())) {
+				parent = j;
+			}
+		}
+
+		if (parent == levels.size()) {
+			roots.push_back(i);
+		} else {
+			levels[parent].children.push_back(i);
+			levels[i].fromTicks = false;
+		}
+	}
+
+	// A block completes at most one bar per tick on each level, plus the one closed by merge()
+	for (Level& level : levels) {
+		level.events.reserve(maxBlockTicks + 1);
+	}
+}
+
+/**
+ * @brief Records a completed bar and forwards it to the coarser levels built from it
+ *
+ * A child's window always ends on a parent bar boundary, so the tick that
+ * completes a child bar is also one that completes a parent bar: closing the
+ * child right after merging the parent bar gives the same timing as building
+ * the child from ticks.
+ */
+void BarPipeline::emit(size_t level, size_t tick, uint64_t timestamp, const Bar& bar) {
+	levels[level].events.push_back(BarEvent{ tick, bar });
+
+	for (size_t child : levels[level].children) {
+		BarAggregator& aggregator = levels[child].aggregator;
+		if (const Bar* completed = aggregator.merge(bar)) emit(child, tick, timestamp, *completed);
+		if (const Bar* completed = aggregator.close(timestamp)) emit(child, tick, timestamp, *completed);
+	}
+}
+
+/**
+ * @brief Feeds the block to the tick-driven levels, the cascade does the rest
+ */
+void BarPipeline::process(std::span<const Tick> ticks) {
+	for (Level& level : levels) level.events.clear();
+
+	for (size_t i = 0; i < ticks.size(); i++) {
+		for (size_t root : roots) {
+			if (const Bar* completed = levels[root].aggregator.push(ticks[i])) {
+				emit(root, i, ticks[i].timestamp, *completed);
+			}
+		}
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Bar.h"
+#include "BarAggregator.h"
+#include "Tick.h"
+
+/**
+ * @brief A bar completed while processing a block of ticks
+ */
+struct BarEvent {
+	size_t tick;   // Index, inside the block, of the tick that completed the bar
+	Bar bar;       // The completed bar
+};
+
+/**
+ * @brief Shared bar aggregation for every bar strategy of a run
+ *
+ * Instead of each BarStrategy aggregating the same ticks into the same bars,
+ * the engine registers each distinct window size once and the pipeline builds
+ * the bars of all of them in a single pass over each block of ticks. Bar
+ * strategies then read the completed bars of their window by const reference.
+ *
+ * Windows are cascaded: a window whose size is a multiple of a smaller
+ * registered window is built from that window's bars (e.g. 5m from 1m, 1h from
+ * 5m) instead of from ticks. Only the finest windows of each chain look at
+ * every tick, so the cost grows with the number of distinct window sizes, not
+ * with the number of strategies. Cascaded bars have the same timestamps and
+ * OHLC as bars built directly from ticks and complete on the same tick (the
+ * volume is summed in a different order, so it can differ in the last bits).
+ *
+ * Usage: addWindow() for each window, build(), then process() each block and
+ * read events() before processing the next block.
+ */
+class BarPipeline {
+private:
+	struct Level {
+		BarAggregator aggregator;       // Builds this level's bars
+		std::vector<size_t> children;   // Coarser levels built from this level's bars
+		std::vector<BarEvent> events;   // Bars completed in the last processed block
+		bool fromTicks = true;          // False if built from a finer level's bars
+	};
+
+	std::vector<Level> levels;          // One level per distinct window size (registration order)
+	std::vector<size_t> roots;          // Levels built directly from ticks
+
+	void emit(size_t level, size_t tick, uint64_t timestamp, const Bar& bar);
+
+public:
+	/**
+	 * @brief Registers a window size (no-op if already registered)
+	 *
+	 * @param windowSize Bar length in milliseconds (must be > 0)
+	 * @return Level index of the window, to pass to events()
+	 * @throws std::invalid_argument If windowSize is 0
+	 */
+	size_t addWindow(uint64_t windowSize);
+
+	/**
+	 * @brief Links every window to the largest registered window that divides it
+	 *
+	 * Must be called after the last addWindow() and before process().
+	 *
+	 * @param maxBlockTicks Largest block that will be processed (event buffers are reserved for it)
+	 */
+	void build(size_t maxBlockTicks);
+
+	/**
+	 * @brief Returns true if no window is registered
+	 */
+	bool empty() const { return levels.empty(); }
+
+	/**
+	 * @brief Aggregates the next block of ticks
+	 *
+	 * Replaces the events of the previous block. Does not allocate once
+	 * build() has reserved the event buffers.
+	 *
+	 * @param ticks Next block of ticks, in time order
+	 */
+	void process(std::span<const Tick> ticks);
+
+	/**
+	 * @brief Returns the bars of a window completed in the last processed block
+	 *
+	 * Events are ordered by tick index.
+	 *
+	 * @param level Index returned by addWindow()
+	 */
+	std::span<const BarEvent> events(size_t level) const { return levels[level].events; }
+};
@@ -3,6 +3,7 @@
 #include "Strategy.h"
 #include "BarAggregator.h"
 #include "OrderManager.h"
+#include "TimeFrame.h"
 
 /**
  * @brief Base class for strategies that operate on bars (OHLCV) instead of individual ticks
@@ -24,6 +25,12 @@
  * 
  * The windowSize parameter determines how ticks are aggregated:
  * - windowSize in milliseconds (e.g., 60000 = 1-minute bars)
+ * 
+ * When run by the BacktestEngine, bars are not built by the strategy itself:
+ * the engine's BarPipeline builds each distinct window once for all bar
+ * strategies and calls onBar() directly (onTick() is then not called). The
+ * bars and their timing are the same as with the strategy's own aggregator,
+ * which is used when the strategy is run in any other way (e.g. sweeps).
  */
 class BarStrategy : public Strategy {
 private:
@@ -39,6 +46,13 @@ public:
 	 */
 	BarStrategy(uint64_t windowSize = 60) : aggregator(windowSize) {}
 
+	/**
+	 * @brief Constructs a BarStrategy with bars of one time frame (e.g. 1-minute bars)
+	 * 
+	 * @param tf Bar time frame (see getBarMillis())
+	 */
+	explicit BarStrategy(TimeFrame tf) : aggregator(getBarMillis(tf)) {}
+
 	virtual ~BarStrategy() = default;
 
 	/**
@@ -51,23 +65,26 @@ public:
 	 */
 	virtual void onBar(const Bar& bar) = 0;
 
+	/**
+	 * @brief Returns the bar window size in milliseconds
+	 */
+	uint64_t getWindowSize() const { return aggregator.getWindowSize(); }
+
 	/**
 	 * @brief Processes a tick and aggregates it into bars
 	 * 
-	 * This method is called by BacktestEngine for each tick.
 	 * It delegates to the BarAggregator, and when a bar is completed,
-	 * calls the derived class's onBar() method.
+	 * calls the derived class's onBar() method. Final, so that feeding
+	 * onBar() from the engine's shared pipeline is equivalent.
 	 * 
 	 * @param tick The current market tick
 	 */
-	void onTick(const Tick& tick) override {
+	void onTick(const Tick& tick) final {
 		// Update aggregator with new tick
 		// Returns a completed bar if we moved to a new time window
-		auto bar = aggregator.update(tick);
-		
 		// If a bar was completed, call the strategy's onBar() method
-		if (bar.has_value()) {
-			onBar(bar.value());
+		if (const Bar* bar = aggregator.push(tick)) {
+			onBar(*bar);
 		}
 	}
 };
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "Order.h"
+#include "OrderManager.h"
+
+/**
+ * @brief Orders placed by a strategy that processes a whole block of ticks at once
+ *
+ * A block strategy sees every tick of a block before any of them is matched,
+ * so it can't submit its orders right away: each one is staged with the
+ * index (within the block) of the tick it reacts to. The engine then walks
+ * the block tick by tick, submitting the orders of the tick, matching and
+ * recording the PnL - exactly the sequence of a strategy calling submit()
+ * from onTick(). Indices must not decrease from one order to the next.
+ *
+ * The buffer is reused from block to block, so staging doesn't allocate
+ * once it has grown to the busiest block.
+ */
+class BlockOrders {
+private:
+	struct Staged {
+		size_t tick;  // Index of the tick within the block
+		Order order;
+	};
+
+	std::vector<Staged> staged;  // In submission order
+	size_t blockSize = 0;        // Ticks in the current block
+
+public:
+	/**
+	 * @brief Stages an order, submitted when the engine reaches its tick
+	 *
+	 * @param tick Index of the tick within the block
+	 * @param order Order to submit on that tick
+	 * @throws std::out_of_range If tick is not in the block
+	 * @throws std::invalid_argument If tick is before the tick of the previous order
+	 */
+	void submit(size_t tick, const Order& order) {
+		if (tick >= blockSize) throw std::out_of_range("Order staged past the end of the block.");
+		if (!staged.empty() && tick < staged.back().tick) throw std::invalid_argument("Orders must be staged in tick order.");
+		staged.push_back(Staged{ tick, order });
+	}
+
+	/**
+	 * @brief Returns the number of orders staged in the current block
+	 */
+	size_t size() const { return staged.size(); }
+
+	/**
+	 * @brief Returns the tick index of the staged order at a position (engine side)
+	 */
+	size_t tickOf(size_t at) const { return staged[at].tick; }
+
+	/**
+	 * @brief Starts a block of the given number of ticks, dropping the previous orders (engine side)
+	 */
+	void reset(size_t ticks) {
+		staged.clear();
+		blockSize = ticks;
+	}
+
+	/**
+	 * @brief Submits the staged order at a position and those staged after it for the same tick (engine side)
+	 *
+	 * @param at Position of the first order of the tick
+	 * @param orderManager Where to submit them, in the order they were staged
+	 * @return Position of the first order of the next tick (size() if none)
+	 */
+	size_t release(size_t at, OrderManager& orderManager) {
+		const size_t tick = staged[at].tick;
+		for (; at < staged.size() && staged[at].tick == tick; at++) {
+			orderManager.submit(staged[at].order);
+		}
+		return at;
+	}
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <span>
+
+#include "Strategy.h"
+#include "QuoteStrategy.h"
+#include "BlockOrders.h"
+#include "OrderManager.h"
+
+/**
+ * @brief Base class for strategies that take their trade ticks a block at a time
+ *
+ * Instead of one onTick() call per tick, the engine calls onTicks() once per
+ * block, so the strategy can compute its signals over the whole block in
+ * tight (vectorizable) loops. Orders are staged in a BlockOrders with the
+ * index of their tick, and the engine then submits, matches and records the
+ * PnL tick by tick: fills, positions and statistics are those of an onTick()
+ * strategy placing the same orders on the same ticks.
+ *
+ * The price of batching: while onTicks() runs, the OrderManager still
+ * reflects the start of the block. A strategy whose decisions depend on its
+ * fills, positions or PnL within a block should stay a per-tick Strategy.
+ *
+ * When run in any other way than by a StrategyContext (which detects block
+ * strategies), onTick() adapts each tick into a block of one.
+ */
+class BlockStrategy : public Strategy {
+private:
+	BlockOrders single;  // Orders of the one-tick blocks built by onTick()
+
+protected:
+	OrderManager* orderManager = nullptr;  // Set by setOrderManager()
+
+public:
+	virtual ~BlockStrategy() = default;
+
+	/**
+	 * @brief Stores the OrderManager (final, so that onTick() can submit the staged orders)
+	 */
+	void setOrderManager(OrderManager* om) final { orderManager = om; }
+
+	/**
+	 * @brief Called for each block of trade ticks during backtesting
+	 *
+	 * @param ticks Block of trade ticks, in time order
+	 * @param orders Where to stage the orders of the block (see BlockOrders::submit())
+	 */
+	virtual void onTicks(std::span<const Tick> ticks, BlockOrders& orders) = 0;
+
+	/**
+	 * @brief Runs onTicks() on a block of one tick and submits its orders
+	 */
+	void onTick(const Tick& tick) final {
+		single.reset(1);
+		onTicks(std::span<const Tick>(&tick, 1), single);
+		if (single.size() != 0) single.release(0, *orderManager);
+	}
+};
+
+/**
+ * @brief Base class for strategies that take their quote ticks a block at a time
+ *
+ * The quote counterpart of BlockStrategy: onQuotes() replaces the per-quote
+ * onTick(), with the same staging of orders and the same guarantees.
+ */
+class BlockQuoteStrategy : public QuoteStrategy {
+private:
+	BlockOrders single;  // Orders of the one-quote blocks built by onTick()
+
+protected:
+	OrderManager* orderManager = nullptr;  // Set by setOrderManager()
+
+public:
+	virtual ~BlockQuoteStrategy() = default;
+
+	/**
+	 * @brief Stores the OrderManager (final, so that onTick() can submit the staged orders)
+	 */
+	void setOrderManager(OrderManager* om) final { orderManager = om; }
+
+	/**
+	 * @brief Called for each block of quote ticks during backtesting
+	 *
+	 * @param quotes Block of quote ticks, in time order
+	 * @param orders Where to stage the orders of the block (see BlockOrders::submit())
+	 */
+	virtual void onQuotes(std::span<const QuoteTick> quotes, BlockOrders& orders) = 0;
+
+	using QuoteStrategy::onTick;
+
+	/**
+	 * @brief Runs onQuotes() on a block of one quote and submits its orders
+	 */
+	void onTick(const QuoteTick& tick) final {
+		single.reset(1);
+		onQuotes(std::span<const QuoteTick>(&tick, 1), single);
+		if (single.size() != 0) single.release(0, *orderManager);
+	}
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "TickSource.h"
+
+/**
+ * @brief Double-buffered window over a tick source
+ *
+ * Holds two chunks of the stream: the front chunk, which the backtest reads,
+ * and the back chunk, which a background task fills from the source at the
+ * same time. advance() waits for the back chunk (usually already loaded),
+ * swaps the two and starts loading the following chunk into the buffer just
+ * released. Reading the source overlaps with the strategies' work, and memory
+ * is two chunks whatever the length of the stream.
+ *
+ * Ticks are addressed by their index in the whole stream; only indices inside
+ * the front chunk can be read.
+ *
+ * @tparam TickT Tick or QuoteTick
+ */
+template<typename TickT>
+class ChunkBuffer {
+private:
+	TickSource<TickT>& source;
+	std::vector<TickT> front;       // Chunk being read
+	std::vector<TickT> back;        // Chunk being loaded
+	size_t frontBegin = 0;          // Stream index of front[0]
+	size_t frontCount = 0;          // Ticks in the front chunk
+	std::future<size_t> pending;    // Load of the back chunk (invalid once the source is exhausted)
+
+	/**
+	 * @brief Fills a buffer from the source, returns the number of ticks read
+	 *
+	 * A short count means the source is exhausted.
+	 */
+	static size_t fill(TickSource<TickT>& source, std::vector<TickT>& buffer) {
+		size_t count = 0;
+		while (count < buffer.size()) {
+			const size_t read = source.read(std::span<TickT>(buffer).subspan(count));
+			if (read == 0) break;
+			count += read;
+		}
+		return count;
+	}
+
+	void startLoad() {
+		pending = std::async(std::launch::async, [this] { return fill(source, back); });
+	}
+
+public:
+	/**
+	 * @brief Loads the first chunk and starts loading the second one
+	 *
+	 * @param source Stream to read (must outlive the buffer)
+	 * @param chunkSize Ticks per chunk (must be > 0)
+	 * @throws std::invalid_argument If chunkSize is 0
+	 */
+	ChunkBuffer(TickSource<TickT>& source, size_t chunkSize) : source(source) {
+		if (chunkSize == 0) throw std::invalid_argument("Chunk size must be greater than 0.");
+		front.resize(chunkSize);
+		back.resize(chunkSize);
+		frontCount = fill(source, front);
+		if (frontCount == chunkSize) startLoad();
+	}
+
+	/**
+	 * @brief Waits for the background load, if any (its result is dropped)
+	 */
+	~ChunkBuffer() {
+		if (pending.valid()) pending.wait();
+	}
+
+	ChunkBuffer(const ChunkBuffer&) = delete;
+	ChunkBuffer& operator=(const ChunkBuffer&) = delete;
+
+	/**
+	 * @brief Stream index one past the last tick of the front chunk
+	 *
+	 * Once the stream is exhausted, this is the length of the stream.
+	 */
+	size_t end() const { return frontBegin + frontCount; }
+
+	/**
+	 * @brief Returns up to count ticks starting at stream index begin
+	 *
+	 * Clipped to the front chunk; empty if begin is at or past end().
+	 *
+	 * @param begin Stream index of the first tick, at least the start of the front chunk
+	 * @param count Maximum number of ticks
+	 */
+	std::span<const TickT> block(size_t begin, size_t count) const {
+		if (begin >= end()) return {};
+		const size_t offset = begin - frontBegin;
+		return std::span<const TickT>(front).subspan(offset, std::min(count, frontCount - offset));
+	}
+
+	/**
+	 * @brief Moves to the next chunk
+	 *
+	 * Nobody may read the front chunk during the call: its buffer is handed to
+	 * the background load of the chunk after next.
+	 *
+	 * @return false if the stream is exhausted (end() is then the stream length)
+	 * @throws Whatever the source threw while loading the chunk
+	 */
+	bool advance() {
+		frontBegin += frontCount;
+		frontCount = 0;
+		if (!pending.valid()) return false;
+
+		const size_t count = pending.get();
+		std::swap(front, back);
+		frontCount = count;
+		if (count == front.size()) startLoad();
+		return count > 0;
+	}
+};
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "DistributionSketch.h"
+
+DistributionSketch::DistributionSketch(double relativeAccuracy) : accuracy(relativeAccuracy) {
+	if (!(relativeAccuracy > 0.0 && relativeAccuracy < 1.0)) throw std::invalid_argument("Relative accuracy must be in (0, 1).");
+	logGamma = std::log((1.0 + relativeAccuracy) / (1.0 - relativeAccuracy));
+}
+
+/**
+ * @brief Bucket k holds the magnitudes in (gamma^(k-1), gamma^k]
+ */
+int32_t DistributionSketch::bucketOf(double magnitude) const {
+	return static_cast<int32_t>(std::ceil(std::log(magnitude) / logGamma));
+}
+
+/**
+ * @brief Magnitude within the relative accuracy of every value of the bucket: 2 gamma^k / (gamma + 1)
+ */
+double DistributionSketch::bucketValue(int32_t bucket) const {
+	return std::exp(bucket * logGamma) * (1.0 - accuracy);
+}
+
+/**
+ * @brief Calls visit(value, count) for every non-empty bucket in ascending order of value, until it returns true
+ */
+template<typename Visit>
+void DistributionSketch::forEachBucket(Visit&& visit) const {
+	for (auto it = negative.rbegin(); it != negative.rend(); ++it) {
+		if (visit(-bucketValue(it->first), it->second)) return;
+	}
+	if (zeros != 0 && visit(0.0, zeros)) return;
+	for (const auto& [bucket, count] : positive) {
+		if (visit(bucketValue(bucket), count)) return;
+	}
+}
+
+void DistributionSketch::add(double value) {
+	if (!std::isfinite(value)) return;
+
+	if (value >= MIN_MAGNITUDE) positive[bucketOf(value)]++;
+	else if (value <= -MIN_MAGNITUDE) negative[bucketOf(-value)]++;
+	else zeros++;
+
+	total++;
+	const double delta = value - runningMean;
+	runningMean += delta / total;
+	m2 += delta * (value - runningMean);
+	smallest = std::min(smallest, value);
+	largest = std::max(largest, value);
+}
+
+/**
+ * @brief Adds the bucket counts and combines the moments (Chan et al.)
+ */
+void DistributionSketch::merge(const DistributionSketch& other) {
+	if (other.accuracy != accuracy) throw std::invalid_argument("Cannot merge sketches of different accuracies.");
+	if (other.total == 0) return;
+
+	for (const auto& [bucket, count] : other.positive) positive[bucket] += count;
+	for (const auto& [bucket, count] : other.negative) negative[bucket] += count;
+	zeros += other.zeros;
+
+	const uint64_t combined = total + other.total;
+	const double delta = other.runningMean - runningMean;
+	runningMean += delta * other.total / combined;
+	m2 += other.m2 + delta * delta * (double(total) * other.total / combined);
+	total = combined;
+	smallest = std::min(smallest, other.smallest);
+	largest = std::max(largest, other.largest);
+}
+
+double DistributionSketch::stdDev() const {
+	return total ? std::sqrt(m2 / total) : 0.0;
+}
+
+/**
+ * @brief Walks the buckets up to the one holding rank q * (count - 1)
+ */
+double DistributionSketch::quantile(double q) const {
+	if (!(q >= 0.0 && q <= 1.0)) throw std::invalid_argument("Quantile must be in [0, 1].");
+	if (total == 0) return 0.0;
+
+	const double rank = q * (total - 1);
+	double result = largest;
+	uint64_t seen = 0;
+	forEachBucket([&](double value, uint64_t count) {
+		seen += count;
+		if (seen <= rank) return false;
+		result = value;
+		return true;
+	});
+	return std::clamp(result, smallest, largest);
+}
+
+/**
+ * @brief Averages the lowest buckets, the last one weighted by the part of it inside the tail
+ */
+double DistributionSketch::tailMean(double alpha) const {
+	if (!(alpha > 0.0 && alpha <= 1.0)) throw std::invalid_argument("Tail fraction must be in (0, 1].");
+	if (total == 0) return 0.0;
+
+	const double needed = alpha * total;
+	double taken = 0.0;
+	double sum = 0.0;
+	forEachBucket([&](double value, uint64_t count) {
+		const double weight = std::min(double(count), needed - taken);
+		sum += weight * std::clamp(value, smallest, largest);
+		taken += weight;
+		return taken >= needed;
+	});
+	return sum / needed;
+}
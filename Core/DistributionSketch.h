@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+
+/**
+ * @brief Mergeable summary of a stream of values: quantiles, tail mean, moments
+ *
+ * Quantiles come from logarithmic buckets (as in DDSketch): a value x is
+ * counted in bucket ceil(log_gamma(|x|)) of its sign, with
+ * gamma = (1 + a) / (1 - a) for a relative accuracy a. Every quantile is then
+ * known within a relative error a, whatever the number of values or their
+ * order, and the memory is bounded by the range of the values (about
+ * ln(max / min) / 2a buckets per sign), not by their number. Values with
+ * |x| < 1e-12 are counted as 0.
+ *
+ * Bucket counts are integers, so quantiles and tail means don't depend on the
+ * order of add()/merge() calls. Count, mean, variance, min and max are exact
+ * (running moments, merged with Chan's formula); the mean and variance may
+ * differ in the last digits with the order of the values.
+ *
+ * Not thread-safe: fill one sketch per thread and merge() them.
+ */
+class DistributionSketch {
+private:
+	static constexpr double MIN_MAGNITUDE = 1e-12;  // Smaller magnitudes are counted as zero
+
+	double accuracy;                       // Relative accuracy of the quantiles
+	double logGamma;                       // ln((1 + accuracy) / (1 - accuracy))
+	std::map<int32_t, uint64_t> positive;  // Bucket -> count, values > 0
+	std::map<int32_t, uint64_t> negative;  // Bucket of |x| -> count, values < 0
+	uint64_t zeros = 0;                    // Values counted as 0
+
+	uint64_t total = 0;                    // Number of values added
+	double runningMean = 0.0;              // Mean of the values (Welford)
+	double m2 = 0.0;                       // Sum of squared deviations from the mean
+	double smallest = std::numeric_limits<double>::infinity();
+	double largest = -std::numeric_limits<double>::infinity();
+
+	int32_t bucketOf(double magnitude) const;
+	double bucketValue(int32_t bucket) const;
+
+	template<typename Visit>
+	void forEachBucket(Visit&& visit) const;
+
+public:
+	/**
+	 * @brief Creates an empty sketch
+	 *
+	 * @param relativeAccuracy Relative error of the quantiles (default: 0.5%)
+	 * @throws std::invalid_argument If relativeAccuracy is not in (0, 1)
+	 */
+	explicit DistributionSketch(double relativeAccuracy = 0.005);
+
+	/**
+	 * @brief Adds one value (NaN and infinities are ignored)
+	 */
+	void add(double value);
+
+	/**
+	 * @brief Adds every value of another sketch
+	 *
+	 * @throws std::invalid_argument If the sketches have different accuracies
+	 */
+	void merge(const DistributionSketch& other);
+
+	/**
+	 * @brief Returns the number of values added
+	 */
+	uint64_t count() const { return total; }
+
+	/**
+	 * @brief Returns the mean of the values (0 if none)
+	 */
+	double mean() const { return runningMean; }
+
+	/**
+	 * @brief Returns the (population) standard deviation of the values (0 if none)
+	 */
+	double stdDev() const;
+
+	/**
+	 * @brief Returns the smallest value (exact, 0 if none)
+	 */
+	double min() const { return total ? smallest : 0.0; }
+
+	/**
+	 * @brief Returns the largest value (exact, 0 if none)
+	 */
+	double max() const { return total ? largest : 0.0; }
+
+	/**
+	 * @brief Returns the value below which a fraction q of the values lie
+	 *
+	 * @param q Quantile in [0, 1] (0.5 = median)
+	 * @return Estimate within the relative accuracy, clamped to [min(), max()] (0 if empty)
+	 * @throws std::invalid_argument If q is outside [0, 1]
+	 */
+	double quantile(double q) const;
+
+	/**
+	 * @brief Returns the mean of the lowest fraction alpha of the values
+	 *
+	 * The conditional value at risk of a distribution of outcomes where lower
+	 * is worse (returns, Sharpe ratios, drawdowns): the average of the worst
+	 * alpha of the paths. Within the relative accuracy, like the quantiles.
+	 *
+	 * @param alpha Fraction of the values, in (0, 1] (1 = mean of everything)
+	 * @return Mean of the lower tail (0 if empty)
+	 * @throws std::invalid_argument If alpha is outside (0, 1]
+	 */
+	double tailMean(double alpha) const;
+};
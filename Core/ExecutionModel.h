@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+
+/**
+ * @brief Parameters of the realistic fill simulation of OrderManager
+ *
+ * Without an execution model, OrderManager is the naive matcher: MARKET
+ * orders execute on submission at their own price and LIMIT orders fill in
+ * full as soon as the market touches them, free of charge. Setting a model
+ * (OrderManager::setExecutionModel()) switches to:
+ *
+ * - Latency: an order reaches the market at the first tick handled at or
+ *   after order.timestamp + latency (timestamp units: milliseconds for
+ *   recorded data, ticks for generated data whose timestamps are the tick
+ *   index). Until then a LIMIT order can be cancelled or replaced but can't
+ *   fill. A MARKET order executes on arrival at the touch of that tick (the
+ *   ask for a BUY, the bid for a SELL, the price of a trade tick).
+ * - Queue position: a LIMIT order joining the best price of its side queues
+ *   behind the volume quoted there when it arrives (QuoteTick::volume, or
+ *   Tick::volume for trade ticks); an order improving on the best price is
+ *   first in line. Replacing an order sends it to the back of the queue.
+ * - Partial fills: each tick offers its volume to the crossing orders of each
+ *   side. It first consumes the queue ahead of an order, then fills it, so an
+ *   order can fill over several ticks.
+ * - Costs: MARKET orders pay slippage on top of the touch, and every
+ *   execution pays feeRate * notional + feePerUnit * volume out of cash.
+ */
+struct ExecutionModel {
+	uint64_t latency = 0;      // Delay between submission and arrival at the market
+	double slippage = 0.0;     // Price impact of MARKET orders, as a fraction of price (0.0005 = 5 bps)
+	double feeRate = 0.0;      // Fee as a fraction of the notional of each execution
+	double feePerUnit = 0.0;   // Fee per unit of volume executed
+
+	/**
+	 * @brief Checks that the parameters make sense
+	 *
+	 * @throws std::invalid_argument If the slippage is outside [0, 1) or a fee is negative
+	 */
+	void validate() const {
+		if (!(slippage >= 0.0 && slippage < 1.0)) throw std::invalid_argument("Slippage must be in [0, 1).");
+		if (!(feeRate >= 0.0) || !(feePerUnit >= 0.0)) throw std::invalid_argument("Fees must not be negative.");
+	}
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#include "Bar.h"
+#include "Tick.h"
+
+/**
+ * @brief Average True Range with Wilder's smoothing
+ *
+ * True range of a bar = max(high - low, |high - prevClose|, |low - prevClose|).
+ * The first ATR is the simple average of the first `period` true ranges,
+ * then atr = (atr * (period - 1) + tr) / period.
+ *
+ * Meant for bars. Fed with ticks, a tick is a bar with high = low = close =
+ * price, so the true range is the absolute price change.
+ */
+class ATR {
+private:
+	size_t period_;           // Smoothing period
+	size_t count = 0;         // True ranges seen so far (capped at period)
+	double prevClose = 0.0;   // Close of the previous bar
+	bool hasPrev = false;     // True after the first bar
+	double atr = 0.0;         // Current average true range
+
+public:
+	/**
+	 * @brief Creates an ATR over the given period
+	 *
+	 * @param period Number of true ranges smoothed (must be > 0, usually 14)
+	 */
+	explicit ATR(size_t period = 14) : period_(period) {
+		if (period == 0) throw std::invalid_argument("ATR period must be greater than 0.");
+	}
+
+	/**
+	 * @brief Adds a bar given by its high, low and close
+	 */
+	void update(double high, double low, double close) {
+		// The first bar has no previous close: its range is high - low
+		double trueRange = high - low;
+		if (hasPrev) {
+			trueRange = std::max({ trueRange, std::fabs(high - prevClose), std::fabs(low - prevClose) });
+		}
+		prevClose = close;
+		hasPrev = true;
+
+		if (count < period_) {
+			count++;
+			atr += (trueRange - atr) / count;
+		} else {
+			atr = (atr * (period_ - 1) + trueRange) / period_;
+		}
+	}
+
+	void update(const Bar& bar) { update(bar.high, bar.low, bar.close); }
+	void update(const Tick& tick) { update(tick.price, tick.price, tick.price); }
+
+	/**
+	 * @brief Returns the current average true range
+	 */
+	double value() const { return atr; }
+
+	/**
+	 * @brief Returns true once `period` true ranges have been seen
+	 */
+	bool ready() const { return count >= period_; }
+
+	size_t period() const { return period_; }
+
+	void reset() {
+		count = 0;
+		hasPrev = false;
+		atr = 0.0;
+	}
+};
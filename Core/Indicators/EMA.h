@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "Bar.h"
+#include "Tick.h"
+
+/**
+ * @brief Exponential moving average
+ *
+ * ema = ema + alpha * (value - ema), with alpha = 2 / (period + 1).
+ * The average is seeded with the simple average of the first `period`
+ * values (the usual convention), and is ready from then on.
+ */
+class EMA {
+private:
+	double alpha;              // Smoothing factor
+	size_t period_;            // Number of values of the seed average
+	size_t count = 0;          // Values seen so far (capped at period)
+	double ema = 0.0;          // Current average (running mean while seeding)
+
+public:
+	/**
+	 * @brief Creates an EMA with the standard smoothing factor for the period
+	 *
+	 * @param period Number of values (must be > 0)
+	 */
+	explicit EMA(size_t period) : alpha(2.0 / (period + 1.0)), period_(period) {
+		if (period == 0) throw std::invalid_argument("EMA period must be greater than 0.");
+	}
+
+	/**
+	 * @brief Adds a value
+	 */
+	void update(double value) {
+		if (count < period_) {
+			count++;
+			ema += (value - ema) / count;  // Running simple average while seeding
+		} else {
+			ema += alpha * (value - ema);
+		}
+	}
+
+	void update(const Tick& tick) { update(tick.price); }  // Averages trade prices
+	void update(const Bar& bar) { update(bar.close); }     // Averages closes
+
+	/**
+	 * @brief Returns the current average (the seed average until ready)
+	 */
+	double value() const { return ema; }
+
+	/**
+	 * @brief Returns true once `period` values have been seen
+	 */
+	bool ready() const { return count >= period_; }
+
+	size_t period() const { return period_; }
+
+	void reset() {
+		count = 0;
+		ema = 0.0;
+	}
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "Bar.h"
+#include "Tick.h"
+
+/**
+ * @brief Relative Strength Index with Wilder's smoothing
+ *
+ * RSI = 100 - 100 / (1 + avgGain / avgLoss), where gains and losses are the
+ * positive and negative changes between consecutive values. The first
+ * averages are simple averages of the first `period` changes; after that,
+ * avg = (avg * (period - 1) + change) / period. O(1) per update, no buffer.
+ */
+class RSI {
+private:
+	size_t period_;           // Smoothing period
+	size_t changes = 0;       // Changes seen so far (capped at period)
+	double lastValue = 0.0;   // Previous value
+	bool hasLast = false;     // True after the first value
+	double avgGain = 0.0;     // Smoothed average gain
+	double avgLoss = 0.0;     // Smoothed average loss (positive)
+
+public:
+	/**
+	 * @brief Creates an RSI over the given period
+	 *
+	 * @param period Number of changes smoothed (must be > 0, usually 14)
+	 */
+	explicit RSI(size_t period = 14) : period_(period) {
+		if (period == 0) throw std::invalid_argument("RSI period must be greater than 0.");
+	}
+
+	/**
+	 * @brief Adds a value
+	 */
+	void update(double value) {
+		if (!hasLast) {
+			lastValue = value;
+			hasLast = true;
+			return;
+		}
+
+		const double change = value - lastValue;
+		lastValue = value;
+		const double gain = change > 0.0 ? change : 0.0;
+		const double loss = change < 0.0 ? -change : 0.0;
+
+		if (changes < period_) {
+			changes++;
+			avgGain += (gain - avgGain) / changes;  // Simple average of the first changes
+			avgLoss += (loss - avgLoss) / changes;
+		} else {
+			avgGain = (avgGain * (period_ - 1) + gain) / period_;
+			avgLoss = (avgLoss * (period_ - 1) + loss) / period_;
+		}
+	}
+
+	void update(const Tick& tick) { update(tick.price); }  // RSI of trade prices
+	void update(const Bar& bar) { update(bar.close); }     // RSI of closes
+
+	/**
+	 * @brief Returns the RSI in [0, 100] (50 while there is no movement at all)
+	 */
+	double value() const {
+		if (avgLoss == 0.0) return avgGain == 0.0 ? 50.0 : 100.0;
+		return 100.0 - 100.0 / (1.0 + avgGain / avgLoss);
+	}
+
+	/**
+	 * @brief Returns true once `period` changes have been seen
+	 */
+	bool ready() const { return changes >= period_; }
+
+	size_t period() const { return period_; }
+
+	void reset() {
+		changes = 0;
+		hasLast = false;
+		avgGain = 0.0;
+		avgLoss = 0.0;
+	}
+};
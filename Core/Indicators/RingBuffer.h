@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Fixed-capacity FIFO of the last N values
+ *
+ * Storage is allocated once in the constructor. Once the buffer is full,
+ * each push() overwrites the oldest value, so the buffer always holds the
+ * most recent capacity() values in contiguous memory.
+ *
+ * @tparam T Value type
+ */
+template<typename T>
+class RingBuffer {
+private:
+	std::vector<T> slots;  // Storage (size = capacity)
+	size_t head = 0;       // Slot of the oldest value
+	size_t count = 0;      // Number of values held
+
+public:
+	/**
+	 * @brief Creates an empty buffer
+	 *
+	 * @param capacity Maximum number of values held (must be > 0)
+	 */
+	explicit RingBuffer(size_t capacity) : slots(capacity) {
+		if (capacity == 0) throw std::invalid_argument("Ring buffer capacity must be greater than 0.");
+	}
+
+	/**
+	 * @brief Appends a value, dropping the oldest one if the buffer is full
+	 *
+	 * @param value The new value
+	 */
+	void push(const T& value) {
+		if (count < slots.size()) {
+			size_t slot = head + count;
+			if (slot >= slots.size()) slot -= slots.size();
+			slots[slot] = value;
+			count++;
+		} else {
+			slots[head] = value;
+			if (++head == slots.size()) head = 0;
+		}
+	}
+
+	/**
+	 * @brief Returns the i-th value, 0 being the oldest
+	 */
+	const T& operator[](size_t i) const {
+		size_t slot = head + i;
+		if (slot >= slots.size()) slot -= slots.size();
+		return slots[slot];
+	}
+
+	/**
+	 * @brief Returns the oldest value (buffer must not be empty)
+	 */
+	const T& front() const { return slots[head]; }
+
+	/**
+	 * @brief Returns the most recent value (buffer must not be empty)
+	 */
+	const T& back() const { return (*this)[count - 1]; }
+
+	size_t size() const { return count; }
+	size_t capacity() const { return slots.size(); }
+	bool empty() const { return count == 0; }
+	bool full() const { return count == slots.size(); }
+
+	/**
+	 * @brief Removes all values (storage is kept)
+	 */
+	void clear() {
+		head = 0;
+		count = 0;
+	}
+};
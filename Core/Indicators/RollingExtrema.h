@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Bar.h"
+#include "Tick.h"
+#include "RollingExtremum.h"
+
+/**
+ * @brief Highest value of the last N updates (highs for bars, prices for ticks)
+ *
+ * Indicator-style wrapper of RollingMax: amortized O(1) per update whatever N is.
+ */
+class RollingHigh {
+private:
+	RollingMax extremum;
+
+public:
+	/**
+	 * @param period Number of updates covered (must be > 0)
+	 */
+	explicit RollingHigh(size_t period) : extremum(period) {}
+
+	void update(double value) { extremum.push(value); }
+	void update(const Tick& tick) { extremum.push(tick.price); }
+	void update(const Bar& bar) { extremum.push(bar.high); }
+
+	double value() const { return extremum.value(); }
+	bool ready() const { return extremum.full(); }
+	void reset() { extremum.clear(); }
+};
+
+/**
+ * @brief Lowest value of the last N updates (lows for bars, prices for ticks)
+ *
+ * Indicator-style wrapper of RollingMin: amortized O(1) per update whatever N is.
+ */
+class RollingLow {
+private:
+	RollingMin extremum;
+
+public:
+	/**
+	 * @param period Number of updates covered (must be > 0)
+	 */
+	explicit RollingLow(size_t period) : extremum(period) {}
+
+	void update(double value) { extremum.push(value); }
+	void update(const Tick& tick) { extremum.push(tick.price); }
+	void update(const Bar& bar) { extremum.push(bar.low); }
+
+	double value() const { return extremum.value(); }
+	bool ready() const { return extremum.full(); }
+	void reset() { extremum.clear(); }
+};
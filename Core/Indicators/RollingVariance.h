@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "Bar.h"
+#include "Tick.h"
+#include "RingBuffer.h"
+
+/**
+ * @brief Mean, variance and standard deviation over the last N values
+ *
+ * Sliding-window version of Welford's algorithm: the mean and the sum of
+ * squared deviations (M2) are updated from the value entering and the value
+ * leaving the window, which is numerically far better than keeping sum and
+ * sum of squares (no catastrophic cancellation on prices around 100 with tiny
+ * variance). M2 is recomputed from the window every N updates so errors don't
+ * accumulate.
+ */
+class RollingVariance {
+private:
+	RingBuffer<double> window;  // Last N values
+	double mean_ = 0.0;         // Mean of the window
+	double m2 = 0.0;            // Sum of squared deviations from the mean
+	size_t sinceRecompute = 0;  // Updates since mean/M2 were recomputed
+
+	void recompute() {
+		const size_t n = window.size();
+		double sum = 0.0;
+		for (size_t i = 0; i < n; i++) sum += window[i];
+		mean_ = sum / n;
+		m2 = 0.0;
+		for (size_t i = 0; i < n; i++) m2 += (window[i] - mean_) * (window[i] - mean_);
+	}
+
+public:
+	/**
+	 * @brief Creates a rolling variance over the given number of values
+	 *
+	 * @param period Number of values covered (must be > 0)
+	 */
+	explicit RollingVariance(size_t period) : window(period) {}
+
+	/**
+	 * @brief Adds a value to the window
+	 */
+	void update(double value) {
+		if (!window.full()) {
+			// Growing window: plain Welford step
+			window.push(value);
+			const double delta = value - mean_;
+			mean_ += delta / window.size();
+			m2 += delta * (value - mean_);
+		} else {
+			// Sliding window: replace the oldest value
+			const double old = window.front();
+			window.push(value);
+			const double oldMean = mean_;
+			mean_ += (value - old) / window.size();
+			m2 += (value - old) * (value - mean_ + old - oldMean);
+			m2 = std::max(m2, 0.0);
+		}
+
+		if (++sinceRecompute == window.capacity()) {
+			recompute();
+			sinceRecompute = 0;
+		}
+	}
+
+	void update(const Tick& tick) { update(tick.price); }  // Variance of trade prices
+	void update(const Bar& bar) { update(bar.close); }     // Variance of closes
+
+	/**
+	 * @brief Returns the mean of the window
+	 */
+	double mean() const { return mean_; }
+
+	/**
+	 * @brief Returns the population variance of the window (0 if empty)
+	 */
+	double variance() const { return window.empty() ? 0.0 : m2 / window.size(); }
+
+	/**
+	 * @brief Returns the sample variance of the window (0 with fewer than 2 values)
+	 */
+	double sampleVariance() const { return window.size() < 2 ? 0.0 : m2 / (window.size() - 1); }
+
+	/**
+	 * @brief Returns the population standard deviation of the window
+	 */
+	double stddev() const { return std::sqrt(variance()); }
+
+	/**
+	 * @brief Same as variance()
+	 */
+	double value() const { return variance(); }
+
+	/**
+	 * @brief Returns true once the window holds N values
+	 */
+	bool ready() const { return window.full(); }
+
+	size_t period() const { return window.capacity(); }
+
+	void reset() {
+		window.clear();
+		mean_ = 0.0;
+		m2 = 0.0;
+		sinceRecompute = 0;
+	}
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Bar.h"
+#include "Tick.h"
+#include "RingBuffer.h"
+
+/**
+ * @brief Simple moving average over the last N values
+ *
+ * Keeps a running sum: each update adds the new value and subtracts the one
+ * leaving the window, so the cost per update doesn't depend on N. To keep
+ * rounding errors from accumulating over millions of updates, the sum is
+ * recomputed from the window every N updates (amortized O(1)).
+ */
+class SMA {
+private:
+	RingBuffer<double> window;  // Last N values
+	double sum = 0.0;           // Sum of the values in the window
+	size_t sinceResum = 0;      // Updates since the sum was last recomputed
+
+public:
+	/**
+	 * @brief Creates an average over the given number of values
+	 *
+	 * @param period Number of values averaged (must be > 0)
+	 */
+	explicit SMA(size_t period) : window(period) {}
+
+	/**
+	 * @brief Adds a value to the window
+	 */
+	void update(double value) {
+		if (window.full()) sum -= window.front();
+		window.push(value);
+		sum += value;
+
+		if (++sinceResum == window.capacity()) {
+			sum = 0.0;
+			for (size_t i = 0; i < window.size(); i++) sum += window[i];
+			sinceResum = 0;
+		}
+	}
+
+	void update(const Tick& tick) { update(tick.price); }  // Averages trade prices
+	void update(const Bar& bar) { update(bar.close); }     // Averages closes
+
+	/**
+	 * @brief Returns the average of the values in the window (0 before the first update)
+	 */
+	double value() const { return window.empty() ? 0.0 : sum / window.size(); }
+
+	/**
+	 * @brief Returns true once the window holds N values
+	 */
+	bool ready() const { return window.full(); }
+
+	size_t period() const { return window.capacity(); }
+
+	void reset() {
+		window.clear();
+		sum = 0.0;
+		sinceResum = 0;
+	}
+};
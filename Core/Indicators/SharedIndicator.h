@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "RingBuffer.h"
+
+/**
+ * @brief One indicator instance read by several strategies fed the same data
+ *
+ * The engine runs strategies block by block, and a worker runs a whole block
+ * of one strategy before the next, so two strategies reading one indicator are
+ * never at the same tick: a plain shared instance would give the later
+ * strategy values computed from ticks it hasn't seen yet. SharedIndicator
+ * counts updates instead. Each strategy holds a Reader; the first reader to
+ * reach update n feeds the input to the indicator, and the readers behind it
+ * get the value of update n from a history ring. Since every reader sees the
+ * same sequence of inputs, they all read exactly what a private instance
+ * would have given them.
+ *
+ * The history must cover the largest lag between readers: with the engine's
+ * block processing, that is about two blocks of updates (use at least
+ * 2 * engine block size for per-tick indicators, far less for bar indicators).
+ * A reader further behind throws std::runtime_error.
+ *
+ * Updates take a mutex (readers can be on different worker threads). For the
+ * O(1) indicators of this module that costs about as much as the update
+ * itself, so sharing pays off for indicators that are expensive to update or
+ * hold large windows, or when a single consistent instance is wanted.
+ *
+ * @tparam IndicatorT Indicator type (update(), value(), ready(), reset())
+ */
+template<typename IndicatorT>
+class SharedIndicator {
+private:
+	struct Entry {
+		double value;
+		bool ready;
+	};
+
+	IndicatorT indicator;        // The shared instance
+	RingBuffer<Entry> history;   // Value after each of the last updates
+	uint64_t computed = 0;       // Number of updates applied to the indicator
+	std::mutex mutex;
+
+	/**
+	 * @brief Returns the value after update `sequence`, applying the update if it's the next one
+	 */
+	template<typename InputT>
+	Entry advance(uint64_t sequence, const InputT& input) {
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (sequence == computed) {
+			indicator.update(input);
+			history.push(Entry{ indicator.value(), indicator.ready() });
+			computed++;
+			return history.back();
+		}
+
+		if (sequence > computed) throw std::runtime_error("Shared indicator reader skipped updates.");
+		const uint64_t lag = computed - sequence;
+		if (lag > history.size()) throw std::runtime_error("Shared indicator reader fell behind the history capacity.");
+		return history[history.size() - lag];
+	}
+
+public:
+	/**
+	 * @brief Per-strategy view of a shared indicator
+	 *
+	 * Same update()/value()/ready() interface as the indicator itself, so a
+	 * strategy can use a Reader where it would use a private instance.
+	 */
+	class Reader {
+	private:
+		std::shared_ptr<SharedIndicator> shared;
+		uint64_t sequence = 0;   // Updates done by this reader
+		Entry current{ 0.0, false };
+
+	public:
+		explicit Reader(std::shared_ptr<SharedIndicator> shared) : shared(std::move(shared)) {}
+
+		/**
+		 * @brief Feeds the next input (ignored if another reader already fed it)
+		 *
+		 * @throws std::runtime_error If this reader lags beyond the history capacity
+		 */
+		template<typename InputT>
+		void update(const InputT& input) {
+			current = shared->advance(sequence, input);
+			sequence++;
+		}
+
+		double value() const { return current.value; }
+		bool ready() const { return current.ready; }
+		uint64_t updates() const { return sequence; }
+	};
+
+	/**
+	 * @brief Creates a shared indicator
+	 *
+	 * @param historyCapacity Largest lag (in updates) allowed between readers (must be > 0)
+	 * @param indicator The indicator to share
+	 */
+	SharedIndicator(size_t historyCapacity, IndicatorT indicator)
+		: indicator(std::move(indicator)), history(historyCapacity) {}
+
+	/**
+	 * @brief Creates a shared indicator and a first reader
+	 *
+	 * @param historyCapacity Largest lag (in updates) allowed between readers
+	 * @param args Indicator constructor arguments
+	 */
+	template<typename... Args>
+	static std::shared_ptr<SharedIndicator> create(size_t historyCapacity, Args&&... args) {
+		return std::make_shared<SharedIndicator>(historyCapacity, IndicatorT(std::forward<Args>(args)...));
+	}
+
+	/**
+	 * @brief Creates a reader starting at the first update
+	 *
+	 * Call before the run; a reader created later still starts at update 0.
+	 */
+	static Reader reader(const std::shared_ptr<SharedIndicator>& shared) { return Reader(shared); }
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include "Bar.h"
+#include "Tick.h"
+#include "RingBuffer.h"
+
+/**
+ * @brief Volume-weighted average price, cumulative or over the last N updates
+ *
+ * VWAP = sum(price * volume) / sum(volume). With period 0 the average covers
+ * everything since the last reset() (e.g. a session VWAP, reset at the open);
+ * with a period, it covers the last `period` updates and the two sums are
+ * maintained incrementally from a ring buffer. Bars contribute their typical
+ * price (high + low + close) / 3 with their volume.
+ */
+class VWAP {
+private:
+	struct Entry {
+		double notional;  // price * volume
+		double volume;
+	};
+
+	std::optional<RingBuffer<Entry>> window;  // Last N entries (empty = cumulative)
+	double notionalSum = 0.0;                 // Sum of price * volume
+	double volumeSum = 0.0;                   // Sum of volume
+	size_t count = 0;                         // Updates since reset
+
+public:
+	/**
+	 * @brief Creates a VWAP
+	 *
+	 * @param period Number of updates covered, 0 for a cumulative VWAP (default)
+	 */
+	explicit VWAP(size_t period = 0) {
+		if (period > 0) window.emplace(period);
+	}
+
+	/**
+	 * @brief Adds a trade
+	 */
+	void update(double price, double volume) {
+		const Entry entry{ price * volume, volume };
+		if (window) {
+			if (window->full()) {
+				notionalSum -= window->front().notional;
+				volumeSum -= window->front().volume;
+			}
+			window->push(entry);
+		}
+		notionalSum += entry.notional;
+		volumeSum += entry.volume;
+		count++;
+	}
+
+	void update(const Tick& tick) { update(tick.price, tick.volume); }
+	void update(const Bar& bar) { update((bar.high + bar.low + bar.close) / 3.0, bar.volume); }
+
+	/**
+	 * @brief Returns the VWAP (0 while no volume has been traded)
+	 */
+	double value() const { return volumeSum > 0.0 ? notionalSum / volumeSum : 0.0; }
+
+	/**
+	 * @brief Cumulative: true after the first update. Windowed: true once the window is full.
+	 */
+	bool ready() const { return window ? window->full() : count > 0; }
+
+	void reset() {
+		if (window) window->clear();
+		notionalSum = 0.0;
+		volumeSum = 0.0;
+		count = 0;
+	}
+};
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "MonteCarlo.h"
+#include "StrategyContext.h"
+#include "RunArena.h"
+
+MonteCarlo::MonteCarlo(const BatchGBMGenerator& generator) : generator(generator) {
+}
+
+/**
+ * @brief Sets the number of worker threads
+ */
+void MonteCarlo::setThreadCount(size_t count) {
+	threadCount = count;
+}
+
+/**
+ * @brief Feeds a whole path to a context, one generated block at a time
+ */
+template<typename TickT>
+void MonteCarlo::runPath(StrategyContext& context, TickSource<TickT>& source, std::vector<TickT>& buffer) const {
+	buffer.resize(blockSize);
+	for (size_t count; (count = source.read(buffer)) != 0; ) {
+		context.process(std::span<const TickT>(buffer.data(), count));
+	}
+}
+
+/**
+ * @brief Runs the paths on a pool of workers, each folding its statistics into its own sketches
+ *
+ * Every path is the same amount of work, so workers simply take the next
+ * index from a shared counter. Each path runs in a fresh context allocated
+ * from the worker's RunArena, reset after the path. The per-worker sketches
+ * are merged once all workers have stopped. If a path throws, the remaining
+ * ones are abandoned and the first exception is rethrown.
+ */
+std::map<std::string, DistributionSketch> MonteCarlo::run(uint64_t firstPath, size_t nPaths, const StrategyBuilder& builder, TimeFrame tf, double initialCash) const {
+	std::map<std::string, DistributionSketch> merged;
+	if (nPaths == 0) return merged;
+
+	const size_t workerCount = std::min(threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency()), nPaths);
+	std::vector<std::map<std::string, DistributionSketch>> sketches(workerCount);
+
+	std::atomic<size_t> next{ 0 };
+	std::atomic<bool> failed{ false };
+	std::exception_ptr firstError;
+	std::mutex errorMutex;
+
+	auto worker = [&](size_t self) {
+		RunArena arena;
+		std::vector<Tick> tickBuffer;
+		std::vector<QuoteTick> quoteBuffer;
+
+		while (!failed.load(std::memory_order_relaxed)) {
+			const size_t offset = next.fetch_add(1, std::memory_order_relaxed);
+			if (offset >= nPaths) return;
+
+			try {
+				StatsMap stats;
+				{
+					StrategyContext context("monte_carlo", builder(), tf, initialCash, arena.resource());
+					context.statistics.setStoreSeries(false);
+					context.setup();
+					context.strategy->onStart();
+
+					if (context.quoteStrategy) {
+						runPath(context, *generator.streamQuotes(firstPath + offset), quoteBuffer);
+					} else {
+						runPath(context, *generator.streamTicks(firstPath + offset), tickBuffer);
+					}
+					stats = context.finish();
+				}
+				for (const auto& [metric, value] : stats) sketches[self][metric].add(value);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if (!firstError) firstError = std::current_exception();
+				failed.store(true, std::memory_order_relaxed);
+			}
+			arena.reset();
+		}
+	};
+
+	std::vector<std::thread> workers;
+	workers.reserve(workerCount - 1);
+	for (size_t w = 1; w < workerCount; w++) workers.emplace_back(worker, w);
+	worker(0);
+	for (auto& thread : workers) thread.join();
+
+	if (firstError) std::rethrow_exception(firstError);
+
+	for (const auto& workerSketches : sketches) {
+		for (const auto& [metric, sketch] : workerSketches) merged[metric].merge(sketch);
+	}
+	return merged;
+}
+
+std::vector<MonteCarloReport> summarizeMonteCarlo(const std::map<std::string, DistributionSketch>& sketches, double cvarLevel) {
+	if (!(cvarLevel > 0.0 && cvarLevel <= 1.0)) throw std::invalid_argument("CVaR level must be in (0, 1].");
+
+	std::vector<MonteCarloReport> reports;
+	reports.reserve(sketches.size());
+	for (const auto& [metric, sketch] : sketches) {
+		reports.push_back(MonteCarloReport{ metric, sketch.count(), sketch.mean(), sketch.stdDev(), sketch.min(),
+			sketch.quantile(0.01), sketch.quantile(0.05), sketch.quantile(0.25), sketch.quantile(0.5),
+			sketch.quantile(0.75), sketch.quantile(0.95), sketch.quantile(0.99), sketch.max(),
+			sketch.tailMean(cvarLevel) });
+	}
+	return reports;
+}
+
+void exportMonteCarloToCSV(const std::string& filename, std::span<const MonteCarloReport> reports) {
+	std::ofstream file(filename);
+	if (!file.is_open()) throw std::runtime_error("Cannot open Monte Carlo file '" + filename + "'");
+
+	file << "Metric,Paths,Mean,StdDev,Min,P1,P5,P25,P50,P75,P95,P99,Max,CVaR\n";
+	for (const MonteCarloReport& report : reports) {
+		file << report.metric << "," << report.paths << "," << report.mean << "," << report.stdDev << ","
+			<< report.min << "," << report.p01 << "," << report.p05 << "," << report.p25 << ","
+			<< report.p50 << "," << report.p75 << "," << report.p95 << "," << report.p99 << ","
+			<< report.max << "," << report.cvar << "\n";
+	}
+	if (!file) throw std::runtime_error("Cannot write Monte Carlo file '" + filename + "'");
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "BatchGBMGenerator.h"
+#include "DistributionSketch.h"
+#include "TimeFrame.h"
+#include "WalkForward.h"
+
+struct StrategyContext;
+
+/**
+ * @brief Distribution of one statistic over the paths of a Monte Carlo run
+ */
+struct MonteCarloReport {
+	std::string metric;  // Statistic name (see registerUserStats())
+	uint64_t paths;      // Number of paths it was computed on
+	double mean;
+	double stdDev;
+	double min;
+	double p01;
+	double p05;
+	double p25;
+	double p50;
+	double p75;
+	double p95;
+	double p99;
+	double max;
+	double cvar;         // Mean of the lowest cvarLevel of the values (worst paths when lower is worse)
+};
+
+/**
+ * @brief Monte Carlo robustness runner: one strategy over many simulated paths
+ *
+ * Each path of a BatchGBMGenerator (a pure function of the seed and the path
+ * index) is generated block by block while the strategy consumes it, so
+ * nothing is materialized: a worker holds one block of ticks, one run arena
+ * and its distribution sketches, whatever the number or length of the paths.
+ * Strategies derived from QuoteStrategy get the quotes of the path, the
+ * others its trades.
+ *
+ * The statistics of every path (registerUserStats()) are folded into one
+ * DistributionSketch per statistic, so memory stays the same for a thousand
+ * or a million paths. Workers take the next path index from a shared counter
+ * and merge their sketches once they are done; quantiles and CVaR are the
+ * same for any number of threads.
+ */
+class MonteCarlo {
+private:
+	BatchGBMGenerator generator;          // Paths to run on
+	size_t threadCount = 0;               // Number of workers (0 = one per hardware thread)
+	size_t blockSize = 4096;              // Ticks generated at a time
+
+	template<typename TickT>
+	void runPath(StrategyContext& context, TickSource<TickT>& source, std::vector<TickT>& buffer) const;
+
+public:
+	/**
+	 * @brief Creates a runner over the paths of a generator
+	 *
+	 * @param generator Model, path length and seed of the paths
+	 */
+	explicit MonteCarlo(const BatchGBMGenerator& generator);
+
+	/**
+	 * @brief Sets how many worker threads run() uses
+	 *
+	 * @param count Number of workers (0 = std::thread::hardware_concurrency())
+	 */
+	void setThreadCount(size_t count);
+
+	/**
+	 * @brief Runs the strategy on paths [firstPath, firstPath + nPaths)
+	 *
+	 * @param firstPath Index of the first path
+	 * @param nPaths Number of paths
+	 * @param builder Builds the strategy, once per path (see StrategyBuilder)
+	 * @param tf Time frame used for the statistics
+	 * @param initialCash Starting capital on every path
+	 * @return One sketch per statistic, by name
+	 * @throws Any exception thrown by the builder or a strategy (the first one is rethrown)
+	 */
+	std::map<std::string, DistributionSketch> run(uint64_t firstPath, size_t nPaths, const StrategyBuilder& builder, TimeFrame tf, double initialCash) const;
+};
+
+/**
+ * @brief Summarizes the sketches of a Monte Carlo run
+ *
+ * @param sketches Result of MonteCarlo::run()
+ * @param cvarLevel Fraction of the paths averaged by the CVaR (default: 5%)
+ * @return One report per statistic, ordered by name
+ * @throws std::invalid_argument If cvarLevel is outside (0, 1]
+ */
+std::vector<MonteCarloReport> summarizeMonteCarlo(const std::map<std::string, DistributionSketch>& sketches, double cvarLevel = 0.05);
+
+/**
+ * @brief Writes Monte Carlo reports as CSV (one row per statistic)
+ *
+ * @param filename Output CSV file path
+ * @param reports Reports to write
+ * @throws std::runtime_error If the file can't be written
+ */
+void exportMonteCarloToCSV(const std::string& filename, std::span<const MonteCarloReport> reports);
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Tick.h"
+
+/**
+ * @brief Types of orders that can be placed
+ * 
+ * MARKET: Execute immediately at the current market price
+ * LIMIT: Execute only when price reaches the specified limit price
+ */
+enum class OrderType { MARKET, LIMIT };
+
+/**
+ * @brief Identifier handed out by OrderManager::submit() for each LIMIT order
+ * 
+ * IDs stay valid while the order rests in the book and can be used to cancel
+ * or replace it. 0 is never a valid ID (MARKET orders, which execute
+ * immediately, get 0).
+ */
+using OrderId = uint64_t;
+
+/**
+ * @brief Represents a trading order (buy or sell request)
+ * 
+ * An order is a request to buy or sell a certain volume at a certain price.
+ * Orders can be market orders (execute immediately) or limit orders
+ * (execute only when price conditions are met).
+ */
+struct Order {
+	enum class Side { BUY, SELL };  // Whether this is a buy or sell order
+	Side side;                      // The side of this order
+	OrderType type;                 // MARKET (immediate) or LIMIT (conditional)
+	uint64_t timestamp;             // When this order was created
+	double volume;                  // Number of shares/contracts to trade
+	double price;                   // Price for LIMIT orders, or execution price for MARKET orders
+	OrderId id = 0;                 // Assigned by OrderManager::submit() (0 = not resting in a book)
+	SymbolId symbol = 0;            // Instrument to trade (matched against ticks of the same symbol)
+};
+
+/**
+ * @brief One execution of an order, as recorded by OrderManager
+ * 
+ * A LIMIT order filled by a tick is timestamped with that tick, a MARKET
+ * order with its own timestamp (it executes on submission) - or, with an
+ * ExecutionModel, with the tick on which it reached the market. A partially
+ * filled order has one Fill per execution.
+ */
+struct Fill {
+	uint64_t timestamp;             // When the order executed
+	OrderId orderId;                // ID of the LIMIT order (0 for MARKET orders)
+	double price;                   // Execution price
+	double volume;                  // Executed volume
+	Order::Side side;               // BUY or SELL
+	SymbolId symbol;                // Instrument traded
+	double fee = 0.0;               // Fees paid on the execution (ExecutionModel only)
+};
@@ -0,0 +1,306 @@
+#include "OrderBook.h"
+
+/**
+ * @brief Decodes an order ID into its slot, rejecting stale or unknown IDs
+ *
+ * ID layout: high 32 bits = slot generation, low 32 bits = slot number + 1
+ * (so that 0 is never a valid ID).
+ */
+OrderBook::Slot* OrderBook::find(OrderId id) {
+	uint32_t slotIndex = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+	if (slotIndex == 0 || slotIndex > slots.size()) return nullptr;
+
+	Slot& slot = slots[slotIndex - 1];
+	if (!slot.live || slot.order.id != id) return nullptr;  // Slot was released (and maybe reused) since
+	return &slot;
+}
+
+const OrderBook::Slot* OrderBook::find(OrderId id) const {
+	return const_cast<OrderBook*>(this)->find(id);
+}
+
+/**
+ * @brief Heap ordering: better price first, then earlier arrival
+ */
+bool OrderBook::better(Order::Side side, uint32_t a, uint32_t b) const {
+	const Slot& sa = slots[a];
+	const Slot& sb = slots[b];
+	if (sa.order.price != sb.order.price) {
+		return side == Order::Side::BUY ? sa.order.price > sb.order.price : sa.order.price < sb.order.price;
+	}
+	return sa.sequence < sb.sequence;
+}
+
+/**
+ * @brief Moves the entry at pos towards the top of the heap until its parent is better
+ */
+void OrderBook::siftUp(Heap& heap, Order::Side side, uint32_t pos) {
+	uint32_t slotIndex = heap[pos];
+
+	while (pos > 0) {
+		uint32_t parent = (pos - 1) / 2;
+		if (!better(side, slotIndex, heap[parent])) break;
+		heap[pos] = heap[parent];
+		slots[heap[pos]].heapIndex = pos;
+		pos = parent;
+	}
+
+	heap[pos] = slotIndex;
+	slots[slotIndex].heapIndex = pos;
+}
+
+/**
+ * @brief Moves the entry at pos towards the bottom of the heap until both children are worse
+ */
+void OrderBook::siftDown(Heap& heap, Order::Side side, uint32_t pos) {
+	uint32_t slotIndex = heap[pos];
+	uint32_t count = static_cast<uint32_t>(heap.size());
+
+	while (true) {
+		uint32_t child = 2 * pos + 1;
+		if (child >= count) break;
+		if (child + 1 < count && better(side, heap[child + 1], heap[child])) child++;
+		if (!better(side, heap[child], slotIndex)) break;
+		heap[pos] = heap[child];
+		slots[heap[pos]].heapIndex = pos;
+		pos = child;
+	}
+
+	heap[pos] = slotIndex;
+	slots[slotIndex].heapIndex = pos;
+}
+
+/**
+ * @brief Takes a slot out of its symbol's and side's heap (the slot itself stays allocated)
+ *
+ * The last heap entry is moved into the hole and then sifted up or down,
+ * whichever restores the heap order.
+ */
+void OrderBook::removeFromHeap(uint32_t slotIndex) {
+	Order::Side side = slots[slotIndex].order.side;
+	Heap& heap = heapOf(slotIndex);
+	uint32_t pos = slots[slotIndex].heapIndex;
+	uint32_t last = heap.back();
+	heap.pop_back();
+
+	if (last == slotIndex) return;  // Removed the last entry, nothing to fix up
+
+	heap[pos] = last;
+	slots[last].heapIndex = pos;
+	if (pos > 0 && better(side, last, heap[(pos - 1) / 2])) {
+		siftUp(heap, side, pos);
+	} else {
+		siftDown(heap, side, pos);
+	}
+}
+
+/**
+ * @brief Takes a slot out of the parked list (swap with the last entry and pop)
+ */
+void OrderBook::removeFromParked(uint32_t slotIndex) {
+	const uint32_t pos = slots[slotIndex].heapIndex;
+	const uint32_t last = parked.back();
+	parked[pos] = last;
+	slots[last].heapIndex = pos;
+	parked.pop_back();
+	slots[slotIndex].parked = false;
+}
+
+/**
+ * @brief Returns a slot to the free list and invalidates IDs pointing at it
+ */
+void OrderBook::releaseSlot(uint32_t slotIndex) {
+	Slot& slot = slots[slotIndex];
+	slot.live = false;
+	slot.generation++;
+	resting--;
+	slot.nextFree = freeHead;
+	freeHead = slotIndex;
+}
+
+/**
+ * @brief Pre-allocates the slab and the heaps of every symbol
+ */
+void OrderBook::reserve(size_t capacity, size_t symbols) {
+	slots.reserve(capacity);
+	if (heaps.size() < symbols) heaps.resize(symbols);
+	for (SymbolHeaps& symbolHeaps : heaps) {
+		symbolHeaps.bids.reserve(capacity);
+		symbolHeaps.asks.reserve(capacity);
+	}
+}
+
+/**
+ * @brief Stores the order in a free slot and assigns its ID
+ *
+ * A slot is taken from the free list when one is available, so in steady state
+ * (orders being filled or cancelled as fast as new ones arrive) nothing is allocated.
+ * The first order on a new symbol creates that symbol's heaps.
+ */
+uint32_t OrderBook::allocate(const Order& order) {
+	if (order.symbol >= heaps.size()) heaps.resize(size_t(order.symbol) + 1);
+
+	uint32_t slotIndex;
+	if (freeHead != NO_SLOT) {
+		// Reuse a released slot
+		slotIndex = freeHead;
+		freeHead = slots[slotIndex].nextFree;
+	} else {
+		// No free slot - grow the slab
+		slotIndex = static_cast<uint32_t>(slots.size());
+		slots.emplace_back();
+	}
+
+	Slot& slot = slots[slotIndex];
+	slot.order = order;
+	slot.order.id = (static_cast<OrderId>(slot.generation) << 32) | (static_cast<OrderId>(slotIndex) + 1);
+	slot.sequence = nextSequence++;
+	slot.queueAhead = 0.0;
+	slot.live = true;
+	resting++;
+	return slotIndex;
+}
+
+/**
+ * @brief Stores the order and pushes it onto its symbol's and side's heap
+ */
+OrderId OrderBook::add(const Order& order) {
+	const uint32_t slotIndex = allocate(order);
+
+	Heap& heap = heapFor(order.symbol, order.side);
+	heap.push_back(slotIndex);
+	siftUp(heap, order.side, static_cast<uint32_t>(heap.size() - 1));
+
+	return slots[slotIndex].order.id;
+}
+
+/**
+ * @brief Stores the order on the parked list instead of a heap
+ */
+OrderId OrderBook::park(const Order& order) {
+	const uint32_t slotIndex = allocate(order);
+
+	Slot& slot = slots[slotIndex];
+	slot.parked = true;
+	slot.heapIndex = static_cast<uint32_t>(parked.size());
+	parked.push_back(slotIndex);
+
+	return slot.order.id;
+}
+
+/**
+ * @brief Moves a parked order onto its heap with a fresh arrival sequence number
+ */
+bool OrderBook::activate(OrderId id, double queueAhead) {
+	Slot* slot = find(id);
+	if (!slot || !slot->parked) return false;
+
+	const uint32_t slotIndex = static_cast<uint32_t>(slot - slots.data());
+	removeFromParked(slotIndex);
+	slot->sequence = nextSequence++;  // Time priority starts when the order reaches the market
+	slot->queueAhead = queueAhead;
+
+	Heap& heap = heapOf(slotIndex);
+	heap.push_back(slotIndex);
+	siftUp(heap, slot->order.side, static_cast<uint32_t>(heap.size() - 1));
+	return true;
+}
+
+/**
+ * @brief Removes a resting order by ID
+ */
+bool OrderBook::cancel(OrderId id) {
+	Slot* slot = find(id);
+	if (!slot) return false;
+
+	uint32_t slotIndex = static_cast<uint32_t>(slot - slots.data());
+	if (slot->parked) removeFromParked(slotIndex);
+	else removeFromHeap(slotIndex);
+	releaseSlot(slotIndex);
+	return true;
+}
+
+/**
+ * @brief Updates price and volume in place and re-positions the order in its heap
+ *
+ * The order gets a new arrival sequence number, so it queues behind the orders
+ * already resting at its new price. A parked order is only updated.
+ */
+bool OrderBook::replace(OrderId id, double newPrice, double newVolume, double queueAhead) {
+	Slot* slot = find(id);
+	if (!slot) return false;
+
+	slot->order.price = newPrice;
+	slot->order.volume = newVolume;
+	if (slot->parked) return true;
+
+	uint32_t slotIndex = static_cast<uint32_t>(slot - slots.data());
+	Order::Side side = slot->order.side;
+	Heap& heap = heapOf(slotIndex);
+	slot->sequence = nextSequence++;
+	slot->queueAhead = queueAhead;
+
+	// The new key can move the order either way, so try both directions
+	siftUp(heap, side, slot->heapIndex);
+	siftDown(heap, side, slots[slotIndex].heapIndex);
+	return true;
+}
+
+/**
+ * @brief Releases every order on one side, symbol after symbol
+ */
+size_t OrderBook::cancelAll(Order::Side side) {
+	size_t count = 0;
+	for (size_t symbol = 0; symbol < heaps.size(); symbol++) {
+		count += cancelAll(static_cast<SymbolId>(symbol), side);
+	}
+	return count;
+}
+
+/**
+ * @brief Releases every order of one symbol on one side and empties that heap
+ *
+ * Parked orders of that symbol and side are released too.
+ */
+size_t OrderBook::cancelAll(SymbolId symbol, Order::Side side) {
+	if (symbol >= heaps.size()) return 0;
+
+	Heap& heap = heapFor(symbol, side);
+	size_t count = heap.size();
+
+	for (uint32_t slotIndex : heap) releaseSlot(slotIndex);
+	heap.clear();  // Keeps capacity, so the next quotes don't allocate
+
+	for (size_t i = parked.size(); i-- > 0;) {
+		const uint32_t slotIndex = parked[i];
+		if (slots[slotIndex].order.symbol == symbol && slots[slotIndex].order.side == side) {
+			removeFromParked(slotIndex);
+			releaseSlot(slotIndex);
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * @brief Returns the resting order with this ID, or nullptr
+ */
+const Order* OrderBook::get(OrderId id) const {
+	const Slot* slot = find(id);
+	return slot ? &slot->order : nullptr;
+}
+
+/**
+ * @brief Returns the number of resting orders on both sides
+ */
+size_t OrderBook::size() const {
+	return resting;
+}
+
+/**
+ * @brief Returns true if there are no resting orders
+ */
+bool OrderBook::empty() const {
+	return resting == 0;
+}
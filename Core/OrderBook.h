@@ -0,0 +1,306 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "Order.h"
+
+/**
+ * @brief Price-sorted book of resting LIMIT orders backed by a slab order store
+ *
+ * Bids (BUY orders) are ordered from the highest price to the lowest,
+ * asks (SELL orders) from the lowest price to the highest. Orders at the same
+ * price keep their arrival order (time priority).
+ *
+ * Storage:
+ * - Every resting order lives in a slot of a slab (a vector of slots plus a free list).
+ *   Cancelled and filled orders return their slot to the free list, so once the
+ *   book has reached its largest size, adding, cancelling and replacing orders
+ *   never allocates.
+ * - Each side is an indexed binary heap of slot numbers with the best order on top.
+ *   The slot remembers its position in the heap, so an order can be removed by ID
+ *   in O(log n) without searching.
+ *
+ * Order IDs encode the slot number and a generation counter that is bumped each
+ * time the slot is reused, so a stale ID (of an order that already filled or was
+ * cancelled) is detected and rejected instead of hitting the slot's new order.
+ *
+ * Matching only has to look at the top of each heap: as soon as the best order
+ * does not cross the market, none of the others can. Matching a tick therefore
+ * costs O(filled orders * log(book size)) and orders that don't execute are
+ * never touched or copied.
+ *
+ * Orders of different symbols share the slab (so IDs are unique across
+ * symbols) but each symbol has its own pair of heaps, indexed by SymbolId:
+ * a tick only ever looks at the heaps of its own symbol.
+ *
+ * For latency simulation, an order can also be parked: it gets its ID and
+ * slot (so it can be cancelled or replaced) but stays out of the heaps until
+ * it is activated. matchVolume() is the matcher of the execution model, with
+ * queue positions and partial fills.
+ *
+ * All storage comes from the memory resource given at construction (the
+ * default heap unless the book belongs to a run arena, see RunArena).
+ */
+class OrderBook {
+private:
+	/**
+	 * @brief One entry of the slab order store
+	 */
+	struct Slot {
+		Order order;                 // The resting order (order.id is the public ID)
+		uint64_t sequence = 0;       // Arrival sequence number, used for time priority
+		uint32_t generation = 0;     // Bumped every time the slot is released
+		uint32_t heapIndex = 0;      // Position of this slot in its side's heap (in parked if parked)
+		uint32_t nextFree = 0;       // Next free slot (only meaningful while the slot is free)
+		double queueAhead = 0.0;     // Volume queued before the order at its price (matchVolume() only)
+		bool live = false;           // True while the slot holds a resting order
+		bool parked = false;         // True while the order waits for activate()
+	};
+
+	using Heap = std::pmr::vector<uint32_t>;
+
+	/**
+	 * @brief Both sides of the book of one symbol
+	 *
+	 * Allocator-aware, so the heaps of every symbol share the book's memory resource.
+	 */
+	struct SymbolHeaps {
+		using allocator_type = std::pmr::polymorphic_allocator<>;
+
+		Heap bids;   // Slot numbers of BUY orders, best (highest) price on top
+		Heap asks;   // Slot numbers of SELL orders, best (lowest) price on top
+
+		explicit SymbolHeaps(const allocator_type& allocator = {}) : bids(allocator), asks(allocator) {}
+		SymbolHeaps(const SymbolHeaps& other, const allocator_type& allocator) : bids(other.bids, allocator), asks(other.asks, allocator) {}
+		SymbolHeaps(SymbolHeaps&& other, const allocator_type& allocator) : bids(std::move(other.bids), allocator), asks(std::move(other.asks), allocator) {}
+		SymbolHeaps(const SymbolHeaps&) = default;
+		SymbolHeaps(SymbolHeaps&&) = default;
+		SymbolHeaps& operator=(const SymbolHeaps&) = default;
+		SymbolHeaps& operator=(SymbolHeaps&&) = default;
+	};
+
+	static constexpr uint32_t NO_SLOT = UINT32_MAX;  // End of the free list
+
+	std::pmr::vector<Slot> slots;          // Slab of order slots (grows to the high-water mark, then reused)
+	std::pmr::vector<SymbolHeaps> heaps;   // Heaps of each symbol, indexed by SymbolId
+	Heap parked;                           // Slots of parked orders (orders in flight, usually few)
+	uint32_t freeHead = NO_SLOT;           // First free slot
+	uint64_t nextSequence = 0;             // Arrival counter for time priority
+	size_t resting = 0;                    // Number of resting orders over all symbols
+
+	Heap& heapFor(SymbolId symbol, Order::Side side) {
+		return side == Order::Side::BUY ? heaps[symbol].bids : heaps[symbol].asks;
+	}
+	Heap& heapOf(uint32_t slotIndex) {
+		return heapFor(slots[slotIndex].order.symbol, slots[slotIndex].order.side);
+	}
+	bool better(Order::Side side, uint32_t a, uint32_t b) const;
+	void siftUp(Heap& heap, Order::Side side, uint32_t pos);
+	void siftDown(Heap& heap, Order::Side side, uint32_t pos);
+	void removeFromHeap(uint32_t slotIndex);
+	void removeFromParked(uint32_t slotIndex);
+	void releaseSlot(uint32_t slotIndex);
+	uint32_t allocate(const Order& order);
+
+	/**
+	 * @brief Fills the crossing orders of one heap with a limited volume
+	 *
+	 * The volume first goes to the queue ahead of the top order, then to the
+	 * order itself. A partially filled order keeps its place on top, and
+	 * matching stops once the volume is used up.
+	 */
+	template<typename CrossFn, typename FillFn>
+	void fillFromHeap(Heap& heap, CrossFn crosses, double available, FillFn& onFill) {
+		while (available > 0.0 && !heap.empty() && crosses(slots[heap.front()].order.price)) {
+			const uint32_t top = heap.front();
+			Slot& slot = slots[top];
+
+			const double traded = std::min(slot.queueAhead, available);  // Volume executed ahead of the order
+			slot.queueAhead -= traded;
+			available -= traded;
+			if (available <= 0.0) break;
+
+			const double filled = std::min(slot.order.volume, available);
+			available -= filled;
+			onFill(static_cast<const Order&>(slot.order), filled);
+			if (filled < slot.order.volume) {
+				slot.order.volume -= filled;
+				break;
+			}
+			removeFromHeap(top);
+			releaseSlot(top);
+		}
+	}
+	Slot* find(OrderId id);
+	const Slot* find(OrderId id) const;
+
+public:
+	/**
+	 * @brief Creates an empty book
+	 *
+	 * @param resource Memory resource of all the book's storage (must outlive the book)
+	 */
+	explicit OrderBook(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		: slots(resource), heaps(resource), parked(resource) {}
+
+	/**
+	 * @brief Pre-allocates room for the given number of resting orders
+	 *
+	 * Optional - the book grows on demand. Reserving up front makes even the
+	 * warm-up phase allocation-free.
+	 *
+	 * @param capacity Number of orders to make room for
+	 * @param symbols Number of symbols the orders are spread over (heaps are reserved for all of them)
+	 */
+	void reserve(size_t capacity, size_t symbols = 1);
+
+	/**
+	 * @brief Adds a LIMIT order to the side of the book given by order.side
+	 *
+	 * The order rests in the heaps of order.symbol.
+	 *
+	 * @param order The order to rest in the book (its id field is ignored)
+	 * @return The ID assigned to the order
+	 */
+	OrderId add(const Order& order);
+
+	/**
+	 * @brief Stores a LIMIT order without making it matchable yet
+	 *
+	 * The order gets its ID and counts as resting (it can be looked up,
+	 * cancelled and replaced), but no match sees it until activate().
+	 *
+	 * @param order The order (its id field is ignored)
+	 * @return The ID assigned to the order
+	 */
+	OrderId park(const Order& order);
+
+	/**
+	 * @brief Puts a parked order into its heap, behind the orders already at its price
+	 *
+	 * @param id ID returned by park()
+	 * @param queueAhead Volume queued before the order (see matchVolume())
+	 * @return true if the order was activated, false if it was cancelled meanwhile (or isn't parked)
+	 */
+	bool activate(OrderId id, double queueAhead);
+
+	/**
+	 * @brief Removes a resting order
+	 *
+	 * @param id ID returned by add()
+	 * @return true if the order was resting and has been removed, false if the ID is unknown or stale
+	 */
+	bool cancel(OrderId id);
+
+	/**
+	 * @brief Changes the price and volume of a resting order, keeping its ID
+	 *
+	 * Like on an exchange, the replaced order loses its time priority and goes
+	 * to the back of the queue at its new price.
+	 *
+	 * @param id ID returned by add()
+	 * @param newPrice New limit price
+	 * @param newVolume New volume
+	 * @param queueAhead Volume queued before the order at its new price (matchVolume() only)
+	 * @return true if the order was found and updated, false if the ID is unknown or stale
+	 */
+	bool replace(OrderId id, double newPrice, double newVolume, double queueAhead = 0.0);
+
+	/**
+	 * @brief Removes every resting order on one side of the book, for all symbols
+	 *
+	 * @param side Side to clear
+	 * @return Number of orders removed
+	 */
+	size_t cancelAll(Order::Side side);
+
+	/**
+	 * @brief Removes every resting order of one symbol on one side of the book
+	 *
+	 * @param symbol Symbol to clear
+	 * @param side Side to clear
+	 * @return Number of orders removed
+	 */
+	size_t cancelAll(SymbolId symbol, Order::Side side);
+
+	/**
+	 * @brief Looks up a resting order
+	 *
+	 * @param id ID returned by add()
+	 * @return Pointer to the order, or nullptr if it is no longer resting
+	 */
+	const Order* get(OrderId id) const;
+
+	/**
+	 * @brief Removes and reports every order of a symbol that crosses the given prices
+	 *
+	 * - BUY orders cross when order.price >= buyLimit
+	 * - SELL orders cross when order.price <= sellLimit
+	 *
+	 * For trade ticks both limits are the trade price, for quote ticks the
+	 * BUY side is checked against the ask and the SELL side against the bid.
+	 *
+	 * @param symbol Symbol of the tick (orders of other symbols are not looked at)
+	 * @param buyLimit Price that resting BUY orders must be at or above to fill
+	 * @param sellLimit Price that resting SELL orders must be at or below to fill
+	 * @param onFill Called with each crossing order (const Order&) before it is removed
+	 */
+	template<typename FillFn>
+	void match(SymbolId symbol, double buyLimit, double sellLimit, FillFn&& onFill) {
+		if (symbol >= heaps.size()) return;  // No order was ever placed on this symbol
+		Heap& bids = heaps[symbol].bids;
+		Heap& asks = heaps[symbol].asks;
+
+		// Pop bids from the best (highest) price down until the top one doesn't cross
+		while (!bids.empty() && slots[bids.front()].order.price >= buyLimit) {
+			uint32_t top = bids.front();
+			onFill(static_cast<const Order&>(slots[top].order));
+			removeFromHeap(top);
+			releaseSlot(top);
+		}
+
+		// Pop asks from the best (lowest) price up until the top one doesn't cross
+		while (!asks.empty() && slots[asks.front()].order.price <= sellLimit) {
+			uint32_t top = asks.front();
+			onFill(static_cast<const Order&>(slots[top].order));
+			removeFromHeap(top);
+			releaseSlot(top);
+		}
+	}
+
+	/**
+	 * @brief Fills the orders of a symbol that cross the given prices, within a volume
+	 *
+	 * Same crossing rule as match(), but each side can only trade `volume` on
+	 * this call: it first consumes the queue ahead of the best order, then
+	 * fills it, possibly partially (the rest keeps resting with a reduced
+	 * volume), then moves on to the next one. Still O(fills * log(book size)).
+	 *
+	 * @param symbol Symbol of the tick
+	 * @param buyLimit Price that resting BUY orders must be at or above to fill
+	 * @param sellLimit Price that resting SELL orders must be at or below to fill
+	 * @param volume Volume offered to each side by the tick
+	 * @param onFill Called with (const Order&, double filledVolume) for each execution, before a fully filled order is removed
+	 */
+	template<typename FillFn>
+	void matchVolume(SymbolId symbol, double buyLimit, double sellLimit, double volume, FillFn&& onFill) {
+		if (symbol >= heaps.size()) return;
+		fillFromHeap(heaps[symbol].bids, [buyLimit](double price) { return price >= buyLimit; }, volume, onFill);
+		fillFromHeap(heaps[symbol].asks, [sellLimit](double price) { return price <= sellLimit; }, volume, onFill);
+	}
+
+	/**
+	 * @brief Returns the number of resting orders on both sides, over all symbols
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Returns true if there are no resting orders
+	 */
+	bool empty() const;
+};
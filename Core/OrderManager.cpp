@@ -1,53 +1,165 @@
 #include "OrderManager.h"
+#include "Portfolio.h"
+#include "ProgressChannel.h"
+
+/**
+ * @brief Extends the per-symbol state to include the given symbol
+ */
+void OrderManager::growSymbols(SymbolId symbol) {
+	symbols.resize(size_t(symbol) + 1);
+}
+
+/**
+ * @brief Sizes the per-symbol state and the books of every symbol
+ */
+void OrderManager::reserveSymbols(size_t count) {
+	if (symbols.size() < count) symbols.resize(count);
+	openSymbols.reserve(count);
+	book.reserve(0, count);
+}
+
+/**
+ * @brief Turns the fill log on or off (fills already logged are kept)
+ */
+void OrderManager::setRecordFills(bool record) {
+	recordFills = record;
+}
+
+/**
+ * @brief Returns the logged executions
+ */
+std::span<const Fill> OrderManager::getFills() const {
+	return fills;
+}
+
+/**
+ * @brief Validates and enables the execution model
+ */
+void OrderManager::setExecutionModel(const ExecutionModel& executionModel) {
+	executionModel.validate();
+	model = executionModel;
+	modelled = true;
+}
+
+/**
+ * @brief Routes risk checks and executions through a shared portfolio
+ */
+void OrderManager::setPortfolio(Portfolio* shared) {
+	portfolio = shared;
+}
+
+/**
+ * @brief Sets the channel executions are published to
+ */
+void OrderManager::setProgressChannel(ProgressChannel* channel) {
+	progress = channel;
+}
 
 /**
  * @brief Submits an order for execution
  * 
  * MARKET orders execute immediately at the current price.
  * LIMIT orders are queued and will execute when price conditions are met.
+ * The ID of a queued order is written back into order.id and returned.
+ * 
+ * With an execution model, every order goes into the in-flight heap first;
+ * a LIMIT order is parked in the book meanwhile, so its ID can already be
+ * cancelled or replaced.
  */
-void OrderManager::submit(Order& order) {
-	if (order.type == OrderType::MARKET) {
+OrderId OrderManager::submit(Order& order) {
+	if (portfolio && !portfolio->approve(order)) [[unlikely]] {
+		order.id = 0;
+		rejected++;
+		return 0;
+	}
+
+	if (modelled) {
+		order.id = order.type == OrderType::LIMIT ? book.park(order) : 0;
+		inFlight.push(InFlight{ order.timestamp + model.latency, inFlightSequence++, order });
+	} else if (order.type == OrderType::MARKET) {
 		// Market orders execute immediately - no price checking needed
-		execute(order);
+		order.id = 0;
+		execute(order, order.timestamp);
 	} else {
-		// Limit orders wait in the pending queue until price conditions are met
-		pendingOrders.push_back(order);
+		// Limit orders rest in the book until price conditions are met
+		order.id = book.add(order);
 	}
+	return order.id;
+}
+
+/**
+ * @brief Cancels a resting LIMIT order by ID
+ */
+bool OrderManager::cancel(OrderId id) {
+	return book.cancel(id);
+}
+
+/**
+ * @brief Changes price and volume of a resting LIMIT order in place
+ * 
+ * With an execution model, the order queues again behind the volume at its
+ * new price. Cancels and replaces take effect immediately (no latency).
+ */
+bool OrderManager::replace(OrderId id, double newPrice, double newVolume) {
+	if (!modelled) return book.replace(id, newPrice, newVolume);
+
+	const Order* resting = book.get(id);
+	if (!resting) return false;
+	Order moved = *resting;
+	moved.price = newPrice;
+	return book.replace(id, newPrice, newVolume, queueAhead(moved));
+}
+
+/**
+ * @brief Cancels every resting LIMIT order on one side of the book
+ */
+size_t OrderManager::cancelAll(Order::Side side) {
+	return book.cancelAll(side);
+}
+
+/**
+ * @brief Cancels every resting LIMIT order of one symbol on one side
+ */
+size_t OrderManager::cancelAll(SymbolId symbol, Order::Side side) {
+	return book.cancelAll(symbol, side);
+}
+
+/**
+ * @brief Returns true while the order is resting in the book
+ */
+bool OrderManager::isPending(OrderId id) const {
+	return book.get(id) != nullptr;
 }
 
 /**
  * @brief Checks pending LIMIT orders against a regular tick
  * 
- * For each pending order, checks if the current tick price meets the execution condition:
+ * Execution conditions:
  * - BUY limit: executes when market price drops to or below our limit (tick.price <= order.price)
  * - SELL limit: executes when market price rises to or above our limit (tick.price >= order.price)
  * 
- * Orders that don't execute remain in the pending queue.
+ * The book is sorted by price, so only the orders that actually cross are visited.
+ * Orders that don't execute stay in the book untouched.
  */
 void OrderManager::handleTick(const Tick& tick) {
-	std::vector<Order> stillPending;  // Orders that didn't execute this tick
-
-	for (auto& order : pendingOrders) {
-		bool executed = false;
-
-		// BUY limit order: execute if price dropped to our buy level or below
-		if (order.side == Order::Side::BUY && tick.price <= order.price) {
-			execute(order);
-			executed = true;
+	SymbolState& state = stateFor(tick.symbol);
+	state.mark = tick.price;
+	if (modelled) [[unlikely]] {
+		state.bid = state.ask = tick.price;
+		state.depth = tick.volume;
+		arrive(tick.timestamp);
+		if (!book.empty()) {
+			book.matchVolume(tick.symbol, tick.price, tick.price, tick.volume, [this, &tick](const Order& order, double volume) {
+				Order executed = order;
+				executed.volume = volume;
+				execute(executed, tick.timestamp);
+			});
 		}
-		// SELL limit order: execute if price rose to our sell level or above
-		else if (order.side == Order::Side::SELL && tick.price >= order.price) {
-			execute(order);
-			executed = true;
-		}
-
-		// Keep order in pending queue if it didn't execute
-		if (!executed) stillPending.push_back(order);
+		return;
 	}
+	if (book.empty()) return;  // Nothing resting - most ticks for market-order strategies
 
-	// Replace pending orders with only those that didn't execute
-	pendingOrders = std::move(stillPending);
+	book.match(tick.symbol, tick.price, tick.price, [this, &tick](const Order& order) { execute(order, tick.timestamp); });
 }
 
 /**
@@ -60,29 +172,64 @@ void OrderManager::handleTick(const Tick& tick) {
  * This is more realistic because it uses actual order book prices rather than last trade price.
  */
 void OrderManager::handleTick(const QuoteTick& quote) {
-	std::vector<Order> stillPending;
-	stillPending.reserve(pendingOrders.size());  // Pre-allocate for efficiency
+	SymbolState& state = stateFor(quote.symbol);
+	state.mark = (quote.bid + quote.ask) / 2.0;
+	if (modelled) [[unlikely]] {
+		state.bid = quote.bid;
+		state.ask = quote.ask;
+		state.depth = quote.volume;
+		arrive(quote.timestamp);
+		if (!book.empty()) {
+			book.matchVolume(quote.symbol, quote.ask, quote.bid, quote.volume, [this, &quote](const Order& order, double volume) {
+				Order executed = order;
+				executed.volume = volume;
+				execute(executed, quote.timestamp);
+			});
+		}
+		return;
+	}
+	if (book.empty()) return;
 
-	for (auto& order : pendingOrders) {
-		bool executed = false;
+	book.match(quote.symbol, quote.ask, quote.bid, [this, &quote](const Order& order) { execute(order, quote.timestamp); });
+}
 
-		// BUY limit order: execute if we're willing to pay at least the ask price
-		if (order.side == Order::Side::BUY && order.price >= quote.ask) {
-			execute(order);
-			executed = true;
-		}
-		// SELL limit order: execute if we're willing to sell at most the bid price
-		else if (order.side == Order::Side::SELL && order.price <= quote.bid) {
-			execute(order);
-			executed = true;
-		}
+/**
+ * @brief Processes the in-flight orders that reach the market by the given time
+ * 
+ * Called after the tick's prices were recorded, so MARKET orders execute at
+ * the touch of the tick they arrive on and LIMIT orders queue behind its depth.
+ * Orders arrive in (arrival time, submission) order.
+ */
+void OrderManager::arrive(uint64_t timestamp) {
+	while (!inFlight.empty() && inFlight.top().arrival <= timestamp) {
+		Order order = inFlight.top().order;
+		inFlight.pop();
 
-		// Keep order in pending queue if it didn't execute
-		if (!executed) stillPending.push_back(order);
+		if (order.type == OrderType::MARKET) {
+			const SymbolState& state = stateFor(order.symbol);
+			const bool buy = order.side == Order::Side::BUY;
+			const double touch = buy ? state.ask : state.bid;
+			if (touch > 0.0) order.price = touch;  // Else no tick of the symbol yet - keep the order's own price
+			order.price *= buy ? 1.0 + model.slippage : 1.0 - model.slippage;
+			execute(order, timestamp);
+		} else if (const Order* parked = book.get(order.id)) {
+			// Price and volume may have been replaced while in flight
+			book.activate(order.id, queueAhead(*parked));
+		}
 	}
+}
 
-	// Replace pending orders with only those that didn't execute
-	pendingOrders = std::move(stillPending);
+/**
+ * @brief Volume queued before a LIMIT order joining the market now
+ * 
+ * An order at or behind the best price of its side waits behind the volume
+ * quoted there; an order improving on it (or crossing) is first in line.
+ */
+double OrderManager::queueAhead(const Order& order) const {
+	if (order.symbol >= symbols.size()) return 0.0;
+	const SymbolState& state = symbols[order.symbol];
+	const bool improves = order.side == Order::Side::BUY ? order.price > state.bid : order.price < state.ask;
+	return improves ? 0.0 : state.depth;
 }
 
 /**
@@ -92,20 +239,57 @@ void OrderManager::handleTick(const QuoteTick& quote) {
  * - BUY: We acquire shares (position increases), pay cash (cash decreases)
  * - SELL: We dispose of shares (position decreases), receive cash (cash increases)
  * 
+ * The symbol joins or leaves the list of open positions when its position
+ * becomes non-zero or flat. With the fill log on, the execution is appended to it.
+ * In portfolio mode the execution is booked in the portfolio as well.
+ * 
  * Note: This doesn't check if we have enough cash or position to execute.
  * In a real system, you'd want to add validation here.
  */
-void OrderManager::execute(Order& order) {
+void OrderManager::execute(const Order& order, uint64_t timestamp) {
+	SymbolState& state = stateFor(order.symbol);
+
 	if (order.side == Order::Side::BUY) {
 		// Buying: increase position, decrease cash
-		position += order.volume;
+		state.position += order.volume;
 		cash -= order.volume * order.price;
 	}
 	else {
 		// Selling: decrease position, increase cash
-		position -= order.volume;
+		state.position -= order.volume;
 		cash += order.volume * order.price;
 	}
+
+	if (state.position != 0.0 && state.openIndex == NOT_OPEN) {
+		state.openIndex = static_cast<uint32_t>(openSymbols.size());
+		openSymbols.push_back(order.symbol);
+	} else if (state.position == 0.0 && state.openIndex != NOT_OPEN) {
+		// Swap with the last open symbol and pop
+		const SymbolId last = openSymbols.back();
+		openSymbols[state.openIndex] = last;
+		symbols[last].openIndex = state.openIndex;
+		openSymbols.pop_back();
+		state.openIndex = NOT_OPEN;
+	}
+
+	double fee = 0.0;
+	if (modelled) {
+		fee = order.volume * (order.price * model.feeRate + model.feePerUnit);
+		cash -= fee;
+		fees += fee;
+	}
+
+	if (portfolio) {
+		const bool buy = order.side == Order::Side::BUY;
+		const double notional = order.volume * order.price;
+		portfolio->onExecution(order.symbol, buy ? order.volume : -order.volume, (buy ? -notional : notional) - fee);
+	}
+
+	if (recordFills || progress) {
+		const Fill fill{ timestamp, order.id, order.price, order.volume, order.side, order.symbol, fee };
+		if (recordFills) fills.push_back(fill);
+		if (progress) progress->publish(ProgressEvent{ ProgressEvent::Type::FILL, 0, 0.0, fill });
+	}
 }
 
 /**
@@ -122,14 +306,57 @@ void OrderManager::execute(Order& order) {
  * @return Total portfolio value
  */
 double OrderManager::getPnL(double lastPrice) const {
-	return cash + position * lastPrice;
+	double value = cash + symbols[0].position * lastPrice;
+	for (SymbolId symbol : openSymbols) {
+		if (symbol != 0) value += symbols[symbol].position * symbols[symbol].mark;
+	}
+	return value;
 }
 
 /**
- * @brief Returns the current position (number of shares owned)
+ * @brief Calculates total portfolio value with every open position at its mark
+ */
+double OrderManager::getPnL() const {
+	double value = cash;
+	for (SymbolId symbol : openSymbols) {
+		value += symbols[symbol].position * symbols[symbol].mark;
+	}
+	return value;
+}
+
+/**
+ * @brief Returns the current position (number of shares owned) of a symbol
  * 
  * @return Current position (positive = long position, negative = short position, 0 = flat)
  */
-double OrderManager::getPosition() const {
-	return position;
+double OrderManager::getPosition(SymbolId symbol) const {
+	return symbol < symbols.size() ? symbols[symbol].position : 0.0;
+}
+
+/**
+ * @brief Returns the last price recorded for a symbol
+ */
+double OrderManager::getMark(SymbolId symbol) const {
+	return symbol < symbols.size() ? symbols[symbol].mark : 0.0;
+}
+
+/**
+ * @brief Returns the number of LIMIT orders still resting in the book
+ */
+size_t OrderManager::getPendingCount() const {
+	return book.size();
+}
+
+/**
+ * @brief Returns the fees paid so far
+ */
+double OrderManager::getFees() const {
+	return fees;
+}
+
+/**
+ * @brief Returns the number of orders refused by the portfolio
+ */
+size_t OrderManager::getRejectedCount() const {
+	return rejected;
 }
@@ -1,33 +1,19 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <queue>
+#include <span>
 #include <vector>
 
 #include "Tick.h"
+#include "Order.h"
+#include "OrderBook.h"
+#include "ExecutionModel.h"
 
-/**
- * @brief Types of orders that can be placed
- * 
- * MARKET: Execute immediately at the current market price
- * LIMIT: Execute only when price reaches the specified limit price
- */
-enum class OrderType { MARKET, LIMIT };
-
-/**
- * @brief Represents a trading order (buy or sell request)
- * 
- * An order is a request to buy or sell a certain volume at a certain price.
- * Orders can be market orders (execute immediately) or limit orders
- * (execute only when price conditions are met).
- */
-struct Order {
-	enum class Side { BUY, SELL };  // Whether this is a buy or sell order
-	Side side;                      // The side of this order
-	OrderType type;                 // MARKET (immediate) or LIMIT (conditional)
-	uint64_t timestamp;             // When this order was created
-	double volume;                  // Number of shares/contracts to trade
-	double price;                   // Price for LIMIT orders, or execution price for MARKET orders
-};
+class Portfolio;
+class ProgressChannel;
 
 /**
  * @brief Manages order execution, position tracking, and portfolio accounting
@@ -41,49 +27,235 @@ struct Order {
  * 
  * Each strategy has its own OrderManager instance, so strategies don't
  * interfere with each other's positions or cash.
+ * 
+ * Positions are tracked per symbol (Order::symbol), against a single cash
+ * balance. Every tick handled also records the price of its symbol (the mark),
+ * so getPnL() can value a multi-symbol portfolio without the caller keeping
+ * track of prices. Per-symbol arrays grow when a new symbol is first seen;
+ * reserveSymbols() sizes them up front.
+ * 
+ * Executions can be logged as Fill records (setRecordFills()), e.g. to be
+ * exported with the results. Logging is off by default.
+ * 
+ * By default orders fill instantly and in full (the naive matcher). An
+ * ExecutionModel (setExecutionModel()) adds latency, queue positions,
+ * partial fills, slippage and fees; orders in flight wait in a min-heap keyed
+ * by arrival time, so a tick only looks at the orders arriving on it.
+ * 
+ * In portfolio mode (setPortfolio()), orders must pass the portfolio's
+ * pre-trade checks and every execution is also booked in the portfolio; the
+ * OrderManager's own cash and positions then attribute the book's PnL to
+ * its strategy.
+ * 
+ * Every container (book, per-symbol state, fill log, in-flight queue) draws
+ * from the memory resource given at construction, so a run arena can hand
+ * out and take back all of it at once (see RunArena).
  */
 class OrderManager {
 private:
-	std::vector<Order> pendingOrders;  // LIMIT orders waiting for price conditions
-	double position = 0.0;              // Current position (positive = long, negative = short)
-	double cash;                        // Available cash balance
+	static constexpr uint32_t NOT_OPEN = UINT32_MAX;  // openIndex of a flat symbol
+
+	/**
+	 * @brief Position and last price of one symbol
+	 */
+	struct SymbolState {
+		double position = 0.0;          // Current position (positive = long, negative = short)
+		double mark = 0.0;              // Last price seen for the symbol (trade price or mid-quote)
+		uint32_t openIndex = NOT_OPEN;  // Position of the symbol in openSymbols
+		double bid = 0.0;               // Last best bid (trade price for trade ticks, execution model only)
+		double ask = 0.0;               // Last best ask (trade price for trade ticks, execution model only)
+		double depth = 0.0;             // Volume quoted at the best prices (execution model only)
+	};
+
+	/**
+	 * @brief An order on its way to the market (execution model only)
+	 */
+	struct InFlight {
+		uint64_t arrival;               // Timestamp at which the order reaches the market
+		uint64_t sequence;              // Submission order, breaks ties between equal arrivals
+		Order order;                    // MARKET order to execute, or parked LIMIT order (order.id) to activate
+
+		bool operator>(const InFlight& other) const {
+			return arrival != other.arrival ? arrival > other.arrival : sequence > other.sequence;
+		}
+	};
+
+	OrderBook book;                     // LIMIT orders waiting for price conditions, sorted by price
+	std::pmr::vector<SymbolState> symbols;   // Indexed by SymbolId
+	std::pmr::vector<SymbolId> openSymbols;  // Symbols with a non-zero position (valued by getPnL)
+	double cash;                             // Available cash balance
+	std::pmr::vector<Fill> fills;            // Executions so far (if recordFills)
+	bool recordFills = false;           // Append every execution to fills
+
+	ExecutionModel model;               // Latency, slippage and fees (if modelled)
+	bool modelled = false;              // Use the execution model instead of the naive matcher
+	std::priority_queue<InFlight, std::pmr::vector<InFlight>, std::greater<>> inFlight;  // Earliest arrival on top
+	uint64_t inFlightSequence = 0;      // Next InFlight::sequence
+	double fees = 0.0;                  // Fees paid so far
+
+	Portfolio* portfolio = nullptr;     // Shared book checking and netting the orders (portfolio mode)
+	size_t rejected = 0;                // Orders refused by the portfolio's risk checks
+	ProgressChannel* progress = nullptr;  // Receives a FILL event per execution (observed runs)
+
+	void growSymbols(SymbolId symbol);  // Out of line: only runs the first time a symbol is seen
+	SymbolState& stateFor(SymbolId symbol) {
+		if (symbol >= symbols.size()) [[unlikely]] growSymbols(symbol);
+		return symbols[symbol];
+	}
+	void arrive(uint64_t timestamp);    // Execution model: activates the orders that reached the market
+	double queueAhead(const Order& order) const;
 	
 public:
 	/**
 	 * @brief Constructs an OrderManager with initial cash
 	 * 
 	 * @param cash Starting cash balance for this strategy
+	 * @param resource Memory resource of all the containers (must outlive the OrderManager)
 	 */
-	OrderManager(int cash) : cash(cash) {}
+	OrderManager(int cash, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		: book(resource), symbols(1, resource), openSymbols(resource), cash(cash), fills(resource),
+		  inFlight(std::greater<>(), std::pmr::vector<InFlight>(resource)) {}
+
+	/**
+	 * @brief Sizes the per-symbol state for symbols [0, count)
+	 * 
+	 * Optional - the state grows when a symbol is first seen. Reserving makes
+	 * a multi-symbol run allocation-free from the first tick.
+	 * 
+	 * @param count Number of symbols
+	 */
+	void reserveSymbols(size_t count);
+
+	/**
+	 * @brief Turns the fill log on or off
+	 * 
+	 * @param record If true, every execution from now on is appended to getFills()
+	 */
+	void setRecordFills(bool record);
+
+	/**
+	 * @brief Gets the executions logged while setRecordFills(true) was in effect, in order
+	 */
+	std::span<const Fill> getFills() const;
+
+	/**
+	 * @brief Switches from the naive matcher to a realistic fill simulation
+	 * 
+	 * See ExecutionModel for what is simulated. Set it before submitting
+	 * orders: orders already resting keep being matched, but without the
+	 * queue ahead of them.
+	 * 
+	 * @param model Latency, slippage and fee parameters
+	 * @throws std::invalid_argument If the slippage is outside [0, 1) or a fee is negative
+	 */
+	void setExecutionModel(const ExecutionModel& model);
+
+	/**
+	 * @brief Connects the OrderManager to a shared portfolio
+	 * 
+	 * From then on, submit() refuses the orders the portfolio doesn't approve,
+	 * and every execution is booked in the portfolio too.
+	 * 
+	 * @param portfolio Shared book (nullptr to trade on the OrderManager's own,
+	 *                  the default); must outlive the OrderManager's use
+	 */
+	void setPortfolio(Portfolio* portfolio);
+
+	/**
+	 * @brief Publishes every execution from now on to a progress channel
+	 * 
+	 * Called from the thread running the strategy only (the channel's producer).
+	 * 
+	 * @param channel Channel of the strategy (nullptr to stop publishing, the default)
+	 */
+	void setProgressChannel(ProgressChannel* channel);
 
 	/**
 	 * @brief Submits an order for execution
 	 * 
 	 * MARKET orders are executed immediately.
-	 * LIMIT orders are added to pendingOrders and executed when price conditions are met.
+	 * LIMIT orders are added to the order book and executed when price conditions are met.
+	 * With an execution model, both wait until they reach the market (see ExecutionModel).
+	 * 
+	 * @param order The order to submit (order.id is set to the assigned ID, order.symbol gives the instrument)
+	 * In portfolio mode, an order refused by the risk checks is dropped:
+	 * order.id is set to 0 and it is counted in getRejectedCount().
+	 * 
+	 * @return ID of the resting LIMIT order, or 0 for MARKET orders (already executed, or in flight) and refused orders
+	 */
+	OrderId submit(Order& order);
+
+	/**
+	 * @brief Cancels a resting LIMIT order
+	 * 
+	 * @param id ID returned by submit()
+	 * @return true if the order was cancelled, false if it already filled, was cancelled, or is unknown
+	 */
+	bool cancel(OrderId id);
+
+	/**
+	 * @brief Changes the price and volume of a resting LIMIT order, keeping its ID
+	 * 
+	 * The order loses its time priority (as with a cancel followed by a new order).
+	 * This is the cheapest way to requote: no slot is released or allocated.
+	 * 
+	 * @param id ID returned by submit()
+	 * @param newPrice New limit price
+	 * @param newVolume New volume
+	 * @return true if the order was updated, false if it already filled, was cancelled, or is unknown
+	 */
+	bool replace(OrderId id, double newPrice, double newVolume);
+
+	/**
+	 * @brief Cancels every resting LIMIT order on one side, for all symbols
+	 * 
+	 * @param side BUY to pull all bids, SELL to pull all asks
+	 * @return Number of orders cancelled
+	 */
+	size_t cancelAll(Order::Side side);
+
+	/**
+	 * @brief Cancels every resting LIMIT order of one symbol on one side
+	 * 
+	 * @param symbol Symbol whose orders are pulled
+	 * @param side BUY to pull all bids, SELL to pull all asks
+	 * @return Number of orders cancelled
+	 */
+	size_t cancelAll(SymbolId symbol, Order::Side side);
+
+	/**
+	 * @brief Checks whether a LIMIT order is still resting in the book
 	 * 
-	 * @param order The order to submit
+	 * @param id ID returned by submit()
+	 * @return true if the order has neither filled nor been cancelled
 	 */
-	void submit(Order& order);
+	bool isPending(OrderId id) const;
 
 	/**
 	 * @brief Executes an order immediately
 	 * 
-	 * Updates position and cash based on the order:
+	 * Updates the position of order.symbol and cash based on the order:
 	 * - BUY: Increase position, decrease cash
 	 * - SELL: Decrease position, increase cash
 	 * 
+	 * The fees of the execution model, if any, are paid out of cash.
+	 * 
 	 * @param order The order to execute
+	 * @param timestamp Time of the execution (only used by the fill log)
 	 */
-	void execute(Order& order);
+	void execute(const Order& order, uint64_t timestamp);
 
 	/**
 	 * @brief Processes a tick and checks if any pending LIMIT orders should execute
 	 * 
-	 * For each pending LIMIT order:
+	 * Records tick.price as the mark of tick.symbol. Only the resting LIMIT
+	 * orders of that symbol that cross the trade price are visited:
 	 * - BUY orders execute when tick.price <= order.price (price dropped to our buy level)
 	 * - SELL orders execute when tick.price >= order.price (price rose to our sell level)
 	 * 
+	 * With an execution model, the orders arriving by tick.timestamp reach the
+	 * market first, and crossing orders share tick.volume (see ExecutionModel).
+	 * 
 	 * @param tick The current market tick
 	 */
 	void handleTick(const Tick& tick);
@@ -96,26 +268,65 @@ public:
 	 * - SELL orders execute when order.price <= quote.bid (we can sell at bid price)
 	 * 
 	 * This is more realistic for strategies that need to see the spread.
+	 * The mid-price is recorded as the mark of quote.symbol.
+	 * With an execution model, crossing orders share quote.volume.
 	 * 
 	 * @param quote The current quote tick with bid/ask prices
 	 */
 	void handleTick(const QuoteTick& quote);
 
 	/**
-	 * @brief Calculates current profit and loss (PnL)
+	 * @brief Calculates current profit and loss (PnL) of a single-instrument portfolio
 	 * 
 	 * PnL = cash + (position * current_price)
 	 * This represents the total portfolio value if we closed all positions now.
+	 * Positions on other symbols than 0, if any, are valued at their mark.
 	 * 
-	 * @param lastPrice The current market price to value the position
+	 * @param lastPrice The current market price to value the symbol 0 position
 	 * @return Total portfolio value (cash + position value)
 	 */
 	double getPnL(double lastPrice) const;
 
 	/**
-	 * @brief Gets the current position (number of shares owned)
+	 * @brief Calculates current profit and loss, every position valued at its mark
+	 * 
+	 * PnL = cash + sum(position * mark) over the symbols with an open position.
+	 * Costs O(open positions), not O(symbols).
+	 * 
+	 * @return Total portfolio value (cash + position values)
+	 */
+	double getPnL() const;
+
+	/**
+	 * @brief Gets the current position (number of shares owned) of a symbol
 	 * 
+	 * @param symbol Instrument (default: 0, the only one of single-instrument data)
 	 * @return Current position (positive = long, negative = short, 0 = flat)
 	 */
-	double getPosition() const;
+	double getPosition(SymbolId symbol = 0) const;
+
+	/**
+	 * @brief Gets the last price recorded for a symbol by handleTick()
+	 * 
+	 * @param symbol Instrument
+	 * @return Last trade price or mid-quote, 0 if no tick of the symbol was handled yet
+	 */
+	double getMark(SymbolId symbol) const;
+
+	/**
+	 * @brief Gets the number of LIMIT orders still waiting in the book
+	 * 
+	 * @return Number of resting orders (bids + asks)
+	 */
+	size_t getPendingCount() const;
+
+	/**
+	 * @brief Gets the fees paid so far (always 0 without an execution model)
+	 */
+	double getFees() const;
+
+	/**
+	 * @brief Gets the number of orders refused by the portfolio's risk checks (always 0 outside portfolio mode)
+	 */
+	size_t getRejectedCount() const;
 };
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "ParameterSweep.h"
+#include "StrategyContext.h"
+#include "RunArena.h"
+#include "WorkStealingQueue.h"
+
+/**
+ * @brief Adds a parameter axis with explicit values
+ */
+ParameterGrid& ParameterGrid::add(const std::string& name, std::vector<double> values) {
+	if (values.empty()) throw std::invalid_argument("Parameter '" + name + "' has no values.");
+	axes.emplace_back(name, std::move(values));
+	return *this;
+}
+
+/**
+ * @brief Adds a parameter axis with evenly spaced values
+ *
+ * Values are computed as start + i * step (not by repeated addition) so that
+ * rounding errors don't accumulate along long ranges. A small tolerance makes
+ * sure the stop value is included when it lies exactly on the grid.
+ */
+ParameterGrid& ParameterGrid::addRange(const std::string& name, double start, double stop, double step) {
+	if (step <= 0.0) throw std::invalid_argument("Parameter '" + name + "' needs a positive step.");
+
+	std::vector<double> values;
+	for (size_t i = 0; start + i * step <= stop + step * 1e-9; i++) {
+		values.push_back(start + i * step);
+	}
+	return add(name, std::move(values));
+}
+
+/**
+ * @brief Number of grid points = product of the axis sizes, checked for overflow
+ */
+size_t ParameterGrid::size() const {
+	if (axes.empty()) return 0;
+
+	size_t count = 1;
+	for (const auto& [name, values] : axes) {
+		if (count > SIZE_MAX / values.size()) throw std::overflow_error("Parameter grid has more points than size_t can count.");
+		count *= values.size();
+	}
+	return count;
+}
+
+/**
+ * @brief Decodes a grid index into parameter values
+ *
+ * The index is read as a mixed-radix number whose last digit belongs to the
+ * last axis: index % size(last axis) picks its value, then the index is divided
+ * and the next axis to the left is decoded, and so on.
+ */
+SweepParams ParameterGrid::at(size_t index) const {
+	SweepParams params;
+	for (auto axis = axes.rbegin(); axis != axes.rend(); ++axis) {
+		const auto& [name, values] = *axis;
+		params[name] = values[index % values.size()];
+		index /= values.size();
+	}
+	return params;
+}
+
+/**
+ * @brief Creates a sweep that reads the given (caller-owned) data
+ */
+ParameterSweep::ParameterSweep(TradeSeries ticks, QuoteSeries quotes)
+	: ticks(ticks), quotes(quotes) {
+}
+
+/**
+ * @brief Sets the number of worker threads
+ */
+void ParameterSweep::setThreadCount(size_t count) {
+	threadCount = count;
+}
+
+/**
+ * @brief Runs one variant from start to end
+ *
+ * Builds a StrategyContext for the variant (own OrderManager and StatsCollector),
+ * runs it over the whole data set and returns only the statistics. The PnL
+ * series is never stored (statistics come from the online accumulators), and
+ * everything else about the run (order book, strategy state) is released when
+ * the context goes out of scope - the engine state back to the worker's arena.
+ */
+StatsMap ParameterSweep::runVariant(const SweepParams& params, const StrategyFactory& factory, TimeFrame tf, double initialCash, std::pmr::memory_resource* resource) const {
+	StrategyContext context("sweep", factory(params), tf, initialCash, resource);
+	context.statistics.setStoreSeries(false);
+	context.setup();
+
+	if (context.quoteStrategy ? quotes.empty() : ticks.empty()) {
+		throw std::runtime_error("No data available for backtest.");
+	}
+	if (ticks.getColumns() || quotes.getColumns()) {
+		context.strategy->setColumnarData(ticks.getColumns(), quotes.getColumns());
+	}
+
+	context.strategy->onStart();
+
+	// Row data is processed as one block; columnar data is gathered block by block
+	std::vector<Tick> tickScratch;
+	std::vector<QuoteTick> quoteScratch;
+	if (context.quoteStrategy) {
+		const size_t step = quotes.getColumns() ? blockSize : quotes.size();
+		for (size_t begin = 0; begin < quotes.size(); begin += step) {
+			context.process(quotes.block(begin, step, quoteScratch));
+		}
+	} else {
+		const size_t step = ticks.getColumns() ? blockSize : ticks.size();
+		for (size_t begin = 0; begin < ticks.size(); begin += step) {
+			context.process(ticks.block(begin, step, tickScratch));
+		}
+	}
+	return context.finish();
+}
+
+/**
+ * @brief Runs every variant on a pool of work-stealing workers
+ *
+ * 1. Each worker gets a contiguous range of variant indices in its own queue
+ *    (neighbouring variants tend to have similar cost and similar strategy state)
+ * 2. A worker pops its own jobs from the back of its queue
+ * 3. When its queue is empty, it tries to steal from the front of the other queues
+ * 4. When no queue has any job left, the worker exits
+ *
+ * No job is ever added after the start, so "every queue is empty" is a safe
+ * termination condition. Each result is written to its own slot of the output
+ * vector, so collecting results needs no locking.
+ *
+ * If a variant throws, the remaining jobs are abandoned and the first exception
+ * is rethrown on the calling thread once all workers have stopped.
+ */
+std::vector<SweepResult> ParameterSweep::runVariants(size_t variantCount, const std::function<SweepParams(size_t)>& paramsAt, const StrategyFactory& factory, TimeFrame tf, double initialCash) const {
+	std::vector<SweepResult> results(variantCount);
+	if (variantCount == 0) return results;
+
+	size_t workerCount = threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+	workerCount = std::min(workerCount, variantCount);
+
+	// Split the grid into contiguous ranges, one queue per worker
+	// Indices are pushed in reverse so that the owner (popping from the back) walks its range in order
+	std::vector<WorkStealingQueue<size_t>> queues(workerCount);
+	for (size_t w = 0; w < workerCount; w++) {
+		size_t begin = variantCount * w / workerCount;
+		size_t end = variantCount * (w + 1) / workerCount;
+		for (size_t i = end; i > begin; i--) queues[w].push(i - 1);
+	}
+
+	std::atomic<bool> failed{ false };
+	std::exception_ptr firstError;
+	std::mutex errorMutex;
+
+	auto worker = [&](size_t self) {
+		RunArena arena;
+		while (!failed.load(std::memory_order_relaxed)) {
+			// Own work first, then try every other queue once
+			std::optional<size_t> job = queues[self].pop();
+			for (size_t k = 1; !job && k < workerCount; k++) {
+				job = queues[(self + k) % workerCount].steal();
+			}
+			if (!job) return;  // Nothing left anywhere
+
+			try {
+				SweepResult& result = results[*job];
+				result.index = *job;
+				result.params = paramsAt(*job);
+				result.stats = runVariant(result.params, factory, tf, initialCash, arena.resource());
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if (!firstError) firstError = std::current_exception();
+				failed.store(true, std::memory_order_relaxed);
+			}
+			arena.reset();
+		}
+	};
+
+	// Launch the extra workers, run the first one on the calling thread
+	std::vector<std::thread> workers;
+	workers.reserve(workerCount - 1);
+	for (size_t w = 1; w < workerCount; w++) {
+		workers.emplace_back(worker, w);
+	}
+	worker(0);
+
+	for (auto& thread : workers) {
+		thread.join();
+	}
+
+	if (firstError) std::rethrow_exception(firstError);
+	return results;
+}
+
+std::vector<SweepResult> ParameterSweep::run(const ParameterGrid& grid, const StrategyFactory& factory, TimeFrame tf, double initialCash) const {
+	return runVariants(grid.size(), [&grid](size_t index) { return grid.at(index); }, factory, tf, initialCash);
+}
+
+std::vector<SweepResult> ParameterSweep::run(std::span<const SweepParams> variants, const StrategyFactory& factory, TimeFrame tf, double initialCash) const {
+	return runVariants(variants.size(), [variants](size_t index) { return variants[index]; }, factory, tf, initialCash);
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Tick.h"
+#include "TickSeries.h"
+#include "TimeFrame.h"
+#include "Strategy.h"
+#include "StatsCollector.h"
+
+/**
+ * @brief One point of a parameter space - maps parameter names to their values
+ *
+ * Example: {"window": 50, "minSpread": 0.02}
+ */
+using SweepParams = std::unordered_map<std::string, double>;
+
+/**
+ * @brief Builds a fresh strategy instance for one point of the parameter space
+ *
+ * Called once per variant, possibly from several worker threads at the same
+ * time, so it must not modify shared state.
+ *
+ * Example: [](const SweepParams& p) { return std::make_unique<SpreadStrategy>(1.0, p.at("minSpread"), p.at("offset")); }
+ */
+using StrategyFactory = std::function<std::unique_ptr<Strategy>(const SweepParams&)>;
+
+/**
+ * @brief Cartesian grid of parameter values
+ *
+ * Each axis is a parameter name with a list of values. The grid contains every
+ * combination of values, but never stores them: the combination for a given
+ * index is decoded on demand (like digits of a mixed-radix number), so a grid
+ * with millions of points costs only the size of its axes.
+ *
+ * The last axis added varies fastest.
+ */
+class ParameterGrid {
+private:
+	std::vector<std::pair<std::string, std::vector<double>>> axes;  // Parameter name -> candidate values
+
+public:
+	/**
+	 * @brief Adds a parameter with an explicit list of values
+	 *
+	 * @param name Parameter name (the key the factory reads)
+	 * @param values Values to try (must not be empty)
+	 * @return This grid, so calls can be chained
+	 */
+	ParameterGrid& add(const std::string& name, std::vector<double> values);
+
+	/**
+	 * @brief Adds a parameter with evenly spaced values from start to stop (inclusive)
+	 *
+	 * @param name Parameter name
+	 * @param start First value
+	 * @param stop Last value (included if reached exactly, up to rounding)
+	 * @param step Distance between values (must be > 0)
+	 * @return This grid, so calls can be chained
+	 */
+	ParameterGrid& addRange(const std::string& name, double start, double stop, double step);
+
+	/**
+	 * @brief Returns the number of points in the grid (product of the axis sizes)
+	 *
+	 * @throws std::overflow_error If the product doesn't fit in a size_t
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Returns the parameter values of one grid point
+	 *
+	 * @param index Point index in [0, size())
+	 * @return Map of parameter names to values
+	 */
+	SweepParams at(size_t index) const;
+};
+
+/**
+ * @brief Summary of one variant of a parameter sweep
+ */
+struct SweepResult {
+	size_t index;         // Index of the variant in the grid
+	SweepParams params;   // Parameter values of this variant
+	StatsMap stats;       // Statistics computed at the end of the run
+};
+
+/**
+ * @brief Runs one strategy factory over every point of a parameter grid
+ *
+ * All variants read the same immutable tick data (the sweep only keeps views
+ * of it, nothing is copied), and only the final StatsMap of each run is kept,
+ * so sweeps of 10k+ variants fit easily in memory.
+ *
+ * Scheduling:
+ * - The grid is split into contiguous ranges, one per worker thread
+ * - Each worker owns a WorkStealingQueue of variant indices
+ * - A worker that runs out of variants steals from the front of another
+ *   worker's queue, so slow variants (e.g. long windows, busy order books)
+ *   don't leave cores idle at the end of the sweep
+ *
+ * Each worker also owns a RunArena: the OrderManager and StatsCollector of a
+ * variant allocate from it, and it is reset in one step after each variant,
+ * so tens of thousands of short variants don't churn the global heap.
+ */
+class ParameterSweep {
+private:
+	TradeSeries ticks;                    // Trade ticks shared by all variants
+	QuoteSeries quotes;                   // Quote ticks shared by all variants
+	size_t threadCount = 0;               // Number of workers (0 = one per hardware thread)
+	size_t blockSize = 4096;              // Ticks gathered at a time when the data is columnar
+
+	/**
+	 * @brief Runs a single variant to completion and returns its statistics
+	 */
+	StatsMap runVariant(const SweepParams& params, const StrategyFactory& factory, TimeFrame tf, double initialCash, std::pmr::memory_resource* resource) const;
+
+	/**
+	 * @brief Runs variants 0..variantCount-1, the parameters of variant i given by paramsAt(i)
+	 */
+	std::vector<SweepResult> runVariants(size_t variantCount, const std::function<SweepParams(size_t)>& paramsAt, const StrategyFactory& factory, TimeFrame tf, double initialCash) const;
+
+public:
+	/**
+	 * @brief Creates a sweep over the given data
+	 *
+	 * The data is not copied - it must stay alive and unchanged until run() returns.
+	 * Both row data (spans) and columnar data are accepted.
+	 *
+	 * @param ticks Trade ticks for strategies derived from Strategy
+	 * @param quotes Quote ticks for strategies derived from QuoteStrategy
+	 */
+	ParameterSweep(TradeSeries ticks, QuoteSeries quotes = {});
+
+	/**
+	 * @brief Sets how many worker threads run() uses
+	 *
+	 * @param count Number of workers (0 = std::thread::hardware_concurrency())
+	 */
+	void setThreadCount(size_t count);
+
+	/**
+	 * @brief Runs every variant of the grid
+	 *
+	 * @param grid Parameter space to sweep
+	 * @param factory Builds the strategy for each point of the grid
+	 * @param tf Time frame used for the statistics
+	 * @param initialCash Starting capital of every variant
+	 * @return One result per grid point, ordered by grid index
+	 * @throws std::runtime_error If a variant has no data of the kind it consumes
+	 * @throws Any exception thrown by the factory or a strategy (the first one is rethrown)
+	 */
+	std::vector<SweepResult> run(const ParameterGrid& grid, const StrategyFactory& factory, TimeFrame tf, double initialCash) const;
+
+	/**
+	 * @brief Runs an explicit list of variants (e.g. one shard of a distributed sweep)
+	 *
+	 * Same as run() with a grid, result i being the run of variants[i].
+	 *
+	 * @param variants Parameter values of each variant
+	 * @param factory Builds the strategy for each variant
+	 * @param tf Time frame used for the statistics
+	 * @param initialCash Starting capital of every variant
+	 * @return One result per variant, in the order of variants
+	 * @throws std::runtime_error If a variant has no data of the kind it consumes
+	 * @throws Any exception thrown by the factory or a strategy (the first one is rethrown)
+	 */
+	std::vector<SweepResult> run(std::span<const SweepParams> variants, const StrategyFactory& factory, TimeFrame tf, double initialCash) const;
+};
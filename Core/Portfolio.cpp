@@ -0,0 +1,110 @@
+#include <cmath>
+
+#include "Portfolio.h"
+
+Portfolio::Portfolio(double capital, const RiskLimits& limits)
+	: capital(capital), limits(limits), cash(capital), net(1), marks(1), openIndex(1, NOT_OPEN) {
+	limits.validate();
+}
+
+/**
+ * @brief Extends the position table to include the given symbol
+ */
+void Portfolio::grow(SymbolId symbol) {
+	net.resize(size_t(symbol) + 1);
+	marks.resize(size_t(symbol) + 1);
+	openIndex.resize(size_t(symbol) + 1, NOT_OPEN);
+}
+
+void Portfolio::reserveSymbols(size_t count) {
+	if (net.size() < count) grow(static_cast<SymbolId>(count - 1));
+	openSymbols.reserve(count);
+}
+
+/**
+ * @brief Checks the order volume, then the position and leverage it would lead to
+ *
+ * The leverage check recomputes the gross exposure over the open symbols with
+ * the order's symbol at its new position, so it costs O(open symbols); it is
+ * skipped entirely when no leverage limit is set.
+ */
+bool Portfolio::approve(const Order& order) {
+	if (order.volume > limits.maxOrderVolume) {
+		rejected++;
+		return false;
+	}
+
+	const double current = getNetPosition(order.symbol);
+	const double next = current + (order.side == Order::Side::BUY ? order.volume : -order.volume);
+	if (std::abs(next) <= std::abs(current)) return true;  // Reduces the risk
+
+	if (std::abs(next) > limits.maxPosition) {
+		rejected++;
+		return false;
+	}
+
+	if (std::isfinite(limits.maxLeverage)) {
+		const double mark = order.symbol < marks.size() ? marks[order.symbol] : 0.0;
+		const double price = order.price > 0.0 ? order.price : mark;
+		const double gross = getGrossExposure() - std::abs(current) * mark + std::abs(next) * price;
+		const double value = getValue();
+		if (value <= 0.0 || gross > limits.maxLeverage * value) {
+			rejected++;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Nets an execution into the position table
+ *
+ * The symbol joins or leaves the open symbols when its net position becomes
+ * non-zero or flat (swap-and-pop, as in OrderManager).
+ */
+void Portfolio::onExecution(SymbolId symbol, double volume, double cashFlow) {
+	if (symbol >= net.size()) [[unlikely]] grow(symbol);
+
+	cash += cashFlow;
+	double& position = net[symbol];
+	position += volume;
+
+	if (position != 0.0 && openIndex[symbol] == NOT_OPEN) {
+		openIndex[symbol] = static_cast<uint32_t>(openSymbols.size());
+		openSymbols.push_back(symbol);
+	} else if (position == 0.0 && openIndex[symbol] != NOT_OPEN) {
+		const SymbolId last = openSymbols.back();
+		openSymbols[openIndex[symbol]] = last;
+		openIndex[last] = openIndex[symbol];
+		openSymbols.pop_back();
+		openIndex[symbol] = NOT_OPEN;
+	}
+}
+
+double Portfolio::getValue() const {
+	double value = cash;
+	for (SymbolId symbol : openSymbols) value += net[symbol] * marks[symbol];
+	return value;
+}
+
+double Portfolio::getGrossExposure() const {
+	double gross = 0.0;
+	for (SymbolId symbol : openSymbols) gross += std::abs(net[symbol]) * marks[symbol];
+	return gross;
+}
+
+double Portfolio::getNetPosition(SymbolId symbol) const {
+	return symbol < net.size() ? net[symbol] : 0.0;
+}
+
+double Portfolio::getCash() const {
+	return cash;
+}
+
+double Portfolio::getCapital() const {
+	return capital;
+}
+
+size_t Portfolio::getRejectedCount() const {
+	return rejected;
+}
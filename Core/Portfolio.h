@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "Tick.h"
+#include "Order.h"
+
+/**
+ * @brief Pre-trade limits of a portfolio, checked on every order submitted
+ *
+ * Position and exposure limits only stop orders that would increase the risk:
+ * an order bringing a position back towards flat is always accepted, even when
+ * the portfolio is already beyond a limit. Every limit is off (infinite) by
+ * default.
+ */
+struct RiskLimits {
+	double maxOrderVolume = std::numeric_limits<double>::infinity();  // Largest volume of a single order
+	double maxPosition = std::numeric_limits<double>::infinity();     // Largest absolute net position of a symbol, all strategies together
+	double maxLeverage = std::numeric_limits<double>::infinity();     // Largest gross exposure (sum of |net position| * price) over portfolio value
+
+	/**
+	 * @brief Checks that the limits make sense
+	 *
+	 * @throws std::invalid_argument If a limit is not positive
+	 */
+	void validate() const {
+		if (!(maxOrderVolume > 0.0) || !(maxPosition > 0.0) || !(maxLeverage > 0.0)) {
+			throw std::invalid_argument("Risk limits must be positive.");
+		}
+	}
+};
+
+/**
+ * @brief Shared capital and net positions of a book of strategies
+ *
+ * In portfolio mode (BacktestEngine::setPortfolioMode()) every strategy's
+ * OrderManager reports its executions here, so the positions of all
+ * strategies are netted per symbol against one cash balance, and asks here
+ * before accepting an order (approve()).
+ *
+ * The position table is a structure of arrays indexed by SymbolId: net
+ * positions, marks and the open-symbol index each live in their own
+ * contiguous array, and getValue() only walks the symbols with a non-zero
+ * net position. Valuing the whole book costs O(open symbols) per tick,
+ * however many strategies trade them.
+ *
+ * Not thread-safe: the engine drives a portfolio from a single event loop.
+ */
+class Portfolio {
+private:
+	static constexpr uint32_t NOT_OPEN = UINT32_MAX;  // openIndex of a flat symbol
+
+	double capital;                     // Starting cash of the book
+	RiskLimits limits;
+	double cash;                        // capital + cash flow of every execution (fees included)
+
+	// Position table, indexed by SymbolId
+	std::vector<double> net;            // Net position of all strategies together
+	std::vector<double> marks;          // Last price of the symbol
+	std::vector<uint32_t> openIndex;    // Position in openSymbols (NOT_OPEN if flat)
+	std::vector<SymbolId> openSymbols;  // Symbols with a non-zero net position
+
+	size_t rejected = 0;                // Orders refused by approve()
+
+	void grow(SymbolId symbol);         // Out of line: only runs the first time a symbol is seen
+
+public:
+	/**
+	 * @brief Creates a flat portfolio
+	 *
+	 * @param capital Starting cash shared by every strategy
+	 * @param limits Pre-trade limits
+	 * @throws std::invalid_argument If a limit is not positive
+	 */
+	explicit Portfolio(double capital, const RiskLimits& limits = {});
+
+	/**
+	 * @brief Sizes the position table for symbols [0, count)
+	 *
+	 * @param count Number of symbols
+	 */
+	void reserveSymbols(size_t count);
+
+	/**
+	 * @brief Records the last price of a symbol
+	 *
+	 * @param symbol Instrument
+	 * @param price Trade price or mid-quote
+	 */
+	void mark(SymbolId symbol, double price) {
+		if (symbol >= marks.size()) [[unlikely]] grow(symbol);
+		marks[symbol] = price;
+	}
+
+	/**
+	 * @brief Pre-trade check of an order against the limits
+	 *
+	 * The order is assumed to fill in full at its price (at the mark for a
+	 * MARKET order without a price). Positions are the executed ones: LIMIT
+	 * orders are checked when submitted, not again when they fill.
+	 *
+	 * @param order Order about to be submitted
+	 * @return true if the order may go to the market; false (and counted) otherwise
+	 */
+	bool approve(const Order& order);
+
+	/**
+	 * @brief Books an execution of one of the strategies
+	 *
+	 * @param symbol Instrument traded
+	 * @param volume Signed volume (positive = bought, negative = sold)
+	 * @param cashFlow Cash received (negative when paying), fees included
+	 */
+	void onExecution(SymbolId symbol, double volume, double cashFlow);
+
+	/**
+	 * @brief Returns the value of the book: cash + sum(net position * mark)
+	 */
+	double getValue() const;
+
+	/**
+	 * @brief Returns the gross exposure: sum(|net position| * mark)
+	 */
+	double getGrossExposure() const;
+
+	/**
+	 * @brief Returns the net position of a symbol, all strategies together
+	 */
+	double getNetPosition(SymbolId symbol) const;
+
+	/**
+	 * @brief Returns the shared cash balance
+	 */
+	double getCash() const;
+
+	/**
+	 * @brief Returns the starting cash
+	 */
+	double getCapital() const;
+
+	/**
+	 * @brief Returns the number of orders refused by approve()
+	 */
+	size_t getRejectedCount() const;
+};
@@ -0,0 +1,108 @@
+#include <fstream>
+#include <stdexcept>
+
+#include "Profiler.h"
+
+double ProfileClockCalibration::nanosPerCount() const {
+#if defined(__x86_64__)
+	const uint64_t counts = profileClock() - startCount;
+	const double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+	return counts > 0 ? nanos / static_cast<double>(counts) : 1.0;
+#else
+	return 1.0;  // The clock already counts nanoseconds
+#endif
+}
+
+/**
+ * @brief Returns the value a bucket stands for: the middle of its range
+ *
+ * Buckets below SUB_COUNT hold one value each. Above, bucket (o, s) of octave
+ * o >= 1 covers [(SUB_COUNT + s) << (o - 1), (SUB_COUNT + s + 1) << (o - 1)).
+ */
+double LatencyHistogram::bucketMidpoint(size_t bucket) {
+	if (bucket < SUB_COUNT) return static_cast<double>(bucket);
+	const unsigned shift = static_cast<unsigned>(bucket / SUB_COUNT) - 1;
+	const uint64_t lower = (SUB_COUNT + bucket % SUB_COUNT) << shift;
+	return static_cast<double>(lower) + static_cast<double>(uint64_t(1) << shift) / 2.0;
+}
+
+double LatencyHistogram::mean() const {
+	const uint64_t n = count();
+	return n > 0 ? static_cast<double>(sum.load(std::memory_order_relaxed)) / static_cast<double>(n) : 0.0;
+}
+
+/**
+ * @brief Walks the buckets until q of the values are covered
+ *
+ * The result never exceeds the exact maximum, so the top percentiles of a
+ * histogram with few samples don't overshoot past the largest value seen.
+ */
+double LatencyHistogram::percentile(double q) const {
+	const uint64_t n = count();
+	if (n == 0) return 0.0;
+
+	q = q < 0.0 ? 0.0 : (q > 1.0 ? 1.0 : q);
+	uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(n) + 0.5);
+	if (rank < 1) rank = 1;
+	if (rank > n) rank = n;
+
+	uint64_t seen = 0;
+	for (size_t bucket = 0; bucket < BUCKETS; bucket++) {
+		seen += counts[bucket].load(std::memory_order_relaxed);
+		if (seen >= rank) {
+			const double value = bucketMidpoint(bucket);
+			const double top = static_cast<double>(max());
+			return value < top ? value : top;
+		}
+	}
+	return static_cast<double>(max());  // Counters read mid-update by a concurrent reader
+}
+
+void LatencyHistogram::reset() {
+	for (std::atomic<uint64_t>& c : counts) c.store(0, std::memory_order_relaxed);
+	total.store(0, std::memory_order_relaxed);
+	sum.store(0, std::memory_order_relaxed);
+	largest.store(0, std::memory_order_relaxed);
+}
+
+const char* probeName(Probe probe) {
+	switch (probe) {
+	case Probe::ON_TICK: return "onTick";
+	case Probe::HANDLE_TICK: return "handleTick";
+	case Probe::RECORD_PNL: return "recordPnL";
+	}
+	return "unknown";
+}
+
+std::vector<ProfileReport> summarizeProfile(const std::string& strategy, const StrategyProfile& profile, double nanosPerCount) {
+	std::vector<ProfileReport> reports;
+	reports.reserve(PROBE_COUNT);
+	for (size_t p = 0; p < PROBE_COUNT; p++) {
+		const LatencyHistogram& histogram = profile.probes[p];
+		reports.push_back(ProfileReport{
+			strategy,
+			static_cast<Probe>(p),
+			histogram.count(),
+			histogram.mean() * nanosPerCount,
+			histogram.percentile(0.50) * nanosPerCount,
+			histogram.percentile(0.90) * nanosPerCount,
+			histogram.percentile(0.99) * nanosPerCount,
+			histogram.percentile(0.999) * nanosPerCount,
+			static_cast<double>(histogram.max()) * nanosPerCount
+		});
+	}
+	return reports;
+}
+
+void exportProfileToCSV(const std::string& filename, std::span<const ProfileReport> reports) {
+	std::ofstream file(filename);
+	if (!file.is_open()) throw std::runtime_error("Cannot open profile file '" + filename + "'");
+
+	file << "Probe,Samples,Mean_ns,P50_ns,P90_ns,P99_ns,P99.9_ns,Max_ns\n";
+	for (const ProfileReport& report : reports) {
+		file << probeName(report.probe) << "," << report.samples << "," << report.meanNs << ","
+			<< report.p50Ns << "," << report.p90Ns << "," << report.p99Ns << ","
+			<< report.p999Ns << "," << report.maxNs << "\n";
+	}
+	if (!file) throw std::runtime_error("Cannot write profile file '" + filename + "'");
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Hot-path instrumentation switch (CMake option BACKTEST_INSTRUMENT)
+ *
+ * When 0 (the default), the probes around the per-tick steps are not compiled
+ * at all and the tick loops are exactly the uninstrumented ones.
+ */
+#ifndef BACKTEST_INSTRUMENT
+#define BACKTEST_INSTRUMENT 0
+#endif
+
+/**
+ * @brief Reads the profiling clock
+ *
+ * The time stamp counter on x86-64 (a few cycles, no system call),
+ * steady_clock nanoseconds elsewhere. Counts are converted to nanoseconds
+ * when reported, see ProfileClockCalibration.
+ */
+inline uint64_t profileClock() {
+#if defined(__x86_64__)
+	return __rdtsc();
+#else
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * @brief Converts profile clock counts to nanoseconds
+ *
+ * Started at the beginning of a run; the ratio of elapsed steady_clock time
+ * to elapsed counts is measured when the results are reported, so the run
+ * itself is the calibration interval.
+ */
+class ProfileClockCalibration {
+private:
+	uint64_t startCount = profileClock();
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+public:
+	/**
+	 * @brief Returns the nanoseconds per clock count measured since construction
+	 */
+	double nanosPerCount() const;
+};
+
+/**
+ * @brief Lock-free HDR-style histogram of latencies
+ *
+ * Log-linear buckets: values below 32 are counted exactly, above that every
+ * power of two is split into 32 sub-buckets, so any recorded value is known
+ * within 1/32 (~3%) whatever its magnitude. Values up to 2^40 counts (minutes
+ * of TSC) are distinguished; larger ones land in the last bucket. Recording
+ * is one bucket computation and a few relaxed atomic stores: no lock, no
+ * allocation, and a reader may take percentiles while a run is in progress.
+ *
+ * Single writer: record() must not be called from two threads at once (each
+ * strategy's histograms are only written by the worker running it).
+ */
+class LatencyHistogram {
+private:
+	static constexpr unsigned SUB_BITS = 5;                      // 32 sub-buckets per power of two
+	static constexpr uint64_t SUB_COUNT = uint64_t(1) << SUB_BITS;
+	static constexpr unsigned MAX_BITS = 40;                     // Values are clamped below 2^40
+	static constexpr size_t BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_COUNT;
+
+	std::array<std::atomic<uint64_t>, BUCKETS> counts{};
+	std::atomic<uint64_t> total{ 0 };  // Number of values recorded
+	std::atomic<uint64_t> sum{ 0 };    // Sum of the values (for the mean)
+	std::atomic<uint64_t> largest{ 0 };
+
+	static size_t bucketOf(uint64_t value) {
+		if (value < SUB_COUNT) return static_cast<size_t>(value);
+		if (value >= (uint64_t(1) << MAX_BITS)) value = (uint64_t(1) << MAX_BITS) - 1;
+		const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - 1 - SUB_BITS;
+		return static_cast<size_t>((shift + 1) * SUB_COUNT + ((value >> shift) - SUB_COUNT));
+	}
+
+	static double bucketMidpoint(size_t bucket);
+
+	// Single writer, so a plain load + store is enough (no locked read-modify-write)
+	static void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+		counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+public:
+	/**
+	 * @brief Records one latency
+	 *
+	 * @param value Elapsed profile clock counts
+	 */
+	void record(uint64_t value) {
+		bump(counts[bucketOf(value)], 1);
+		bump(total, 1);
+		bump(sum, value);
+		if (value > largest.load(std::memory_order_relaxed)) largest.store(value, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Returns the number of values recorded
+	 */
+	uint64_t count() const { return total.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Returns the mean of the values recorded (0 if none)
+	 */
+	double mean() const;
+
+	/**
+	 * @brief Returns the largest value recorded (exact, 0 if none)
+	 */
+	uint64_t max() const { return largest.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Returns the value below which a fraction q of the values lie
+	 *
+	 * @param q Quantile in [0, 1] (0.5 = median, 0.99 = 99th percentile)
+	 * @return Midpoint of the bucket holding the quantile (0 if nothing was recorded)
+	 */
+	double percentile(double q) const;
+
+	/**
+	 * @brief Forgets every value recorded (not thread-safe with record())
+	 */
+	void reset();
+};
+
+/**
+ * @brief Steps of the tick loop that are timed
+ */
+enum class Probe {
+	ON_TICK,      // Strategy::onTick() (onBar() for bar strategies fed by the pipeline)
+	HANDLE_TICK,  // OrderManager::handleTick(): order arrival and matching
+	RECORD_PNL    // Portfolio valuation and StatsCollector::recordPnL()
+};
+
+constexpr size_t PROBE_COUNT = 3;
+
+/**
+ * @brief Returns the name of a probe as written in reports ("onTick", "handleTick", "recordPnL")
+ */
+const char* probeName(Probe probe);
+
+/**
+ * @brief Latency histograms of one strategy, one per probe
+ */
+struct StrategyProfile {
+	std::array<LatencyHistogram, PROBE_COUNT> probes;
+
+	/**
+	 * @brief Records one timed tick from the clock readings taken around its steps
+	 */
+	void record(uint64_t start, uint64_t afterOnTick, uint64_t afterHandleTick, uint64_t end) {
+		probes[size_t(Probe::ON_TICK)].record(afterOnTick - start);
+		probes[size_t(Probe::HANDLE_TICK)].record(afterHandleTick - afterOnTick);
+		probes[size_t(Probe::RECORD_PNL)].record(end - afterHandleTick);
+	}
+
+	/**
+	 * @brief Forgets every value recorded
+	 */
+	void reset() {
+		for (LatencyHistogram& histogram : probes) histogram.reset();
+	}
+};
+
+/**
+ * @brief Latency summary of one probe of one strategy, in nanoseconds
+ */
+struct ProfileReport {
+	std::string strategy;  // Strategy name
+	Probe probe;           // Timed step
+	uint64_t samples;      // Number of timed ticks
+	double meanNs;
+	double p50Ns;
+	double p90Ns;
+	double p99Ns;
+	double p999Ns;
+	double maxNs;
+};
+
+/**
+ * @brief Summarizes the histograms of one strategy
+ *
+ * @param strategy Strategy name
+ * @param profile Its histograms
+ * @param nanosPerCount Clock calibration (see ProfileClockCalibration)
+ * @return One report per probe
+ */
+std::vector<ProfileReport> summarizeProfile(const std::string& strategy, const StrategyProfile& profile, double nanosPerCount);
+
+/**
+ * @brief Writes the reports of one strategy as CSV
+ *
+ * Format: Probe,Samples,Mean_ns,P50_ns,P90_ns,P99_ns,P99.9_ns,Max_ns
+ * (one row per probe).
+ *
+ * @param filename Output file path
+ * @param reports Reports returned by summarizeProfile()
+ * @throws std::runtime_error If the file can't be written
+ */
+void exportProfileToCSV(const std::string& filename, std::span<const ProfileReport> reports);
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Order.h"
+
+/**
+ * @brief Bounded lock-free queue between exactly one producer and one consumer
+ *
+ * A ring of 2^k slots indexed by two ever-increasing counters: the producer
+ * owns head, the consumer owns tail, and each only reads the other's with
+ * acquire loads. The producer keeps its last view of tail, so a push only
+ * touches the consumer's cache line when the ring looked full. Neither side
+ * ever blocks or allocates: a push on a full ring fails instead.
+ *
+ * @tparam T Trivially copyable element
+ */
+template<typename T>
+class SpscRing {
+	static_assert(std::is_trivially_copyable_v<T>, "Ring elements must be trivially copyable");
+
+private:
+	static constexpr size_t LINE = 64;  // Keeps the two sides' counters on separate cache lines
+
+	std::unique_ptr<T[]> slots;
+	size_t mask;                                   // Capacity - 1
+
+	alignas(LINE) std::atomic<size_t> head{ 0 };   // Next slot written (producer)
+	size_t cachedTail = 0;                         // Producer's last view of tail
+	alignas(LINE) std::atomic<size_t> tail{ 0 };   // Next slot read (consumer)
+
+public:
+	/**
+	 * @brief Creates an empty ring
+	 *
+	 * @param capacity Number of slots, a power of two
+	 * @throws std::invalid_argument If capacity is not a power of two
+	 */
+	explicit SpscRing(size_t capacity) : slots(std::make_unique<T[]>(capacity)), mask(capacity - 1) {
+		if (capacity == 0 || (capacity & mask) != 0) throw std::invalid_argument("Ring capacity must be a power of two.");
+	}
+
+	SpscRing(const SpscRing&) = delete;
+	SpscRing& operator=(const SpscRing&) = delete;
+
+	/**
+	 * @brief Appends an element (producer only)
+	 *
+	 * @return false if the ring is full (the element is not added)
+	 */
+	bool tryPush(const T& value) {
+		const size_t at = head.load(std::memory_order_relaxed);
+		if (at - cachedTail > mask) {
+			cachedTail = tail.load(std::memory_order_acquire);
+			if (at - cachedTail > mask) return false;
+		}
+		slots[at & mask] = value;
+		head.store(at + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Hands every element published so far to a callback, oldest first (consumer only)
+	 *
+	 * @return Number of elements consumed
+	 */
+	template<typename Consume>
+	size_t drain(Consume&& consume) {
+		const size_t from = tail.load(std::memory_order_relaxed);
+		const size_t to = head.load(std::memory_order_acquire);
+		for (size_t at = from; at != to; at++) consume(slots[at & mask]);
+		tail.store(to, std::memory_order_release);
+		return to - from;
+	}
+
+	/**
+	 * @brief Returns the number of slots
+	 */
+	size_t capacity() const { return mask + 1; }
+};
+
+/**
+ * @brief Something that happened in a running strategy, as seen by a progress observer
+ */
+struct ProgressEvent {
+	enum class Type : uint8_t {
+		PROGRESS,  // Ticks processed so far, and the portfolio value after them (one per block)
+		FILL       // An execution
+	};
+
+	Type type;
+	uint64_t ticks;  // Ticks the strategy has processed (PROGRESS)
+	double pnl;      // Portfolio value after them (PROGRESS)
+	Fill fill;       // The execution (FILL)
+};
+
+/**
+ * @brief Live events of one strategy, from the worker running it to an observer
+ *
+ * The worker publishes a PROGRESS event at the end of every block (so the
+ * PnL curve arrives downsampled to one point per block) and, from its
+ * OrderManager, a FILL event per execution. Publishing never waits: if the
+ * observer falls behind and the ring fills up, events are dropped and
+ * counted, and the backtest runs at full speed.
+ */
+class ProgressChannel {
+private:
+	SpscRing<ProgressEvent> ring;
+	std::atomic<uint64_t> dropped{ 0 };  // Written by the producer only
+
+public:
+	/**
+	 * @brief Creates a channel
+	 *
+	 * @param capacity Events buffered between two drains, a power of two
+	 * @throws std::invalid_argument If capacity is not a power of two
+	 */
+	explicit ProgressChannel(size_t capacity = 4096) : ring(capacity) {}
+
+	/**
+	 * @brief Publishes an event (producer only, never blocks)
+	 */
+	void publish(const ProgressEvent& event) {
+		if (!ring.tryPush(event)) [[unlikely]] {
+			dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * @brief Appends the events published since the last drain to out (consumer only)
+	 *
+	 * @return Number of events appended
+	 */
+	size_t drain(std::vector<ProgressEvent>& out) {
+		return ring.drain([&](const ProgressEvent& event) { out.push_back(event); });
+	}
+
+	/**
+	 * @brief Returns the number of events lost because the channel was full
+	 */
+	uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "ResultFile.h"
+
+namespace {
+
+constexpr char RESULT_FILE_MAGIC[8] = { 'B', 'T', 'R', 'S', 'L', 'T', 'S', '\0' };
+constexpr size_t WRITE_BUFFER_BYTES = size_t(1) << 16;
+
+/**
+ * @brief Builds an error message with the path and the system error text
+ */
+std::runtime_error fileError(const std::string& what, const std::string& path) {
+	return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+
+/**
+ * @brief Size in bytes of one value of a column type
+ */
+size_t sizeOf(ResultColumnType type) {
+	switch (type) {
+	case ResultColumnType::FLOAT64: return sizeof(double);
+	case ResultColumnType::UINT64: return sizeof(uint64_t);
+	case ResultColumnType::UINT16: return sizeof(uint16_t);
+	case ResultColumnType::INT8: return sizeof(int8_t);
+	}
+	return 0;
+}
+
+/**
+ * @brief FILE wrapper collecting small writes in a fixed buffer
+ *
+ * Writes at least as large as the buffer go straight to the file.
+ * Errors are remembered and reported by close().
+ */
+class BufferedWriter {
+private:
+	FILE* file;
+	std::vector<char> buffer;
+	size_t used = 0;
+	bool ok = true;
+
+public:
+	explicit BufferedWriter(FILE* file) : file(file), buffer(WRITE_BUFFER_BYTES) {}
+
+	void flush() {
+		if (used != 0) ok = std::fwrite(buffer.data(), 1, used, file) == used && ok;
+		used = 0;
+	}
+
+	void write(const void* data, size_t bytes) {
+		if (bytes >= buffer.size()) {
+			flush();
+			ok = std::fwrite(data, 1, bytes, file) == bytes && ok;
+			return;
+		}
+		if (used + bytes > buffer.size()) flush();
+		std::memcpy(buffer.data() + used, data, bytes);
+		used += bytes;
+	}
+
+	template<typename T>
+	void value(T v) { write(&v, sizeof(v)); }
+
+	void pad(size_t bytes) {
+		static constexpr char zeros[8] = {};
+		write(zeros, bytes);
+	}
+
+	/**
+	 * @brief Flushes and closes the file, returns false if any write failed
+	 */
+	bool close() {
+		flush();
+		return (std::fclose(file) == 0) && ok;
+	}
+};
+
+/**
+ * @brief One column of the file: its directory entry and how to write its values
+ */
+struct Column {
+	const char* name;
+	ResultColumnType type;
+	size_t count;
+	std::function<void(BufferedWriter&)> write;
+};
+
+} // namespace
+
+/**
+ * @brief Buckets the interior ticks and keeps the lowest and highest of each
+ *
+ * The first and last ticks are always kept. The ticks in between are cut into
+ * (maxPoints - 2) / 2 buckets of (nearly) equal length, and each bucket
+ * contributes the tick of its lowest and of its highest value.
+ */
+std::vector<uint64_t> decimateSeries(std::span<const double> series, size_t maxPoints) {
+	if (maxPoints != 0 && maxPoints < 4) throw std::invalid_argument("maxPoints must be 0 or at least 4.");
+
+	std::vector<uint64_t> kept;
+	if (maxPoints == 0 || series.size() <= maxPoints) {
+		kept.resize(series.size());
+		for (size_t i = 0; i < kept.size(); i++) kept[i] = i;
+		return kept;
+	}
+
+	const size_t interior = series.size() - 2;
+	const size_t buckets = (maxPoints - 2) / 2;
+
+	kept.reserve(maxPoints);
+	kept.push_back(0);
+	for (size_t b = 0; b < buckets; b++) {
+		const size_t begin = 1 + interior * b / buckets;
+		const size_t end = 1 + interior * (b + 1) / buckets;
+		if (begin == end) continue;
+
+		size_t low = begin, high = begin;
+		for (size_t i = begin + 1; i < end; i++) {
+			if (series[i] < series[low]) low = i;
+			if (series[i] > series[high]) high = i;
+		}
+		kept.push_back(std::min(low, high));
+		if (low != high) kept.push_back(std::max(low, high));
+	}
+	kept.push_back(series.size() - 1);
+	return kept;
+}
+
+/**
+ * @brief Lays out the column directory, then streams every column through one buffer
+ */
+void writeResultFile(const std::string& path, const StatsCollector& stats, std::span<const Fill> fills, size_t maxPoints) {
+	if (maxPoints != 0 && maxPoints < 4) throw std::invalid_argument("maxPoints must be 0 or at least 4.");
+
+	const std::span<const double> pnl = stats.getPnLSeries();
+	const std::span<const double> returns = stats.getReturnsSeries();
+	const size_t rows = pnl.size();
+	const std::vector<uint64_t> kept = maxPoints != 0 ? decimateSeries(pnl, maxPoints) : std::vector<uint64_t>{};
+
+	std::vector<Column> columns = {
+		{ "index", ResultColumnType::UINT64, rows, [&](BufferedWriter& out) {
+			for (uint64_t i = 0; i < rows; i++) out.value(i);
+		} },
+		{ "pnl", ResultColumnType::FLOAT64, rows, [&](BufferedWriter& out) {
+			out.write(pnl.data(), pnl.size() * sizeof(double));
+		} },
+		{ "return", ResultColumnType::FLOAT64, rows, [&](BufferedWriter& out) {
+			if (rows == 0) return;
+			out.value(0.0);
+			out.write(returns.data(), returns.size() * sizeof(double));
+		} },
+		{ "fill_time", ResultColumnType::UINT64, fills.size(), [&](BufferedWriter& out) {
+			for (const Fill& fill : fills) out.value(fill.timestamp);
+		} },
+		{ "fill_order", ResultColumnType::UINT64, fills.size(), [&](BufferedWriter& out) {
+			for (const Fill& fill : fills) out.value(fill.orderId);
+		} },
+		{ "fill_price", ResultColumnType::FLOAT64, fills.size(), [&](BufferedWriter& out) {
+			for (const Fill& fill : fills) out.value(fill.price);
+		} },
+		{ "fill_volume", ResultColumnType::FLOAT64, fills.size(), [&](BufferedWriter& out) {
+			for (const Fill& fill : fills) out.value(fill.volume);
+		} },
+		{ "fill_side", ResultColumnType::INT8, fills.size(), [&](BufferedWriter& out) {
+			for (const Fill& fill : fills) out.value<int8_t>(fill.side == Order::Side::BUY ? 1 : -1);
+		} },
+		{ "fill_symbol", ResultColumnType::UINT16, fills.size(), [&](BufferedWriter& out) {
+			for (const Fill& fill : fills) out.value<uint16_t>(fill.symbol);
+		} },
+		{ "fill_fee", ResultColumnType::FLOAT64, fills.size(), [&](BufferedWriter& out) {
+			for (const Fill& fill : fills) out.value(fill.fee);
+		} },
+	};
+	if (maxPoints != 0) {
+		columns.push_back({ "chart_index", ResultColumnType::UINT64, kept.size(), [&](BufferedWriter& out) {
+			out.write(kept.data(), kept.size() * sizeof(uint64_t));
+		} });
+		columns.push_back({ "chart_pnl", ResultColumnType::FLOAT64, kept.size(), [&](BufferedWriter& out) {
+			for (uint64_t tick : kept) out.value(pnl[tick]);
+		} });
+	}
+
+	// Column data follows the directory, each column starting on an 8-byte boundary
+	ResultFileHeader header{};
+	std::memcpy(header.magic, RESULT_FILE_MAGIC, sizeof(header.magic));
+	header.version = RESULT_FILE_VERSION;
+	header.columnCount = static_cast<uint32_t>(columns.size());
+	header.seriesCount = stats.getPnLCount();
+	header.maxPoints = maxPoints;
+
+	std::vector<ResultColumnHeader> directory(columns.size());
+	std::vector<size_t> padding(columns.size());
+	uint64_t offset = sizeof(ResultFileHeader) + columns.size() * sizeof(ResultColumnHeader);
+	for (size_t c = 0; c < columns.size(); c++) {
+		const size_t bytes = columns[c].count * sizeOf(columns[c].type);
+		std::strncpy(directory[c].name, columns[c].name, sizeof(directory[c].name));
+		directory[c].type = static_cast<uint32_t>(columns[c].type);
+		directory[c].count = columns[c].count;
+		directory[c].offset = offset;
+		padding[c] = (8 - bytes % 8) % 8;
+		offset += bytes + padding[c];
+	}
+
+	FILE* file = std::fopen(path.c_str(), "wb");
+	if (!file) throw fileError("Cannot create result file", path);
+
+	BufferedWriter out(file);
+	out.write(&header, sizeof(header));
+	out.write(directory.data(), directory.size() * sizeof(ResultColumnHeader));
+	for (size_t c = 0; c < columns.size(); c++) {
+		columns[c].write(out);
+		out.pad(padding[c]);
+	}
+
+	if (!out.close()) throw fileError("Cannot write result file", path);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Order.h"
+#include "StatsCollector.h"
+
+/**
+ * @brief Format of the per-tick results written by BacktestEngine::runAll()
+ *
+ * CSV: <name>_pnl.csv, one "index,value" text line per tick.
+ * BINARY: <name>_results.bin, columnar binary written by writeResultFile().
+ * Both formats come with the <name>_statistics.csv summary.
+ */
+enum class ResultFormat { CSV, BINARY };
+
+/**
+ * @brief Element type of a result file column
+ */
+enum class ResultColumnType : uint32_t {
+	FLOAT64 = 1,  // double
+	UINT64 = 2,   // uint64_t
+	UINT16 = 3,   // uint16_t
+	INT8 = 4      // int8_t
+};
+
+/**
+ * @brief Header at the start of every result file
+ *
+ * File layout:
+ * - ResultFileHeader (32 bytes)
+ * - columnCount ResultColumnHeader entries (40 bytes each)
+ * - The data of each column, in directory order: count values of its type
+ *   (native byte order), padded to a multiple of 8 bytes
+ *
+ * Each column is one contiguous array, so a reader gets a whole column with
+ * one read (or zero-copy from a mapping), without parsing any text.
+ */
+struct ResultFileHeader {
+	char magic[8];          // "BTRSLTS\0"
+	uint32_t version;       // Format version (RESULT_FILE_VERSION)
+	uint32_t columnCount;   // Number of entries in the column directory
+	uint64_t seriesCount;   // PnL values recorded in the run
+	uint64_t maxPoints;     // Decimation limit of the chart columns (0 = no chart columns)
+};
+
+/**
+ * @brief Column directory entry of a result file
+ */
+struct ResultColumnHeader {
+	char name[16];          // Column name, NUL-padded
+	uint32_t type;          // ResultColumnType of the values
+	uint32_t reserved;      // Always 0
+	uint64_t count;         // Number of values
+	uint64_t offset;        // Byte offset of the first value from the start of the file
+};
+
+static_assert(sizeof(ResultFileHeader) == 32, "ResultFileHeader must stay 32 bytes");
+static_assert(sizeof(ResultColumnHeader) == 40, "ResultColumnHeader must stay 40 bytes");
+
+constexpr uint32_t RESULT_FILE_VERSION = 2;
+
+/**
+ * @brief Picks the points of a series to keep for charting
+ *
+ * Min/max decimation: apart from the first and last points, the series is
+ * cut into (maxPoints - 2) / 2 buckets and only the lowest and highest value
+ * of each bucket are kept, so spikes and drawdowns stay visible.
+ *
+ * @param series Values, one per tick
+ * @param maxPoints Largest number of points (0 = all, otherwise at least 4)
+ * @return Indices of the kept points, increasing (every index if the series already fits)
+ * @throws std::invalid_argument If maxPoints is 1, 2 or 3
+ */
+std::vector<uint64_t> decimateSeries(std::span<const double> series, size_t maxPoints);
+
+/**
+ * @brief Writes the results of one strategy to a columnar binary file
+ *
+ * Columns:
+ * - index (UINT64): tick index of each series row
+ * - pnl (FLOAT64): portfolio value at that tick
+ * - return (FLOAT64): return from the previous tick (0 on tick 0)
+ * - chart_index (UINT64), chart_pnl (FLOAT64): the PnL series decimated for
+ *   charting, only with maxPoints set
+ * - fill_time (UINT64), fill_order (UINT64), fill_price (FLOAT64),
+ *   fill_volume (FLOAT64), fill_side (INT8, +1 = BUY, -1 = SELL),
+ *   fill_symbol (UINT16), fill_fee (FLOAT64): one row per execution
+ *
+ * The series columns are empty if the collector did not store the series.
+ * They always hold every tick: with maxPoints set, the chart columns are
+ * added next to them, the PnL series decimated to at most maxPoints rows (see
+ * decimateSeries()), so a chart reads a few thousand values and a download
+ * still gets every tick. Fills are never decimated.
+ *
+ * Values are written through a fixed-size buffer (or straight from the
+ * series when there is nothing to convert), in a handful of fwrite() calls.
+ *
+ * @param path Output file path (overwritten if it exists)
+ * @param stats Collector of the strategy
+ * @param fills Executions of the strategy (OrderManager::getFills())
+ * @param maxPoints Largest number of chart rows (0 = no chart columns, otherwise at least 4)
+ * @throws std::invalid_argument If maxPoints is 1, 2 or 3
+ * @throws std::runtime_error If the file can't be written
+ */
+void writeResultFile(const std::string& path, const StatsCollector& stats, std::span<const Fill> fills, size_t maxPoints = 0);
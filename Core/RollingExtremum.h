@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "StateBuffer.h"
+
+/**
+ * @brief Rolling maximum or minimum over the last N values in amortized O(1)
+ *
+ * Classic monotonic deque: the window keeps only the values that can still
+ * become the extremum. When a new value arrives, every value at the back that
+ * it beats (or equals) is dropped, because it can never be the extremum again
+ * while the newer value is in the window. The front is therefore always the
+ * extremum of the window, and each value is pushed and popped at most once.
+ *
+ * The deque never holds more than N entries, so it is stored in a fixed ring
+ * buffer allocated once in the constructor - no allocation while running, and
+ * the entries stay contiguous in memory (unlike std::deque chunks).
+ *
+ * Cost per push is the same for a window of 20 or 20,000 values.
+ *
+ * @tparam Compare std::greater<double> for a rolling max, std::less<double> for a rolling min
+ */
+template<typename Compare>
+class RollingExtremum {
+private:
+	/**
+	 * @brief A candidate extremum and the position at which it entered the window
+	 */
+	struct Entry {
+		uint64_t index;   // Sequence number of the value (0 for the first value pushed)
+		double value;     // The value itself
+	};
+
+	std::vector<Entry> ring;   // Ring buffer holding the monotonic deque (capacity = window)
+	size_t window;             // Number of most recent values covered
+	size_t head = 0;           // Ring position of the front (current extremum)
+	size_t count = 0;          // Number of entries in the deque
+	uint64_t pushed = 0;       // Total number of values pushed so far
+	Compare better;            // better(a, b) is true if a beats b (a > b for a max)
+
+	size_t at(size_t offset) const { return (head + offset) % window; }
+
+public:
+	/**
+	 * @brief Creates a rolling extremum over the given number of values
+	 *
+	 * @param window Number of most recent values covered (must be > 0)
+	 */
+	explicit RollingExtremum(size_t window) : ring(window), window(window) {
+		if (window == 0) throw std::invalid_argument("Rolling window must be greater than 0.");
+	}
+
+	/**
+	 * @brief Adds a value; the oldest value leaves the window once it is full
+	 *
+	 * @param value The new value
+	 */
+	void push(double value) {
+		// Expire the front if it slides out of the window with this value
+		// (done first, so the ring never has to hold more than `window` entries)
+		if (count > 0 && ring[head].index + window <= pushed) {
+			head = at(1);
+			count--;
+		}
+
+		// Drop the values at the back that the new value beats - they can never be the extremum again
+		while (count > 0 && !better(ring[at(count - 1)].value, value)) {
+			count--;
+		}
+
+		ring[at(count)] = Entry{ pushed, value };
+		count++;
+		pushed++;
+	}
+
+	/**
+	 * @brief Returns the extremum of the values currently in the window
+	 *
+	 * Only meaningful once at least one value has been pushed.
+	 */
+	double value() const {
+		return ring[head].value;
+	}
+
+	/**
+	 * @brief Returns the number of values currently covered (at most the window size)
+	 */
+	size_t size() const {
+		return pushed < window ? static_cast<size_t>(pushed) : window;
+	}
+
+	/**
+	 * @brief Returns true once the window holds its full number of values
+	 */
+	bool full() const {
+		return pushed >= window;
+	}
+
+	/**
+	 * @brief Forgets all values (the ring buffer is kept)
+	 */
+	void clear() {
+		head = 0;
+		count = 0;
+		pushed = 0;
+	}
+
+	/**
+	 * @brief Saves the window contents (see Strategy::saveState())
+	 */
+	void save(StateWriter& out) const {
+		out.write(ring);
+		out.write(head);
+		out.write(count);
+		out.write(pushed);
+	}
+
+	/**
+	 * @brief Restores contents saved by save() into a window of the same size
+	 * 
+	 * @throws std::runtime_error If the saved window has another size
+	 */
+	void restore(StateReader& in) {
+		in.read(ring);
+		if (ring.size() != window) throw std::runtime_error("Rolling window state has the wrong size.");
+		in.read(head);
+		in.read(count);
+		in.read(pushed);
+	}
+};
+
+/**
+ * @brief Rolling maximum of the last N values
+ */
+using RollingMax = RollingExtremum<std::greater<double>>;
+
+/**
+ * @brief Rolling minimum of the last N values
+ */
+using RollingMin = RollingExtremum<std::less<double>>;
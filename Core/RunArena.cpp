@@ -0,0 +1,23 @@
+#include "RunArena.h"
+
+RunArena::RunArena(size_t initialSize) : bufferSize(initialSize) {
+	if (initialSize == 0) throw std::invalid_argument("Arena size must be positive.");
+	buffer = std::make_unique_for_overwrite<std::byte[]>(initialSize);
+	arena.emplace(buffer.get(), bufferSize, &overflow);
+}
+
+/**
+ * @brief Drops the monotonic resource (returning its overflow chunks), resizes the buffer if needed and starts over
+ */
+void RunArena::reset() {
+	const size_t needed = bufferSize + overflow.bytes;
+	arena.reset();
+	overflow.bytes = 0;
+
+	if (needed > bufferSize) {
+		buffer.reset();
+		buffer = std::make_unique_for_overwrite<std::byte[]>(needed);
+		bufferSize = needed;
+	}
+	arena.emplace(buffer.get(), bufferSize, &overflow);
+}
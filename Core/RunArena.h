@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+
+/**
+ * @brief Memory of one backtest run, handed out linearly and released at once
+ *
+ * A run allocates many small, short-lived blocks (order book slots and heaps,
+ * per-symbol state, the registered statistics and their names, ...) and frees
+ * them all together when it ends. The arena serves those allocations from one
+ * buffer with a std::pmr::monotonic_buffer_resource: deallocation is a no-op,
+ * and reset() takes everything back in one step so the next run reuses the
+ * same, already-touched memory.
+ *
+ * When a run needs more than the buffer, the monotonic resource takes extra
+ * chunks from the global heap; reset() then grows the buffer by the amount
+ * that overflowed, so after the first few runs a job of the same shape runs
+ * entirely inside the buffer.
+ *
+ * Rules:
+ * - Everything allocated from resource() must be destroyed before reset()
+ *   (StrategyContexts, OrderManagers, StatsCollectors of the run)
+ * - Results that outlive the run (StatsMap, checkpoints) must be copied out
+ *   with the default resource - StatsCollector::computeStats() and the copy
+ *   constructors of the containers already do so
+ * - Not thread-safe: use one arena per worker thread
+ */
+class RunArena {
+private:
+	/**
+	 * @brief Global heap, counting the bytes the arena had to take beyond its buffer
+	 */
+	class Overflow : public std::pmr::memory_resource {
+	public:
+		size_t bytes = 0;  // Allocated since the last reset
+
+	private:
+		void* do_allocate(size_t size, size_t alignment) override {
+			bytes += size;
+			return std::pmr::new_delete_resource()->allocate(size, alignment);
+		}
+		void do_deallocate(void* pointer, size_t size, size_t alignment) override {
+			std::pmr::new_delete_resource()->deallocate(pointer, size, alignment);
+		}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+	std::unique_ptr<std::byte[]> buffer;                       // Memory served first
+	size_t bufferSize;                                         // Bytes in buffer
+	Overflow overflow;                                         // Upstream of the monotonic resource
+	std::optional<std::pmr::monotonic_buffer_resource> arena;  // Re-created by reset()
+
+public:
+	/**
+	 * @brief Creates an arena with an initial buffer
+	 *
+	 * @param initialSize Bytes of the first buffer (grows as runs need it)
+	 * @throws std::invalid_argument If initialSize is 0
+	 */
+	explicit RunArena(size_t initialSize = 256 * 1024);
+
+	RunArena(const RunArena&) = delete;
+	RunArena& operator=(const RunArena&) = delete;
+
+	/**
+	 * @brief Returns the memory resource of the current run
+	 */
+	std::pmr::memory_resource* resource() { return &*arena; }
+
+	/**
+	 * @brief Releases everything allocated since the last reset
+	 *
+	 * Grows the buffer first if the run overflowed it, so that the next run
+	 * of the same size fits.
+	 */
+	void reset();
+
+	/**
+	 * @brief Returns the size of the buffer in bytes
+	 */
+	size_t capacity() const { return bufferSize; }
+};
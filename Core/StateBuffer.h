@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Byte buffer a strategy saves its state into (see Strategy::saveState())
+ *
+ * Values are appended in their in-memory representation, so a state can only
+ * be restored by the same build; checkpoints are meant to fork runs within
+ * one process, not to be stored.
+ */
+class StateWriter {
+private:
+	std::vector<std::byte> bytes;
+
+public:
+	/**
+	 * @brief Appends a value (trivially copyable: numbers, enums, plain structs)
+	 */
+	template<typename T>
+	void write(const T& value) {
+		static_assert(std::is_trivially_copyable_v<T>, "State values must be trivially copyable");
+		const size_t at = bytes.size();
+		bytes.resize(at + sizeof(T));
+		std::memcpy(bytes.data() + at, &value, sizeof(T));
+	}
+
+	/**
+	 * @brief Appends a vector of trivially copyable values, preceded by its size
+	 */
+	template<typename T>
+	void write(const std::vector<T>& values) {
+		static_assert(std::is_trivially_copyable_v<T>, "State values must be trivially copyable");
+		write(values.size());
+		const size_t at = bytes.size();
+		bytes.resize(at + values.size() * sizeof(T));
+		if (!values.empty()) std::memcpy(bytes.data() + at, values.data(), values.size() * sizeof(T));
+	}
+
+	/**
+	 * @brief Returns the bytes written so far
+	 */
+	const std::vector<std::byte>& data() const { return bytes; }
+
+	/**
+	 * @brief Takes the bytes written (the writer is left empty)
+	 */
+	std::vector<std::byte> release() { return std::move(bytes); }
+};
+
+/**
+ * @brief Reads back a state written by StateWriter, value by value in the same order
+ */
+class StateReader {
+private:
+	const std::byte* cursor;
+	const std::byte* end;
+
+	const std::byte* take(size_t count) {
+		if (count > static_cast<size_t>(end - cursor)) throw std::runtime_error("Strategy state is truncated.");
+		const std::byte* at = cursor;
+		cursor += count;
+		return at;
+	}
+
+public:
+	/**
+	 * @brief Reads from a buffer, which must outlive the reader
+	 */
+	explicit StateReader(const std::vector<std::byte>& bytes) : cursor(bytes.data()), end(bytes.data() + bytes.size()) {}
+
+	/**
+	 * @brief Reads a value written by StateWriter::write(const T&)
+	 *
+	 * @throws std::runtime_error If the state holds fewer bytes than requested
+	 */
+	template<typename T>
+	void read(T& value) {
+		static_assert(std::is_trivially_copyable_v<T>, "State values must be trivially copyable");
+		std::memcpy(&value, take(sizeof(T)), sizeof(T));
+	}
+
+	/**
+	 * @brief Reads a vector written by StateWriter::write(const std::vector<T>&)
+	 *
+	 * @throws std::runtime_error If the state holds fewer bytes than requested
+	 */
+	template<typename T>
+	void read(std::vector<T>& values) {
+		static_assert(std::is_trivially_copyable_v<T>, "State values must be trivially copyable");
+		size_t count;
+		read(count);
+		if (count > static_cast<size_t>(end - cursor) / sizeof(T)) throw std::runtime_error("Strategy state is truncated.");
+		values.resize(count);
+		if (count != 0) std::memcpy(values.data(), take(count * sizeof(T)), count * sizeof(T));
+	}
+
+	/**
+	 * @brief Returns true once every byte was read
+	 */
+	bool done() const { return cursor == end; }
+};
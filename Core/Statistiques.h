@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 
@@ -10,8 +11,10 @@
  * @brief Registers standard performance statistics for a strategy
  * 
  * This function registers common trading performance metrics that will be
- * computed at the end of backtesting. All statistics are computed from the
- * PnL and returns series collected during backtesting.
+ * computed at the end of backtesting. All statistics read the online
+ * accumulators of the StatsCollector (updated on every recordPnL()) from the
+ * shared StatsSummary, so each one is O(1) and works whether or not the full
+ * series are stored.
  * 
  * Registered statistics:
  * - MeanReturn: Average return per period
@@ -35,10 +38,9 @@ inline void registerUserStats(StatsCollector& collector, TimeFrame tf, double ri
 	 * Mean Return: Simple average of all period returns
 	 * Formula: mean = sum(returns) / count(returns)
 	 */
-	collector.addStat("MeanReturn", [&collector]() {
-		const auto& ret = collector.getReturnsSeries();
-		if (ret.empty()) return 0.0;
-		return std::accumulate(ret.begin(), ret.end(), 0.0) / ret.size();
+	collector.addStat("MeanReturn", ACCUMULATORS, [](const StatsSummary& s) {
+		if (s.returnCount == 0) return 0.0;
+		return s.meanReturn;
 	});
 
 	/**
@@ -46,9 +48,8 @@ inline void registerUserStats(StatsCollector& collector, TimeFrame tf, double ri
 	 * Formula: (final_pnl / initial_pnl) - 1
 	 * Example: If you started with $10,000 and ended with $12,500, TotalReturn = 0.25 (25%)
 	 */
-	collector.addStat("TotalReturn", [&collector]() {
-		const auto& pnl = collector.getPnLSeries();
-		return (std::abs(pnl.front()) > 1e-8) ? pnl.back() / pnl.front() - 1.0 : 0.0;
+	collector.addStat("TotalReturn", ACCUMULATORS, [](const StatsSummary& s) {
+		return s.totalReturn;
 	});
 
 	/**
@@ -56,6 +57,7 @@ inline void registerUserStats(StatsCollector& collector, TimeFrame tf, double ri
 	 * 
 	 * Tracks the highest peak value seen so far, and calculates the percentage
 	 * drop from that peak. The maximum of all such drops is the max drawdown.
+	 * The collector keeps the running peak and worst drawdown as PnL is recorded.
 	 * 
 	 * Formula: max((current_pnl - peak) / peak) over all periods
 	 * Result is negative (e.g., -0.15 means 15% drawdown)
@@ -63,20 +65,8 @@ inline void registerUserStats(StatsCollector& collector, TimeFrame tf, double ri
 	 * Example: If portfolio peaked at $12,000 and dropped to $10,200,
 	 * drawdown = (10,200 - 12,000) / 12,000 = -0.15 (-15%)
 	 */
-	collector.addStat("MaxDrawdown", [&collector]() {
-		const auto& pnlSeries = collector.getPnLSeries();
-		if (pnlSeries.empty()) return 0.0;
-
-		double peak = pnlSeries[0];  // Track the highest PnL seen so far
-		double maxDD = 0.0;          // Track the worst drawdown
-
-		for (double pnl : pnlSeries) {
-			peak = std::max(peak, pnl);  // Update peak if we hit a new high
-			// Calculate drawdown from peak (will be negative or zero)
-			if (peak > 1e-8) maxDD = std::min(maxDD, (pnl - peak) / peak);
-		}
-
-		return maxDD;
+	collector.addStat("MaxDrawdown", ACCUMULATORS, [](const StatsSummary& s) {
+		return s.maxDrawdown;
 	});
 
 	/**
@@ -87,20 +77,11 @@ inline void registerUserStats(StatsCollector& collector, TimeFrame tf, double ri
 	 * 
 	 * Formula: std_dev(returns) * sqrt(periods_per_year)
 	 */
-	collector.addStat("AnnualizedVolatility", [&collector, nPeriods]() {
-		const auto& returns = collector.getReturnsSeries();
-		if (returns.size() < 2) return 0.0;
-
-		// Calculate mean return
-		double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-		
-		// Calculate variance: average of squared deviations from mean
-		double var = 0.0;
-		for (double ret : returns) var += (ret - mean) * (ret - mean);
-		var /= returns.size();
+	collector.addStat("AnnualizedVolatility", ACCUMULATORS, [nPeriods](const StatsSummary& s) {
+		if (s.returnCount < 2) return 0.0;
 
 		// Standard deviation = sqrt(variance), annualized
-		return std::sqrt(var) * std::sqrt(nPeriods);
+		return std::sqrt(s.returnVariance) * std::sqrt(nPeriods);
 	});
 
 	/**
@@ -117,23 +98,12 @@ inline void registerUserStats(StatsCollector& collector, TimeFrame tf, double ri
 	 * - 2-3: Very good
 	 * - > 3: Excellent
 	 */
-	collector.addStat("Sharpe", [&collector, nPeriods, &riskFreeRate, &periodsPerYear]() {
-			const auto& returns = collector.getReturnsSeries();
-			if (returns.size() < 2) return 0.0;
-
-			// Calculate mean return
-			double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-			
-			// Calculate variance
-			double var = 0.0;
-			for (double ret : returns) {
-				var += (ret - mean) * (ret - mean);
-			}
-			var /= returns.size();
-
-			// Sharpe = (excess return) / (volatility) * sqrt(periods)
-			// Add small epsilon (1e-8) to avoid division by zero
-			return (mean - riskFreeRate) / std::sqrt(var + 1e-8) * std::sqrt(nPeriods);
+	collector.addStat("Sharpe", ACCUMULATORS, [nPeriods, riskFreeRate](const StatsSummary& s) {
+		if (s.returnCount < 2) return 0.0;
+
+		// Sharpe = (excess return) / (volatility) * sqrt(periods)
+		// Add small epsilon (1e-8) to avoid division by zero
+		return (s.meanReturn - riskFreeRate) / std::sqrt(s.returnVariance + 1e-8) * std::sqrt(nPeriods);
 	});
 
 	/**
@@ -148,25 +118,82 @@ inline void registerUserStats(StatsCollector& collector, TimeFrame tf, double ri
 	 * Generally, Sortino will be higher than Sharpe for the same strategy
 	 * (since it ignores upside volatility).
 	 */
-	collector.addStat("Sortino", [&collector, nPeriods, &riskFreeRate, &periodsPerYear]() {
-		const auto& returns = collector.getReturnsSeries();
-		double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-		
-		// Calculate downside variance (only from negative returns)
-		double downsideVar = 0.0;
-		int downsideCount = 0;
-		for (double ret : returns) {
-			if (ret < 0) {
-				downsideVar += ret * ret;  // Square of negative return
-				downsideCount++;
-			}
-		}
-
-		if (returns.size() < 2 || downsideCount == 0) return 0.0;
-
-		downsideVar /= downsideCount;  // Average of squared downside returns
+	collector.addStat("Sortino", ACCUMULATORS, [nPeriods, riskFreeRate](const StatsSummary& s) {
+		if (s.returnCount < 2 || s.downsideCount == 0) return 0.0;
 
 		// Sortino = (excess return) / (downside volatility) * sqrt(periods)
-		return (mean - riskFreeRate) / std::sqrt(downsideVar + 1e-8) * std::sqrt(nPeriods);
+		// Downside variance = average of squared negative returns
+		return (s.meanReturn - riskFreeRate) / std::sqrt(s.downsideVariance + 1e-8) * std::sqrt(nPeriods);
+	});
+}
+
+/**
+ * @brief Registers statistics that need the whole PnL and returns series
+ * 
+ * They share two inputs of the StatsCollector - the drawdown curve and the
+ * sorted returns - each built in one pass however many statistics read it.
+ * Without stored series (setStoreSeries(false)) the series statistics are
+ * reported as NaN; Calmar only needs the accumulators.
+ * 
+ * Registered statistics:
+ * - MaxDrawdownDuration: Longest time spent below a previous peak, in ticks
+ * - UlcerIndex: Root mean square of the drawdown curve (depth and length of the drawdowns)
+ * - Calmar: Annualized mean return divided by the maximum drawdown
+ * - ValueAtRisk95: Loss of the worst 5% return (positive = loss)
+ * - ExpectedShortfall95: Average loss over the worst 5% of returns
+ * - HitRate: Fraction of returns that are positive
+ * 
+ * @param collector The StatsCollector to register statistics with
+ * @param tf Time frame for annualization calculations
+ * @param periodsPerYear Number of trading periods per year (default: 252 trading days)
+ */
+inline void registerSeriesStats(StatsCollector& collector, TimeFrame tf, double periodsPerYear = 252.0) {
+	double nPeriods = getTicksPerDay(tf) * periodsPerYear;
+
+	collector.addStat("MaxDrawdownDuration", DRAWDOWN_CURVE, [](const StatsSummary& s) {
+		return static_cast<double>(s.maxDrawdownDuration);
+	});
+
+	/**
+	 * Ulcer Index: sqrt(mean(drawdown^2)) over every tick
+	 * Unlike MaxDrawdown, it grows with how long the drawdowns last
+	 */
+	collector.addStat("UlcerIndex", DRAWDOWN_CURVE, [](const StatsSummary& s) {
+		if (s.drawdowns.empty()) return 0.0;
+		double sumSq = 0.0;
+		for (double drawdown : s.drawdowns) sumSq += drawdown * drawdown;
+		return std::sqrt(sumSq / s.drawdowns.size());
+	});
+
+	/**
+	 * Calmar Ratio: annualized return per unit of worst drawdown
+	 * Formula: mean_return * periods_per_year / |max_drawdown|
+	 */
+	collector.addStat("Calmar", ACCUMULATORS, [nPeriods](const StatsSummary& s) {
+		if (s.returnCount < 2 || s.maxDrawdown == 0.0) return 0.0;
+		return s.meanReturn * nPeriods / -s.maxDrawdown;
+	});
+
+	/**
+	 * Value at Risk (95%): the 5th percentile of the returns, as a loss
+	 */
+	collector.addStat("ValueAtRisk95", SORTED_RETURNS, [](const StatsSummary& s) {
+		if (s.sortedReturns.empty()) return 0.0;
+		return -s.sortedReturns[static_cast<size_t>(0.05 * (s.sortedReturns.size() - 1))];
+	});
+
+	/**
+	 * Expected Shortfall (95%): mean of the worst 5% of the returns, as a loss
+	 */
+	collector.addStat("ExpectedShortfall95", SORTED_RETURNS, [](const StatsSummary& s) {
+		if (s.sortedReturns.empty()) return 0.0;
+		const size_t tail = std::max<size_t>(1, static_cast<size_t>(std::ceil(0.05 * s.sortedReturns.size())));
+		return -std::accumulate(s.sortedReturns.begin(), s.sortedReturns.begin() + tail, 0.0) / tail;
+	});
+
+	collector.addStat("HitRate", SORTED_RETURNS, [](const StatsSummary& s) {
+		if (s.sortedReturns.empty()) return 0.0;
+		const auto firstPositive = std::upper_bound(s.sortedReturns.begin(), s.sortedReturns.end(), 0.0);
+		return static_cast<double>(s.sortedReturns.end() - firstPositive) / s.sortedReturns.size();
 	});
-}
\ No newline at end of file
+}
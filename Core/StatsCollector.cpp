@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <fstream>
+#include <limits>
 
 #include "StatsCollector.h"
 
@@ -55,27 +57,65 @@ void StatsCollector::exportStatsToCSV(const std::string& filename, const StatsMa
  * This is called for each tick during backtesting. It:
  * 1. Stores the first PnL as initialPnL (starting value)
  * 2. Calculates the return from previous PnL: (current - previous) / previous
- * 3. Stores both the PnL and the calculated return
+ * 3. Updates the online accumulators:
+ *    - Welford's algorithm for the running mean and variance of returns
+ *      (numerically stable, one pass, no stored history needed)
+ *    - Sum and count of squared negative returns (for the Sortino ratio)
+ *    - Running peak and worst drawdown from the peak
+ * 4. Stores the PnL and the return if series storage is on
  * 
  * The return calculation uses a small epsilon (1e-8) to avoid division by zero
  * if the previous PnL is exactly zero.
  */
 void StatsCollector::recordPnL(double pnl) {
 	// Store the first PnL as the initial value
-	if (pnlSeries.empty()) {
+	if (pnlCount == 0) {
 		initialPnL = pnl;
+		peakPnL = pnl;
 	}
-
 	// Calculate return from previous PnL (if we have previous data)
-	if (!pnlSeries.empty()) {
-		double prev = pnlSeries.back();
+	else {
 		// Return = (current - previous) / previous
 		// Add epsilon to denominator to avoid division by zero
-		returnsSeries.push_back((pnl - prev) / (std::abs(prev) + 1e-8));
+		double ret = (pnl - lastPnL) / (std::abs(lastPnL) + 1e-8);
+
+		// Welford update of mean and sum of squared deviations
+		returnCount++;
+		double delta = ret - returnMean;
+		returnMean += delta / returnCount;
+		returnM2 += delta * (ret - returnMean);
+
+		// Downside accumulation (only negative returns)
+		if (ret < 0) {
+			downsideSumSq += ret * ret;
+			downsideCount++;
+		}
+
+		if (storeSeries) returnsSeries.push_back(ret);
 	}
-	
+
+	// Track the peak and the drawdown from it (drawdown is negative or zero)
+	peakPnL = std::max(peakPnL, pnl);
+	if (peakPnL > 1e-8) maxDrawdown = std::min(maxDrawdown, (pnl - peakPnL) / peakPnL);
+
 	// Store the new PnL value
-	pnlSeries.push_back(pnl);
+	lastPnL = pnl;
+	pnlCount++;
+	if (storeSeries) pnlSeries.push_back(pnl);
+}
+
+/**
+ * @brief Turns storage of the full series on or off
+ */
+void StatsCollector::setStoreSeries(bool store) {
+	storeSeries = store;
+}
+
+/**
+ * @brief Returns true if the full series are kept
+ */
+bool StatsCollector::isStoringSeries() const {
+	return storeSeries;
 }
 
 /**
@@ -88,14 +128,81 @@ void StatsCollector::recordPnL(double pnl) {
  * If a statistic with the same name already exists, it is not overwritten.
  */
 void StatsCollector::addStat(std::string name, StatsFunction function) {
-	if (statsFunction.count(name)) return;  // Don't overwrite existing stats
-	statsFunction[name] = std::move(function);
+	addStat(std::move(name), ACCUMULATORS, [function = std::move(function)](const StatsSummary&) { return function(); });
+}
+
+/**
+ * @brief Registers a statistic with the inputs it reads
+ * 
+ * If a statistic with the same name already exists, it is not overwritten.
+ */
+void StatsCollector::addStat(std::string name, uint32_t inputs, StatsMetric metric) {
+	// Don't overwrite existing stats
+	statsFunction.try_emplace(std::pmr::string(name, statsFunction.get_allocator()), Stat{ inputs, std::move(metric) });
+}
+
+/**
+ * @brief Copies the accumulators and derives the missing series inputs
+ * 
+ * DRAWDOWN_CURVE walks the PnL series once, with the same peak and drawdown
+ * arithmetic as recordPnL() (so its minimum is getMaxDrawdown()), measuring
+ * the longest stretch under a previous peak on the way. SORTED_RETURNS
+ * copies and sorts the returns series. Both are kept for the following
+ * calls until a new PnL value is recorded.
+ */
+StatsSummary StatsCollector::summarize(uint32_t inputs) {
+	StatsSummary summary;
+	summary.pnlCount = pnlCount;
+	summary.initialPnL = initialPnL;
+	summary.lastPnL = lastPnL;
+	summary.totalReturn = getTotalReturn();
+	summary.returnCount = returnCount;
+	summary.meanReturn = returnMean;
+	summary.returnVariance = getReturnVariance();
+	summary.downsideVariance = getDownsideVariance();
+	summary.downsideCount = downsideCount;
+	summary.maxDrawdown = maxDrawdown;
+
+	if (!storeSeries) return summary;  // Only the accumulators
+	if (cachedCount != pnlCount) {
+		cachedInputs = ACCUMULATORS;
+		cachedCount = pnlCount;
+	}
+	const uint32_t missing = inputs & ~cachedInputs;
+
+	if (missing & DRAWDOWN_CURVE) {
+		drawdownCurve.resize(pnlSeries.size());
+		drawdownDuration = 0;
+		double peak = pnlSeries.empty() ? 0.0 : pnlSeries[0];
+		size_t underwater = 0;
+		for (size_t i = 0; i < pnlSeries.size(); i++) {
+			const double pnl = pnlSeries[i];
+			peak = std::max(peak, pnl);
+			drawdownCurve[i] = peak > 1e-8 ? (pnl - peak) / peak : 0.0;
+			underwater = pnl < peak ? underwater + 1 : 0;
+			drawdownDuration = std::max(drawdownDuration, underwater);
+		}
+	}
+	if (missing & SORTED_RETURNS) {
+		sortedReturns.assign(returnsSeries.begin(), returnsSeries.end());
+		std::sort(sortedReturns.begin(), sortedReturns.end());
+	}
+	cachedInputs |= missing;
+
+	summary.inputs = cachedInputs & inputs;
+	if (summary.inputs & DRAWDOWN_CURVE) {
+		summary.drawdowns = drawdownCurve;
+		summary.maxDrawdownDuration = drawdownDuration;
+	}
+	if (summary.inputs & SORTED_RETURNS) summary.sortedReturns = sortedReturns;
+	return summary;
 }
 
 /**
  * @brief Computes all registered statistics
  * 
- * Calls each registered statistic function and collects the results.
+ * Summarizes once with every input the statistics declared, then calls
+ * each registered statistic function and collects the results.
  * Returns an empty map if there's insufficient data (< 2 PnL values needed
  * for most statistics).
  * 
@@ -105,16 +212,34 @@ StatsMap StatsCollector::computeStats() {
 	StatsMap results;
 	
 	// Need at least 2 data points to compute meaningful statistics
-	if (pnlSeries.size() < 2) return results;
+	if (pnlCount < 2) return results;
 
-	// Call each registered statistic function and store the result
-	for (const auto& [name, fn] : statsFunction) {
-		results[name] = fn();
+	// Every input a statistic needs, built once for all of them
+	uint32_t inputs = ACCUMULATORS;
+	for (const auto& [name, stat] : statsFunction) inputs |= stat.inputs;
+	const StatsSummary summary = summarize(inputs);
+
+	// Call each registered statistic function and store the result (NaN if its inputs are missing)
+	for (const auto& [name, stat] : statsFunction) {
+		const bool available = (stat.inputs & ~summary.inputs) == 0;
+		results[std::string(name)] = available ? stat.metric(summary) : std::numeric_limits<double>::quiet_NaN();
 	}
 
 	return results;
 }
 
+/**
+ * @brief Copies the recorded state, dropping the statistic functions (they may point at this collector) and the cached inputs
+ */
+StatsCollector StatsCollector::snapshot() const {
+	StatsCollector copy = *this;
+	copy.statsFunction.clear();
+	copy.cachedInputs = ACCUMULATORS;
+	copy.drawdownCurve.clear();
+	copy.sortedReturns.clear();
+	return copy;
+}
+
 /**
  * @brief Returns the initial PnL (starting portfolio value)
  */
@@ -123,21 +248,84 @@ const double StatsCollector::getInitialPnL() const {
 }
 
 /**
- * @brief Returns a reference to the PnL series
+ * @brief Returns a view of the PnL series
  * 
  * This allows statistic functions to access the full PnL history
  * for calculations (e.g., max drawdown needs to see all values).
  */
-const std::vector<double>& StatsCollector::getPnLSeries() const {
+std::span<const double> StatsCollector::getPnLSeries() const {
 	return pnlSeries;
 }
 
 /**
- * @brief Returns a reference to the returns series
+ * @brief Returns a view of the returns series
  * 
  * This allows statistic functions to access the full returns history
  * for calculations (e.g., Sharpe ratio needs all returns).
  */
-const std::vector<double>& StatsCollector::getReturnsSeries() const {
+std::span<const double> StatsCollector::getReturnsSeries() const {
 	return returnsSeries;
 }
+
+/**
+ * @brief Returns the number of PnL values recorded
+ */
+size_t StatsCollector::getPnLCount() const {
+	return pnlCount;
+}
+
+/**
+ * @brief Returns the most recent PnL value
+ */
+double StatsCollector::getLastPnL() const {
+	return lastPnL;
+}
+
+/**
+ * @brief Returns the number of returns recorded
+ */
+size_t StatsCollector::getReturnCount() const {
+	return returnCount;
+}
+
+/**
+ * @brief Returns the running mean of returns
+ */
+double StatsCollector::getMeanReturn() const {
+	return returnMean;
+}
+
+/**
+ * @brief Returns the population variance of returns (M2 / n)
+ */
+double StatsCollector::getReturnVariance() const {
+	return returnCount > 0 ? returnM2 / returnCount : 0.0;
+}
+
+/**
+ * @brief Returns the average of the squared negative returns
+ */
+double StatsCollector::getDownsideVariance() const {
+	return downsideCount > 0 ? downsideSumSq / downsideCount : 0.0;
+}
+
+/**
+ * @brief Returns the number of negative returns
+ */
+size_t StatsCollector::getDownsideCount() const {
+	return downsideCount;
+}
+
+/**
+ * @brief Returns the worst drawdown from the running peak
+ */
+double StatsCollector::getMaxDrawdown() const {
+	return maxDrawdown;
+}
+
+/**
+ * @brief Returns final / initial - 1 (0 if the initial PnL is zero)
+ */
+double StatsCollector::getTotalReturn() const {
+	return (pnlCount > 0 && std::abs(initialPnL) > 1e-8) ? lastPnL / initialPnL - 1.0 : 0.0;
+}
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <functional>
+#include <memory_resource>
+#include <span>
 #include <vector>
 #include <cmath>
 #include <numeric>
@@ -22,29 +25,132 @@ using StatsMap = std::unordered_map<std::string, double>;
  */
 using StatsFunction = std::function<double()>;
 
+/**
+ * @brief Intermediate results a statistic is computed from, as bit flags
+ * 
+ * The online accumulators (moments, downside deviation, drawdown, total
+ * return) are always up to date. The other inputs are derived from the
+ * stored series by computeStats() - once for all the statistics that
+ * declare them, in one pass per input, and kept until the next recordPnL().
+ */
+enum StatInput : uint32_t {
+	ACCUMULATORS = 0,          // Only the running accumulators
+	DRAWDOWN_CURVE = 1u << 0,  // Drawdown from the running peak at every tick, longest time under water
+	SORTED_RETURNS = 1u << 1   // Returns in ascending order (quantiles, tail means, hit rate)
+};
+
+/**
+ * @brief Everything a statistic can be computed from (see StatsCollector::summarize())
+ */
+struct StatsSummary {
+	size_t pnlCount = 0;                    // PnL values recorded
+	double initialPnL = 0.0;                // First PnL value
+	double lastPnL = 0.0;                   // Latest PnL value
+	double totalReturn = 0.0;               // lastPnL / initialPnL - 1
+	size_t returnCount = 0;                 // Returns recorded (pnlCount - 1)
+	double meanReturn = 0.0;                // Mean of the returns
+	double returnVariance = 0.0;            // Population variance of the returns
+	double downsideVariance = 0.0;          // Mean of the squared negative returns
+	size_t downsideCount = 0;               // Number of negative returns
+	double maxDrawdown = 0.0;               // Worst drawdown from the running peak (negative or zero)
+
+	uint32_t inputs = ACCUMULATORS;         // StatInputs available below
+	std::span<const double> drawdowns;      // DRAWDOWN_CURVE: (pnl - peak) / peak at every tick
+	size_t maxDrawdownDuration = 0;         // DRAWDOWN_CURVE: longest run of ticks below an earlier peak
+	std::span<const double> sortedReturns;  // SORTED_RETURNS: the returns, ascending
+};
+
+/**
+ * @brief Type alias for a statistic computed from the shared intermediates
+ */
+using StatsMetric = std::function<double(const StatsSummary&)>;
+
 /**
  * @brief Collects and computes performance statistics for a strategy
  * 
  * The StatsCollector tracks:
- * - PnL series: Portfolio value over time
- * - Returns series: Percentage returns between consecutive PnL values
+ * - PnL series: Portfolio value over time (optional)
+ * - Returns series: Percentage returns between consecutive PnL values (optional)
+ * - Online accumulators: running mean/variance of returns (Welford), downside
+ *   variance, running peak and max drawdown - updated on every recordPnL()
  * - Custom statistics: User-defined metrics (Sharpe ratio, max drawdown, etc.)
  * 
  * Statistics are computed on-demand when computeStats() is called, allowing
  * for efficient collection during backtesting and flexible metric calculation.
+ * 
+ * Statistics declare what they are computed from (StatInput): the
+ * accumulators, or inputs derived from the series such as the drawdown
+ * curve or the sorted returns. computeStats() builds each input that at
+ * least one statistic needs once, caches it, and hands the same
+ * StatsSummary to every statistic - so a statistic costs one call,
+ * whatever it depends on.
+ * 
+ * The accumulators make the standard statistics available in O(1) at any point
+ * of the run, without another pass over the data. Storing the full series is
+ * only needed for the PnL CSV export or for custom statistics that need the
+ * whole history, and can be switched off with setStoreSeries(false) - memory
+ * use then stays constant no matter how many ticks are recorded.
+ * 
+ * The series and the registered statistics are allocated from the memory
+ * resource given at construction (see RunArena); computeStats() results are
+ * plain StatsMaps, independent of it.
  */
 class StatsCollector {
 private:
 	double initialPnL;                                    // Starting portfolio value
-	std::vector<double> pnlSeries;                        // Portfolio value at each tick
-	std::vector<double> returnsSeries;                    // Returns between consecutive ticks
-	std::unordered_map<std::string, StatsFunction> statsFunction;  // Registered statistics calculators
+	std::pmr::vector<double> pnlSeries;                   // Portfolio value at each tick (if storeSeries)
+	std::pmr::vector<double> returnsSeries;               // Returns between consecutive ticks (if storeSeries)
+	struct Stat {
+		uint32_t inputs;                                  // StatInputs the statistic reads
+		StatsMetric metric;
+	};
+	std::pmr::unordered_map<std::pmr::string, Stat> statsFunction;  // Registered statistics calculators
+	bool storeSeries;                                     // Keep the full PnL/returns series
+
+	// Inputs derived from the series, memoized until the next recordPnL()
+	uint32_t cachedInputs = ACCUMULATORS;                 // Inputs below that are up to date
+	size_t cachedCount = 0;                               // pnlCount they were computed at
+	std::pmr::vector<double> drawdownCurve;               // DRAWDOWN_CURVE
+	size_t drawdownDuration = 0;                          // DRAWDOWN_CURVE
+	std::pmr::vector<double> sortedReturns;               // SORTED_RETURNS
+
+	// Online accumulators (always up to date)
+	size_t pnlCount = 0;                                  // Number of PnL values recorded
+	double lastPnL = 0.0;                                 // Most recent PnL value
+	size_t returnCount = 0;                               // Number of returns (pnlCount - 1)
+	double returnMean = 0.0;                              // Running mean of returns (Welford)
+	double returnM2 = 0.0;                                // Running sum of squared deviations from the mean (Welford)
+	double downsideSumSq = 0.0;                           // Sum of squared negative returns
+	size_t downsideCount = 0;                             // Number of negative returns
+	double peakPnL = 0.0;                                 // Highest PnL seen so far
+	double maxDrawdown = 0.0;                             // Worst (most negative) drawdown from the peak
 	
 public:
 	/**
 	 * @brief Constructs a StatsCollector with zero initial PnL
+	 * 
+	 * @param storeSeries If false, only the online accumulators are updated (default: true)
+	 * @param resource Memory resource of the series and statistics (must outlive the collector)
 	 */
-	StatsCollector() : initialPnL(0.0) {}
+	StatsCollector(bool storeSeries = true, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		: initialPnL(0.0), pnlSeries(resource), returnsSeries(resource), statsFunction(resource), storeSeries(storeSeries),
+		drawdownCurve(resource), sortedReturns(resource) {}
+
+	/**
+	 * @brief Chooses whether the full PnL and returns series are kept
+	 * 
+	 * Should be set before the first recordPnL(). With series storage off,
+	 * exportPnLToCSV() writes only the header and getPnLSeries()/getReturnsSeries()
+	 * stay empty; all accumulator getters keep working.
+	 * 
+	 * @param store true to keep the series, false for constant-memory streaming mode
+	 */
+	void setStoreSeries(bool store);
+
+	/**
+	 * @brief Returns true if the full PnL and returns series are kept
+	 */
+	bool isStoringSeries() const;
 
 	/**
 	 * @brief Exports the PnL series to a CSV file
@@ -70,7 +176,8 @@ public:
 	 * @brief Records a new PnL value and updates the returns series
 	 * 
 	 * Called for each tick during backtesting to track portfolio value over time.
-	 * Also calculates the return (percentage change) from the previous PnL.
+	 * Also calculates the return (percentage change) from the previous PnL and
+	 * updates all online accumulators in O(1).
 	 * 
 	 * @param pnl Current portfolio value (cash + position value)
 	 */
@@ -88,10 +195,36 @@ public:
 	 */
 	void addStat(std::string name, StatsFunction function);
 
+	/**
+	 * @brief Registers a statistic computed from the shared intermediates
+	 * 
+	 * The function receives the StatsSummary of computeStats(), with every
+	 * input it declared. Inputs derived from the series need them stored
+	 * (setStoreSeries()): without them, the statistic is reported as NaN.
+	 * 
+	 * @param name Name of the statistic (an existing one is not overwritten)
+	 * @param inputs StatInput flags the function reads (ACCUMULATORS if none)
+	 * @param metric Function that computes the statistic value
+	 */
+	void addStat(std::string name, uint32_t inputs, StatsMetric metric);
+
+	/**
+	 * @brief Returns the intermediates statistics are computed from
+	 * 
+	 * The accumulators are copied; each requested series input is computed
+	 * on the first request after a recordPnL() and cached. The spans are
+	 * valid until the next recordPnL() or summarize().
+	 * 
+	 * @param inputs StatInput flags to make available (if the series are stored)
+	 * @return Summary, with summary.inputs telling which inputs it holds
+	 */
+	StatsSummary summarize(uint32_t inputs);
+
 	/**
 	 * @brief Computes all registered statistics
 	 * 
-	 * Calls each registered statistic function and returns a map of results.
+	 * Builds one StatsSummary with the union of the inputs the statistics
+	 * declared, then calls each registered statistic function with it.
 	 * This is typically called once at the end of backtesting after all
 	 * PnL values have been recorded.
 	 * 
@@ -99,6 +232,18 @@ public:
 	 */
 	StatsMap computeStats();
 
+	/**
+	 * @brief Copies everything recorded so far, without the registered statistics
+	 * 
+	 * The statistic functions usually refer to the collector they were
+	 * registered on, so a copy must register its own (registerUserStats()).
+	 * Used to checkpoint a run and continue it from there. The copy allocates
+	 * from the default memory resource, so it may outlive this collector's.
+	 * 
+	 * @return Collector with the same series and accumulators, and no statistics
+	 */
+	StatsCollector snapshot() const;
+
 	/**
 	 * @brief Gets the initial PnL (starting portfolio value)
 	 * 
@@ -109,14 +254,59 @@ public:
 	/**
 	 * @brief Gets the PnL series (portfolio value over time)
 	 * 
-	 * @return Reference to the vector of PnL values
+	 * @return View of the PnL values (valid until the next recordPnL())
 	 */
-	const std::vector<double>& getPnLSeries() const;
+	std::span<const double> getPnLSeries() const;
 
 	/**
 	 * @brief Gets the returns series (percentage returns over time)
 	 * 
-	 * @return Reference to the vector of return values
+	 * @return View of the return values (valid until the next recordPnL())
+	 */
+	std::span<const double> getReturnsSeries() const;
+
+	/**
+	 * @brief Gets the number of PnL values recorded so far
+	 */
+	size_t getPnLCount() const;
+
+	/**
+	 * @brief Gets the most recent PnL value (0 if nothing was recorded)
+	 */
+	double getLastPnL() const;
+
+	/**
+	 * @brief Gets the number of returns recorded so far (one less than the PnL count)
+	 */
+	size_t getReturnCount() const;
+
+	/**
+	 * @brief Gets the mean of all returns so far
+	 */
+	double getMeanReturn() const;
+
+	/**
+	 * @brief Gets the (population) variance of all returns so far
+	 */
+	double getReturnVariance() const;
+
+	/**
+	 * @brief Gets the mean of the squared negative returns (0 if there were none)
+	 */
+	double getDownsideVariance() const;
+
+	/**
+	 * @brief Gets the number of negative returns so far
+	 */
+	size_t getDownsideCount() const;
+
+	/**
+	 * @brief Gets the worst drawdown from the running peak so far (negative or zero)
+	 */
+	double getMaxDrawdown() const;
+
+	/**
+	 * @brief Gets the total return from the first to the latest PnL (final / initial - 1)
 	 */
-	const std::vector<double>& getReturnsSeries() const;
+	double getTotalReturn() const;
 };
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "OrderManager.h"
+#include "TickColumns.h"
+#include "StateBuffer.h"
 #include <cstdint>
 
 /**
@@ -19,6 +21,12 @@
  * To create a new strategy, inherit from this class and implement:
  * - setOrderManager(): Store the OrderManager pointer for later use
  * - onTick(): Your trading logic that analyzes ticks and submits orders
+ * 
+ * Optionally, saveState() and restoreState() let a run be checkpointed and
+ * forked, e.g. by WalkForward.
+ * 
+ * Strategies that would rather compute their signals over many ticks at once
+ * derive from BlockStrategy (or BlockQuoteStrategy) and implement onTicks().
  */
 class Strategy {
 public:
@@ -33,6 +41,21 @@ public:
 	 * @param om Pointer to the OrderManager instance for this strategy
 	 */
 	virtual void setOrderManager(OrderManager* om) = 0;
+
+	/**
+	 * @brief Gives the strategy direct access to columnar market data
+	 * 
+	 * Called by the BacktestEngine before onStart() when the data was loaded
+	 * as columns (TradeColumns/QuoteColumns). Strategies and indicators can
+	 * use the raw price/bid/ask arrays for batch or SIMD computations, e.g.
+	 * precomputing a signal over a whole column. The columns hold the full
+	 * history, so make sure to only use values up to the current tick to avoid
+	 * look-ahead bias. Default implementation ignores the columns.
+	 * 
+	 * @param trades Trade columns, or nullptr if trade data isn't columnar
+	 * @param quotes Quote columns, or nullptr if quote data isn't columnar
+	 */
+	virtual void setColumnarData(const TradeColumns* /*trades*/, const QuoteColumns* /*quotes*/) {}
 	
 	/**
 	 * @brief Called once before backtesting begins
@@ -51,6 +74,33 @@ public:
 	 * Default implementation does nothing.
 	 */
 	virtual void onEnd() {}
+
+	/**
+	 * @brief Saves the strategy's state to resume from it later
+	 * 
+	 * Write every member that changes while ticks are processed (indicator
+	 * windows, flags, resting order IDs...), but not the OrderManager pointer
+	 * or the construction parameters: the state is restored into an instance
+	 * built with the same parameters. Default implementation returns false -
+	 * the strategy can't be checkpointed, and runs that would fork from a
+	 * checkpoint replay the ticks instead.
+	 * 
+	 * @param out Buffer to write the state into
+	 * @return true if the state was saved
+	 */
+	virtual bool saveState(StateWriter& /*out*/) const { return false; }
+
+	/**
+	 * @brief Restores a state written by saveState()
+	 * 
+	 * Called on a freshly built instance, after setOrderManager() and in place
+	 * of onStart(); the OrderManager already holds the positions and orders of
+	 * the checkpoint, so resting order IDs stay valid. Default implementation
+	 * does nothing.
+	 * 
+	 * @param in Reader over the saved state (same order as written)
+	 */
+	virtual void restoreState(StateReader& /*in*/) {}
 	
 	/**
 	 * @brief Called for each market tick during backtesting
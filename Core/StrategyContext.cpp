@@ -0,0 +1,95 @@
+#include "StrategyContext.h"
+#include "Statistiques.h"
+
+/**
+ * @brief Constructs a StrategyContext with all necessary components
+ * 
+ * Initializes all members and moves the strategy into this context.
+ * The OrderManager is initialized with the starting cash amount; it and the
+ * StatsCollector allocate from the given memory resource.
+ */
+StrategyContext::StrategyContext(const std::string& name,
+	std::unique_ptr<Strategy> strategy,
+	const TimeFrame& tf,
+	const double initialCash,
+	std::pmr::memory_resource* resource) : name(name), strategy(std::move(strategy)), tf(tf), orderManager(initialCash, resource), statistics(true, resource) {
+}
+
+/**
+ * @brief Connects the strategy, registers statistics and detects quote strategies
+ */
+void StrategyContext::setup() {
+	// Give the strategy access to its OrderManager so it can submit orders
+	strategy->setOrderManager(&orderManager);
+
+	// Register statistics collection callbacks (for custom metrics)
+	registerUserStats(statistics, tf);
+
+	// Check if this is a QuoteStrategy (needs bid/ask data)
+	quoteStrategy = dynamic_cast<QuoteStrategy*>(strategy.get());
+
+	// Check if it takes its ticks a block at a time
+	blockStrategy = dynamic_cast<BlockStrategy*>(strategy.get());
+	blockQuoteStrategy = dynamic_cast<BlockQuoteStrategy*>(strategy.get());
+}
+
+/**
+ * @brief Finalizes the strategy and computes final statistics (Sharpe ratio, max drawdown, etc.)
+ */
+StatsMap StrategyContext::finish() {
+	strategy->onEnd();
+	return statistics.computeStats();
+}
+
+/**
+ * @brief Runs the strategy over a block of trade ticks
+ * 
+ * For each tick:
+ * - Let strategy analyze the tick and make trading decisions
+ * - Check if any pending LIMIT orders should execute
+ * - Record PnL, every position valued at the last price of its symbol
+ * 
+ * With typed dispatch, the whole block goes to the typed loop instead. A
+ * block strategy is handed the whole block, and its staged orders take the
+ * place of onTick().
+ */
+void StrategyContext::process(std::span<const Tick> ticks) {
+	if (tickProcessor) return tickProcessor(*this, ticks);
+	if (blockStrategy) return processBlock([&](BlockOrders& orders) { blockStrategy->onTicks(ticks, orders); }, ticks);
+
+	for (const Tick& tick : ticks) {
+		step([&] { strategy->onTick(tick); }, tick);
+	}
+}
+
+/**
+ * @brief Runs the quote strategy over a block of quote ticks
+ * 
+ * Same as the trade tick version, but positions are valued at the mid-price
+ * (average of bid and ask).
+ */
+void StrategyContext::process(std::span<const QuoteTick> quotes) {
+	if (quoteProcessor) return quoteProcessor(*this, quotes);
+	if (blockQuoteStrategy) return processBlock([&](BlockOrders& orders) { blockQuoteStrategy->onQuotes(quotes, orders); }, quotes);
+
+	for (const QuoteTick& tick : quotes) {
+		step([&] { quoteStrategy->onTick(tick); }, tick);
+	}
+}
+
+/**
+ * @brief Runs the bar strategy over a block of trade ticks with precomputed bars
+ * 
+ * Bars are ordered by the tick that completed them, so a single cursor walks
+ * them alongside the ticks.
+ */
+void StrategyContext::process(std::span<const Tick> ticks, std::span<const BarEvent> bars) {
+	size_t next = 0;
+	for (size_t i = 0; i < ticks.size(); i++) {
+		step([&] {
+			for (; next < bars.size() && bars[next].tick == i; next++) {
+				barStrategy->onBar(bars[next].bar);
+			}
+		}, ticks[i]);
+	}
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <type_traits>
+
+#include "Strategy.h"
+#include "QuoteStrategy.h"
+#include "BarStrategy.h"
+#include "BlockStrategy.h"
+#include "BarPipeline.h"
+#include "TimeFrame.h"
+#include "OrderManager.h"
+#include "StatsCollector.h"
+#include "Profiler.h"
+#include "ProgressChannel.h"
+
+/**
+ * @brief Container for all components needed to run a single strategy
+ * 
+ * Each strategy runs in its own context with:
+ * - name: Identifier for this strategy instance
+ * - strategy: The actual strategy implementation
+ * - tf: Time frame this strategy operates on
+ * - orderManager: Handles order execution and position tracking for this strategy
+ * - statistics: Collects performance metrics during backtesting
+ * - quoteStrategy: The strategy seen as a QuoteStrategy (nullptr for trade-tick strategies)
+ * 
+ * Block strategies (BlockStrategy, BlockQuoteStrategy) get each block in one
+ * onTicks()/onQuotes() call; their staged orders are then released tick by
+ * tick, in the same loop that matches and records the PnL.
+ * 
+ * By default, blocks are processed through the Strategy interface (one virtual
+ * onTick() call per tick). useTypedDispatch<StrategyT>() switches the context
+ * to a loop instantiated for the concrete strategy type instead: onTick() is
+ * called directly, so the compiler can inline it together with the matching
+ * and PnL recording (across translation units when LTO is on).
+ * 
+ * In builds with BACKTEST_INSTRUMENT, every profileInterval-th tick is timed
+ * step by step into profile (see step()); otherwise neither exists.
+ */
+struct StrategyContext {
+	using TickProcessor = void (*)(StrategyContext&, std::span<const Tick>);
+	using QuoteProcessor = void (*)(StrategyContext&, std::span<const QuoteTick>);
+
+
+	std::string name;                    // Strategy identifier (e.g., "Mean_Reversion")
+	std::unique_ptr<Strategy> strategy;  // The strategy implementation
+	TimeFrame tf;                        // Time frame for this strategy
+	OrderManager orderManager;            // Manages orders and positions for this strategy
+	StatsCollector statistics;            // Collects performance statistics
+	QuoteStrategy* quoteStrategy = nullptr;  // Set by runAll() if the strategy consumes quote ticks
+	BlockStrategy* blockStrategy = nullptr;            // Set by setup() if the strategy takes trade ticks by block
+	BlockQuoteStrategy* blockQuoteStrategy = nullptr;  // Set by setup() if the strategy takes quote ticks by block
+	BlockOrders blockOrders;                           // Orders staged by the block strategy for the current block
+	TickProcessor tickProcessor = nullptr;   // Typed trade tick loop (nullptr = virtual dispatch)
+	QuoteProcessor quoteProcessor = nullptr; // Typed quote tick loop (nullptr = virtual dispatch)
+	BarStrategy* barStrategy = nullptr;      // Set by the engine if the strategy is fed by its BarPipeline
+	size_t barLevel = 0;                     // Pipeline level of the strategy's bar window
+	std::unique_ptr<ProgressChannel> progress;  // Live events for the engine's progress observer (observed runs only)
+#if BACKTEST_INSTRUMENT
+	std::unique_ptr<StrategyProfile> profile = std::make_unique<StrategyProfile>();  // Latency histograms
+	uint32_t profileInterval = 16;           // Time one tick out of profileInterval
+	uint32_t profileCountdown = 1;           // Ticks until the next timed one
+#endif
+
+	/**
+	 * @brief Constructs a StrategyContext with all necessary components
+	 * 
+	 * @param name Strategy name/identifier
+	 * @param strategy The strategy instance (moved into this context)
+	 * @param tf Time frame for this strategy
+	 * @param initialCash Starting capital for this strategy
+	 * @param resource Memory resource of the OrderManager and StatsCollector (must outlive the context)
+	 */
+	StrategyContext(const std::string& name, std::unique_ptr<Strategy> strategy, const TimeFrame& tf, const double initialCash,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	/**
+	 * @brief Prepares the context for a run
+	 * 
+	 * Connects the strategy to its OrderManager, registers the standard
+	 * statistics and detects whether the strategy consumes quote ticks
+	 * (sets quoteStrategy) and whether it takes them by block (sets
+	 * blockStrategy or blockQuoteStrategy).
+	 */
+	void setup();
+
+	/**
+	 * @brief Ends the run and computes the registered statistics
+	 * 
+	 * Calls strategy->onEnd() and then statistics.computeStats().
+	 * 
+	 * @return Map of statistic names to computed values
+	 */
+	StatsMap finish();
+
+	/**
+	 * @brief Runs the strategy over a contiguous block of trade ticks
+	 * 
+	 * For each tick: strategy->onTick(), then orderManager.handleTick() to fill
+	 * pending LIMIT orders, then records the PnL (positions at their last tick price).
+	 * A block strategy gets the whole block first, and the orders it staged
+	 * for each tick are submitted in place of its onTick().
+	 * 
+	 * @param ticks Block of trade ticks, in time order
+	 */
+	void process(std::span<const Tick> ticks);
+
+	/**
+	 * @brief Runs the quote strategy over a contiguous block of quote ticks
+	 * 
+	 * Same as the trade tick version, but PnL is recorded at the mid-price.
+	 * Must only be called when quoteStrategy is set.
+	 * 
+	 * @param quotes Block of quote ticks, in time order
+	 */
+	void process(std::span<const QuoteTick> quotes);
+
+	/**
+	 * @brief Runs the bar strategy over a block using bars built by a shared pipeline
+	 * 
+	 * For each tick: delivers the bars completed on that tick to onBar() (in
+	 * place of onTick(), which would aggregate them again), then fills LIMIT
+	 * orders and records the PnL as for any strategy.
+	 * Must only be called when barStrategy is set.
+	 * 
+	 * @param ticks Block of trade ticks, in time order
+	 * @param bars Bars of the strategy's window completed in this block
+	 */
+	void process(std::span<const Tick> ticks, std::span<const BarEvent> bars);
+
+	/**
+	 * @brief Processes blocks with a loop compiled for the concrete strategy type
+	 * 
+	 * The strategy held by the context must be exactly a StrategyT (not a class
+	 * derived from it): onTick() is called as StrategyT::onTick(), bypassing the
+	 * vtable. Whether the strategy consumes trade or quote ticks, and whether
+	 * it takes them by block, is decided at compile time.
+	 * 
+	 * @tparam StrategyT Concrete strategy type, derived from Strategy or QuoteStrategy
+	 */
+	template<typename StrategyT>
+	void useTypedDispatch() {
+		static_assert(std::is_base_of_v<Strategy, StrategyT>, "StrategyT must derive from Strategy");
+		if constexpr (std::is_base_of_v<QuoteStrategy, StrategyT>) {
+			quoteProcessor = &processTyped<StrategyT, QuoteTick>;
+			tickProcessor = nullptr;
+		} else {
+			tickProcessor = &processTyped<StrategyT, Tick>;
+			quoteProcessor = nullptr;
+		}
+	}
+
+	/**
+	 * @brief Publishes how far the run got, if it is observed: ticks processed and current PnL
+	 * 
+	 * Called by the worker between blocks, never per tick.
+	 */
+	void publishProgress() {
+		if (progress) progress->publish(ProgressEvent{ ProgressEvent::Type::PROGRESS, statistics.getPnLCount(), statistics.getLastPnL(), {} });
+	}
+
+	/**
+	 * @brief Runs a block strategy over a block: one call for the block, then the ticks one by one
+	 * 
+	 * @param onBlock Calls the strategy with the block and blockOrders
+	 * @param ticks Block being processed
+	 */
+	template<typename OnBlock, typename TickT>
+	void processBlock(OnBlock&& onBlock, std::span<const TickT> ticks) {
+		blockOrders.reset(ticks.size());
+		onBlock(blockOrders);
+		size_t i = 0;
+		for (size_t at = 0; at < blockOrders.size(); ) {
+			const size_t tick = blockOrders.tickOf(at);
+			for (; i < tick; i++) step([] {}, ticks[i]);  // No order on these ticks
+			step([&] { at = blockOrders.release(at, orderManager); }, ticks[i++]);
+		}
+		for (; i < ticks.size(); i++) step([] {}, ticks[i]);
+	}
+
+	/**
+	 * @brief Runs the three steps of one tick
+	 * 
+	 * onTick (the strategy's reaction to the tick), then orderManager.handleTick()
+	 * and the PnL recording. In instrumented builds, one tick out of
+	 * profileInterval is timed around each step; the sampling keeps the clock
+	 * reads (and their pipeline stalls) off most ticks. Otherwise this is
+	 * exactly the three calls.
+	 * 
+	 * @param onTick Calls the strategy for this tick
+	 * @param tick Tick being processed
+	 */
+	template<typename OnTick, typename TickT>
+	void step(OnTick&& onTick, const TickT& tick) {
+#if BACKTEST_INSTRUMENT
+		if (--profileCountdown == 0) [[unlikely]] {
+			profileCountdown = profileInterval;
+			const uint64_t start = profileClock();
+			onTick();
+			const uint64_t afterOnTick = profileClock();
+			orderManager.handleTick(tick);
+			const uint64_t afterHandleTick = profileClock();
+			statistics.recordPnL(orderManager.getPnL());
+			profile->record(start, afterOnTick, afterHandleTick, profileClock());
+			return;
+		}
+#endif
+		onTick();
+		orderManager.handleTick(tick);
+		statistics.recordPnL(orderManager.getPnL());
+	}
+
+private:
+	/**
+	 * @brief Block loop for one concrete strategy type and tick type
+	 */
+	template<typename StrategyT, typename TickT>
+	static void processTyped(StrategyContext& context, std::span<const TickT> ticks) {
+		StrategyT& strategy = static_cast<StrategyT&>(*context.strategy);
+		if constexpr (std::is_base_of_v<BlockQuoteStrategy, StrategyT>) {
+			context.processBlock([&](BlockOrders& orders) { strategy.StrategyT::onQuotes(ticks, orders); }, ticks);
+		} else if constexpr (std::is_base_of_v<BlockStrategy, StrategyT>) {
+			context.processBlock([&](BlockOrders& orders) { strategy.StrategyT::onTicks(ticks, orders); }, ticks);
+		} else {
+			for (const TickT& tick : ticks) {
+				context.step([&] { strategy.StrategyT::onTick(tick); }, tick);  // Qualified call: no virtual dispatch
+			}
+		}
+	}
+};
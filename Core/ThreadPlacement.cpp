@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "ThreadPlacement.h"
+
+namespace {
+
+/**
+ * @brief Parses a kernel CPU list such as "0-3,8-11,16"
+ */
+std::vector<int> parseCpuList(const std::string& text) {
+	std::vector<int> cpus;
+	std::stringstream list(text);
+	for (std::string range; std::getline(list, range, ',');) {
+		if (range.find_first_not_of(" \n") == std::string::npos) continue;
+		const size_t dash = range.find('-');
+		const int first = std::stoi(range.substr(0, dash));
+		const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+		for (int cpu = first; cpu <= last; cpu++) cpus.push_back(cpu);
+	}
+	return cpus;
+}
+
+} // namespace
+
+/**
+ * @brief Lists the nodes under /sys/devices/system/node, keeping the CPUs of the affinity mask
+ */
+CpuTopology CpuTopology::detect() {
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	const bool masked = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+	auto isAllowed = [&](int cpu) { return !masked || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)); };
+
+	CpuTopology topology;
+	std::error_code error;
+	for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+		const std::string name = entry.path().filename().string();
+		if (name.rfind("node", 0) != 0 || name.size() == 4 || name.find_first_not_of("0123456789", 4) != std::string::npos) continue;
+
+		std::ifstream file(entry.path() / "cpulist");
+		std::string text;
+		if (!std::getline(file, text)) continue;
+
+		std::vector<int> cpus;
+		try {
+			for (int cpu : parseCpuList(text)) {
+				if (isAllowed(cpu)) cpus.push_back(cpu);
+			}
+		} catch (const std::exception&) {
+			continue;  // Unreadable list: treat the node as absent
+		}
+		if (cpus.empty()) continue;
+		topology.nodeIds.push_back(std::stoi(name.substr(4)));
+		topology.nodes.push_back(std::move(cpus));
+	}
+
+	// Nodes in numerical order, so that worker placement is the same from run to run
+	std::vector<size_t> order(topology.nodes.size());
+	for (size_t i = 0; i < order.size(); i++) order[i] = i;
+	std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return topology.nodeIds[a] < topology.nodeIds[b]; });
+	CpuTopology sorted;
+	for (size_t i : order) {
+		sorted.nodeIds.push_back(topology.nodeIds[i]);
+		sorted.nodes.push_back(std::move(topology.nodes[i]));
+	}
+
+	// No NUMA information: one node with every allowed CPU
+	if (sorted.nodes.empty()) {
+		std::vector<int> cpus;
+		const int count = static_cast<int>(std::max(1L, sysconf(_SC_NPROCESSORS_CONF)));
+		for (int cpu = 0; cpu < count; cpu++) {
+			if (isAllowed(cpu)) cpus.push_back(cpu);
+		}
+		if (cpus.empty()) cpus.push_back(0);
+		sorted.nodeIds.push_back(0);
+		sorted.nodes.push_back(std::move(cpus));
+	}
+	return sorted;
+}
+
+std::vector<int> CpuTopology::placeWorkers(size_t workerCount, std::vector<size_t>& nodeOf) const {
+	std::vector<int> cpus(workerCount);
+	nodeOf.assign(workerCount, 0);
+	for (size_t w = 0; w < workerCount; w++) {
+		const size_t node = w % nodes.size();
+		const size_t rank = w / nodes.size();
+		nodeOf[w] = node;
+		cpus[w] = nodes[node][rank % nodes[node].size()];
+	}
+	return cpus;
+}
+
+bool pinCurrentThread(int cpu) {
+	if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+/**
+ * @brief Asks move_pages() where the page is, without moving it (no libnuma needed)
+ */
+int nodeOfAddress(const void* address) {
+#ifdef SYS_move_pages
+	const long pageSize = sysconf(_SC_PAGESIZE);
+	void* page = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(address) & ~static_cast<uintptr_t>(pageSize - 1));
+	int status = -1;
+	if (syscall(SYS_move_pages, 0, 1UL, &page, nullptr, &status, 0) != 0) return -1;
+	return status >= 0 ? status : -1;
+#else
+	return -1;
+#endif
+}
+
+AffinityGuard::AffinityGuard() {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+		saved.resize(sizeof(set));
+		std::memcpy(saved.data(), &set, sizeof(set));
+	}
+}
+
+AffinityGuard::~AffinityGuard() {
+	if (saved.empty()) return;
+	cpu_set_t set;
+	std::memcpy(&set, saved.data(), sizeof(set));
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Where runAll() puts its worker threads and the market data they read
+ */
+enum class ThreadPlacement {
+	OS,      // Wherever the scheduler decides (default)
+	PINNED,  // Each worker pinned to one CPU, workers spread evenly over the NUMA nodes
+	NUMA     // PINNED, and each node's workers read a copy of the ticks in that node's memory
+};
+
+/**
+ * @brief CPUs the process may run on, grouped by NUMA node
+ *
+ * Read from /sys/devices/system/node (Linux) and restricted to the affinity
+ * mask of the process, so a run inside a cpuset or under taskset only sees
+ * the CPUs it got. Without NUMA information, all allowed CPUs form one node.
+ */
+struct CpuTopology {
+	std::vector<int> nodeIds;             // NUMA node number of each entry of nodes
+	std::vector<std::vector<int>> nodes;  // Allowed CPUs of each node (no empty node)
+
+	/**
+	 * @brief Reads the topology of the machine
+	 */
+	static CpuTopology detect();
+
+	/**
+	 * @brief Chooses a CPU for each worker, alternating between nodes
+	 *
+	 * Worker w goes to node w % node count, and within a node the workers take
+	 * the CPUs in order (wrapping around when there are more workers than CPUs).
+	 *
+	 * @param workerCount Number of workers
+	 * @return CPU of each worker, and in nodeOf the node index of each worker
+	 */
+	std::vector<int> placeWorkers(size_t workerCount, std::vector<size_t>& nodeOf) const;
+};
+
+/**
+ * @brief Restricts the calling thread to one CPU
+ *
+ * @return false if the system refused (the thread keeps running where it was)
+ */
+bool pinCurrentThread(int cpu);
+
+/**
+ * @brief Returns the NUMA node holding the memory page of an address
+ *
+ * @return Node number, or -1 if unknown (page not mapped yet, or no NUMA support)
+ */
+int nodeOfAddress(const void* address);
+
+/**
+ * @brief Copies rows of ticks into the memory of the NUMA nodes that need them
+ *
+ * Each copy is allocated and written by a thread pinned to its node, so the
+ * kernel's first-touch policy backs it with that node's memory. The copies
+ * are made in parallel, one thread per node. A node that already holds the
+ * source (checked on its first page) gets no copy.
+ *
+ * @param rows Ticks to copy
+ * @param topology Nodes of the machine
+ * @param needed Per node of the topology: whether workers will run there
+ * @return Per node: its copy, or an empty vector if it reads the source
+ */
+template<typename TickT>
+std::vector<std::vector<TickT>> replicateOnNodes(std::span<const TickT> rows, const CpuTopology& topology, const std::vector<bool>& needed) {
+	std::vector<std::vector<TickT>> replicas(topology.nodes.size());
+	if (rows.empty()) return replicas;
+
+	const int home = nodeOfAddress(rows.data());
+	std::vector<std::thread> copiers;
+	for (size_t node = 0; node < topology.nodes.size(); node++) {
+		if (!needed[node] || topology.nodeIds[node] == home) continue;
+		copiers.emplace_back([&, node] {
+			pinCurrentThread(topology.nodes[node].front());
+			replicas[node].assign(rows.begin(), rows.end());
+		});
+	}
+	for (auto& copier : copiers) copier.join();
+	return replicas;
+}
+
+/**
+ * @brief Restores the CPU affinity the calling thread had when the guard was created
+ *
+ * runAll() runs one of its workers on the calling thread; pinning it for the
+ * run must not leave the caller pinned afterwards.
+ */
+class AffinityGuard {
+private:
+	std::vector<unsigned char> saved;  // Saved cpu_set_t (empty if it couldn't be read)
+
+public:
+	AffinityGuard();
+	~AffinityGuard();
+
+	AffinityGuard(const AffinityGuard&) = delete;
+	AffinityGuard& operator=(const AffinityGuard&) = delete;
+};
@@ -2,19 +2,39 @@
 
 #include <cstdint>
 
+/**
+ * @brief Compact identifier of an instrument
+ * 
+ * Symbols are dense indices (0, 1, 2...) assigned by whoever builds the data,
+ * e.g. the position of the instrument's source in a TickMerger. Per-symbol
+ * state (positions, books, marks) is stored in arrays indexed by SymbolId
+ * instead of maps keyed by name. Single-instrument data uses symbol 0.
+ */
+using SymbolId = uint16_t;
+
 /**
  * @brief Represents a single price tick (trade) in the market
  * 
  * A Tick is the most granular data point in financial markets, representing
  * a single executed trade at a specific price and volume at a specific time.
  * This is the fundamental building block for all market data analysis.
+ * 
+ * The symbol takes the struct from 24 to 32 bytes (the three 8-byte fields
+ * leave no padding to reuse). That is about 20% more time per tick for a scan
+ * streaming ticks from memory, and under 1% of a runAll() tick. The padding
+ * is an explicit, zeroed member so tick files and cached datasets hold the
+ * same bytes for the same ticks.
  */
 struct Tick {
 	uint64_t timestamp;  // Unix timestamp in milliseconds - when this trade occurred
 	double price;        // The execution price of this trade
 	double volume;       // The number of shares/contracts traded in this tick
+	SymbolId symbol = 0; // Instrument this trade belongs to
+	uint16_t padding[3] = {};  // Always 0 (keeps the layout explicit)
 };
 
+static_assert(sizeof(Tick) == 32, "Tick must stay 32 bytes (tick file records)");
+
 /**
  * @brief Represents a quote tick with bid/ask prices (order book data)
  * 
@@ -22,10 +42,17 @@ struct Tick {
  * represents the current best bid and ask prices in the order book.
  * This is useful for strategies that need to see the spread between
  * buy and sell orders, or for simulating more realistic order execution.
+ * 
+ * As for Tick, the symbol grows the struct from 32 to 40 bytes, the padding
+ * zeroed.
  */
 struct QuoteTick {
 	uint64_t timestamp;  // Unix timestamp in milliseconds - when this quote was valid
 	double bid;          // Best bid price (highest price buyers are willing to pay)
 	double ask;          // Best ask price (lowest price sellers are willing to accept)
 	double volume;       // Volume available at these bid/ask levels
-};
\ No newline at end of file
+	SymbolId symbol = 0; // Instrument this quote belongs to
+	uint16_t padding[3] = {};  // Always 0 (keeps the layout explicit)
+};
+
+static_assert(sizeof(QuoteTick) == 40, "QuoteTick must stay 40 bytes (tick file records)");
\ No newline at end of file
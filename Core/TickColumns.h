@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <vector>
+
+#include "Tick.h"
+
+/**
+ * @brief Allocator that aligns every allocation to a cache line
+ *
+ * Column arrays start on a 64-byte boundary, so vectorized kernels can use
+ * aligned loads and a column never shares its first cache line with another
+ * allocation.
+ *
+ * @tparam T Element type
+ * @tparam Alignment Alignment in bytes (power of two)
+ */
+template<typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+	using value_type = T;
+
+	template<typename U>
+	struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+	AlignedAllocator() noexcept = default;
+
+	template<typename U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+	T* allocate(size_t n) {
+		return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+	}
+
+	void deallocate(T* p, size_t) noexcept {
+		::operator delete(p, std::align_val_t(Alignment));
+	}
+
+	template<typename U>
+	bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+};
+
+/**
+ * @brief std::vector whose storage is cache-line aligned
+ */
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+/**
+ * @brief Trade ticks stored as columns (structure of arrays)
+ *
+ * Instead of one array of Tick structs, every field has its own contiguous,
+ * 64-byte aligned array. A scan that only needs prices then streams only the
+ * price column through the cache (8 bytes per tick instead of 32), and loops
+ * over a column can be auto-vectorized or written with SIMD intrinsics.
+ *
+ * Row i is { timestamp[i], price[i], volume[i], symbol[i] }.
+ */
+struct TradeColumns {
+	AlignedVector<uint64_t> timestamp;  // Unix timestamp in milliseconds of each trade
+	AlignedVector<double> price;        // Execution price of each trade
+	AlignedVector<double> volume;       // Volume of each trade
+	AlignedVector<SymbolId> symbol;     // Instrument of each trade
+
+	/**
+	 * @brief Builds columns from an array of ticks
+	 *
+	 * @param ticks Ticks in row layout
+	 * @return The same ticks in column layout
+	 */
+	static TradeColumns fromTicks(std::span<const Tick> ticks) {
+		TradeColumns columns;
+		columns.reserve(ticks.size());
+		for (const Tick& tick : ticks) columns.push_back(tick);
+		return columns;
+	}
+
+	/**
+	 * @brief Returns the number of ticks
+	 */
+	size_t size() const { return price.size(); }
+
+	/**
+	 * @brief Returns true if there are no ticks
+	 */
+	bool empty() const { return price.empty(); }
+
+	/**
+	 * @brief Reserves room in every column
+	 *
+	 * @param n Number of ticks to make room for
+	 */
+	void reserve(size_t n) {
+		timestamp.reserve(n);
+		price.reserve(n);
+		volume.reserve(n);
+		symbol.reserve(n);
+	}
+
+	/**
+	 * @brief Appends one tick
+	 *
+	 * @param tick Tick to append
+	 */
+	void push_back(const Tick& tick) {
+		timestamp.push_back(tick.timestamp);
+		price.push_back(tick.price);
+		volume.push_back(tick.volume);
+		symbol.push_back(tick.symbol);
+	}
+
+	/**
+	 * @brief Rebuilds row i as a Tick
+	 *
+	 * @param i Row index
+	 */
+	Tick operator[](size_t i) const {
+		return Tick{ timestamp[i], price[i], volume[i], symbol[i] };
+	}
+
+	/**
+	 * @brief Copies rows [begin, begin + out.size()) into a row-layout buffer
+	 *
+	 * Used to hand a block of ticks to per-tick strategies; the buffer is
+	 * block-sized and stays in cache.
+	 *
+	 * @param begin First row to copy
+	 * @param out Destination (its size is the number of rows copied)
+	 */
+	void gather(size_t begin, std::span<Tick> out) const {
+		for (size_t i = 0; i < out.size(); i++) {
+			out[i] = Tick{ timestamp[begin + i], price[begin + i], volume[begin + i], symbol[begin + i] };
+		}
+	}
+};
+
+/**
+ * @brief Quote ticks stored as columns (structure of arrays)
+ *
+ * Same idea as TradeColumns for bid/ask data. Row i is
+ * { timestamp[i], bid[i], ask[i], volume[i], symbol[i] }.
+ */
+struct QuoteColumns {
+	AlignedVector<uint64_t> timestamp;  // Unix timestamp in milliseconds of each quote
+	AlignedVector<double> bid;          // Best bid price
+	AlignedVector<double> ask;          // Best ask price
+	AlignedVector<double> volume;       // Volume available at these bid/ask levels
+	AlignedVector<SymbolId> symbol;     // Instrument of each quote
+
+	/**
+	 * @brief Builds columns from an array of quote ticks
+	 *
+	 * @param quotes Quote ticks in row layout
+	 * @return The same quotes in column layout
+	 */
+	static QuoteColumns fromTicks(std::span<const QuoteTick> quotes) {
+		QuoteColumns columns;
+		columns.reserve(quotes.size());
+		for (const QuoteTick& quote : quotes) columns.push_back(quote);
+		return columns;
+	}
+
+	/**
+	 * @brief Returns the number of quote ticks
+	 */
+	size_t size() const { return bid.size(); }
+
+	/**
+	 * @brief Returns true if there are no quote ticks
+	 */
+	bool empty() const { return bid.empty(); }
+
+	/**
+	 * @brief Reserves room in every column
+	 *
+	 * @param n Number of quotes to make room for
+	 */
+	void reserve(size_t n) {
+		timestamp.reserve(n);
+		bid.reserve(n);
+		ask.reserve(n);
+		volume.reserve(n);
+		symbol.reserve(n);
+	}
+
+	/**
+	 * @brief Appends one quote tick
+	 *
+	 * @param quote Quote tick to append
+	 */
+	void push_back(const QuoteTick& quote) {
+		timestamp.push_back(quote.timestamp);
+		bid.push_back(quote.bid);
+		ask.push_back(quote.ask);
+		volume.push_back(quote.volume);
+		symbol.push_back(quote.symbol);
+	}
+
+	/**
+	 * @brief Rebuilds row i as a QuoteTick
+	 *
+	 * @param i Row index
+	 */
+	QuoteTick operator[](size_t i) const {
+		return QuoteTick{ timestamp[i], bid[i], ask[i], volume[i], symbol[i] };
+	}
+
+	/**
+	 * @brief Copies rows [begin, begin + out.size()) into a row-layout buffer
+	 *
+	 * @param begin First row to copy
+	 * @param out Destination (its size is the number of rows copied)
+	 */
+	void gather(size_t begin, std::span<QuoteTick> out) const {
+		for (size_t i = 0; i < out.size(); i++) {
+			out[i] = QuoteTick{ timestamp[begin + i], bid[begin + i], ask[begin + i], volume[begin + i], symbol[begin + i] };
+		}
+	}
+};
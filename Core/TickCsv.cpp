@@ -0,0 +1,326 @@
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "TickCsv.h"
+
+namespace {
+
+constexpr size_t MIN_CHUNK_BYTES = size_t(1) << 20;  // Smaller files use fewer threads
+
+/**
+ * @brief Read-only mapping of a whole text file
+ */
+class MappedText {
+private:
+	void* mapping = nullptr;
+	size_t mappedSize = 0;
+
+public:
+	explicit MappedText(const std::string& path) {
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) throw std::runtime_error("Cannot open CSV file '" + path + "': " + std::strerror(errno));
+
+		struct stat info {};
+		if (::fstat(fd, &info) != 0) {
+			const int error = errno;
+			::close(fd);
+			throw std::runtime_error("Cannot stat CSV file '" + path + "': " + std::strerror(error));
+		}
+
+		mappedSize = static_cast<size_t>(info.st_size);
+		if (mappedSize != 0) {
+			mapping = ::mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapping == MAP_FAILED) {
+				const int error = errno;
+				mapping = nullptr;
+				::close(fd);
+				throw std::runtime_error("Cannot map CSV file '" + path + "': " + std::strerror(error));
+			}
+			::madvise(mapping, mappedSize, MADV_SEQUENTIAL);
+		}
+		::close(fd);  // The mapping keeps the file alive
+	}
+
+	~MappedText() {
+		if (mapping) ::munmap(mapping, mappedSize);
+	}
+
+	MappedText(const MappedText&) = delete;
+	MappedText& operator=(const MappedText&) = delete;
+
+	const char* begin() const { return static_cast<const char*>(mapping); }
+	const char* end() const { return begin() + mappedSize; }
+};
+
+/**
+ * @brief Part of the file parsed by one thread, starting at the beginning of a line
+ */
+struct Chunk {
+	const char* begin;
+	const char* end;
+	size_t firstLine = 0;    // 1-based number of the chunk's first line in the file
+	size_t lines = 0;        // Lines in the chunk, blank ones included
+	size_t records = 0;      // Non-blank lines
+	size_t firstRecord = 0;  // Index of the chunk's first record in the output
+	std::exception_ptr error;
+
+	Chunk(const char* begin, const char* end) : begin(begin), end(end) {}
+};
+
+bool isSpace(char c) { return c == ' ' || c == '\t'; }
+
+const char* skipSpaces(const char* p, const char* end) {
+	while (p != end && isSpace(*p)) ++p;
+	return p;
+}
+
+/**
+ * @brief Calls visit(contentBegin, contentEnd) for every line of [begin, end), without the line break
+ */
+template<typename Visit>
+void forEachLine(const char* begin, const char* end, Visit&& visit) {
+	for (const char* p = begin; p != end; ) {
+		const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+		const char* lineEnd = newline ? newline : end;
+		const char* contentEnd = (lineEnd != p && lineEnd[-1] == '\r') ? lineEnd - 1 : lineEnd;
+		visit(p, contentEnd);
+		p = newline ? newline + 1 : end;
+	}
+}
+
+bool isBlank(const char* begin, const char* end) {
+	return skipSpaces(begin, end) == end;
+}
+
+/**
+ * @brief Parses one field, preceded by the delimiter unless it is the first of the line
+ */
+template<typename V>
+bool parseField(const char*& p, const char* end, char delimiter, bool first, V& value) {
+	if (!first) {
+		if (p == end || *p != delimiter) return false;
+		++p;
+	}
+	p = skipSpaces(p, end);
+	const auto [next, ec] = std::from_chars(p, end, value);
+	if (ec != std::errc()) return false;
+	p = skipSpaces(next, end);
+	return true;
+}
+
+/**
+ * @brief Parses the optional last field (the symbol) and checks nothing follows
+ */
+bool parseSymbol(const char*& p, const char* end, char delimiter, SymbolId& symbol) {
+	symbol = 0;
+	if (p != end && !parseField(p, end, delimiter, false, symbol)) return false;
+	return p == end;
+}
+
+bool parseRecord(const char* p, const char* end, char delimiter, Tick& tick) {
+	return parseField(p, end, delimiter, true, tick.timestamp)
+		&& parseField(p, end, delimiter, false, tick.price)
+		&& parseField(p, end, delimiter, false, tick.volume)
+		&& parseSymbol(p, end, delimiter, tick.symbol);
+}
+
+bool parseRecord(const char* p, const char* end, char delimiter, QuoteTick& quote) {
+	return parseField(p, end, delimiter, true, quote.timestamp)
+		&& parseField(p, end, delimiter, false, quote.bid)
+		&& parseField(p, end, delimiter, false, quote.ask)
+		&& parseField(p, end, delimiter, false, quote.volume)
+		&& parseSymbol(p, end, delimiter, quote.symbol);
+}
+
+/**
+ * @brief Expected line layout of each record type, for error messages
+ */
+template<typename Record> const char* recordLayout();
+template<> const char* recordLayout<Tick>() { return "timestamp,price,volume[,symbol]"; }
+template<> const char* recordLayout<QuoteTick>() { return "timestamp,bid,ask,volume[,symbol]"; }
+
+/**
+ * @brief Runs work(chunk) for every chunk, one thread per chunk (the caller runs the first)
+ *
+ * Exceptions are stored in their chunk so the caller can report the first
+ * bad line of the file, whichever thread saw it first.
+ */
+template<typename Work>
+void forEachChunk(std::vector<Chunk>& chunks, Work&& work) {
+	auto run = [&](Chunk& chunk) {
+		try {
+			work(chunk);
+		} catch (...) {
+			chunk.error = std::current_exception();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(chunks.size() - 1);
+	for (size_t c = 1; c < chunks.size(); c++) threads.emplace_back(run, std::ref(chunks[c]));
+	run(chunks[0]);
+	for (auto& thread : threads) thread.join();
+
+	for (const Chunk& chunk : chunks) {
+		if (chunk.error) std::rethrow_exception(chunk.error);
+	}
+}
+
+/**
+ * @brief Parses a CSV file in parallel
+ *
+ * prepare(recordCount) sizes the output once every chunk has been counted;
+ * store(index, record) is then called concurrently, for distinct indices.
+ */
+template<typename Record, typename Prepare, typename Store>
+void parseCsv(const std::string& path, const CsvOptions& options, Prepare&& prepare, Store&& store) {
+	const MappedText text(path);
+	const char* begin = text.begin();
+	const char* end = text.end();
+
+	// A first line that doesn't start with a number is a header
+	size_t firstLine = 1;
+	if (begin != end) {
+		const char* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+		const char* first = skipSpaces(begin, newline ? newline : end);
+		if (first != end && *first != '\n' && *first != '\r' && (*first < '0' || *first > '9')) {
+			begin = newline ? newline + 1 : end;
+			firstLine = 2;
+		}
+	}
+
+	// One chunk per thread, each starting right after a line break
+	const size_t bytes = end - begin;
+	const size_t threads = options.threadCount != 0 ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+	const size_t chunkCount = std::max<size_t>(1, std::min(threads, bytes / MIN_CHUNK_BYTES));
+
+	std::vector<Chunk> chunks;
+	chunks.reserve(chunkCount);
+	const char* chunkBegin = begin;
+	for (size_t c = 1; c <= chunkCount; c++) {
+		const char* chunkEnd = end;
+		if (c < chunkCount) {
+			const char* cut = std::max(chunkBegin, begin + bytes / chunkCount * c);
+			const char* newline = static_cast<const char*>(std::memchr(cut, '\n', end - cut));
+			chunkEnd = newline ? newline + 1 : end;
+		}
+		chunks.emplace_back(chunkBegin, chunkEnd);
+		chunkBegin = chunkEnd;
+	}
+
+	// Pass 1: count the lines and records of every chunk
+	forEachChunk(chunks, [](Chunk& chunk) {
+		forEachLine(chunk.begin, chunk.end, [&](const char* line, const char* lineEnd) {
+			chunk.lines++;
+			if (!isBlank(line, lineEnd)) chunk.records++;
+		});
+	});
+
+	size_t records = 0;
+	size_t line = firstLine;
+	for (Chunk& chunk : chunks) {
+		chunk.firstRecord = records;
+		chunk.firstLine = line;
+		records += chunk.records;
+		line += chunk.lines;
+	}
+	prepare(records);
+
+	// Pass 2: parse every chunk into its own range of the output
+	const char delimiter = options.delimiter;
+	forEachChunk(chunks, [&](Chunk& chunk) {
+		size_t index = chunk.firstRecord;
+		size_t lineNumber = chunk.firstLine;
+		forEachLine(chunk.begin, chunk.end, [&](const char* line, const char* lineEnd) {
+			if (!isBlank(line, lineEnd)) {
+				Record record;
+				if (!parseRecord(line, lineEnd, delimiter, record)) {
+					throw std::runtime_error("CSV file '" + path + "' line " + std::to_string(lineNumber)
+						+ ": expected " + recordLayout<Record>() + ", got '" + std::string(line, lineEnd) + "'.");
+				}
+				store(index++, record);
+			}
+			lineNumber++;
+		});
+	});
+}
+
+template<typename Record>
+std::vector<Record> readRows(const std::string& path, const CsvOptions& options) {
+	std::vector<Record> rows;
+	parseCsv<Record>(path, options,
+		[&](size_t count) { rows.resize(count); },
+		[&](size_t i, const Record& record) { rows[i] = record; });
+	return rows;
+}
+
+} // namespace
+
+std::vector<Tick> readTradeCsv(const std::string& path, const CsvOptions& options) {
+	return readRows<Tick>(path, options);
+}
+
+std::vector<QuoteTick> readQuoteCsv(const std::string& path, const CsvOptions& options) {
+	return readRows<QuoteTick>(path, options);
+}
+
+TradeColumns readTradeCsvColumns(const std::string& path, const CsvOptions& options) {
+	TradeColumns columns;
+	parseCsv<Tick>(path, options,
+		[&](size_t count) {
+			columns.timestamp.resize(count);
+			columns.price.resize(count);
+			columns.volume.resize(count);
+			columns.symbol.resize(count);
+		},
+		[&](size_t i, const Tick& tick) {
+			columns.timestamp[i] = tick.timestamp;
+			columns.price[i] = tick.price;
+			columns.volume[i] = tick.volume;
+			columns.symbol[i] = tick.symbol;
+		});
+	return columns;
+}
+
+QuoteColumns readQuoteCsvColumns(const std::string& path, const CsvOptions& options) {
+	QuoteColumns columns;
+	parseCsv<QuoteTick>(path, options,
+		[&](size_t count) {
+			columns.timestamp.resize(count);
+			columns.bid.resize(count);
+			columns.ask.resize(count);
+			columns.volume.resize(count);
+			columns.symbol.resize(count);
+		},
+		[&](size_t i, const QuoteTick& quote) {
+			columns.timestamp[i] = quote.timestamp;
+			columns.bid[i] = quote.bid;
+			columns.ask[i] = quote.ask;
+			columns.volume[i] = quote.volume;
+			columns.symbol[i] = quote.symbol;
+		});
+	return columns;
+}
+
+size_t convertCsvToTickFile(const std::string& csvPath, const std::string& tickPath, TickRecordType type, const CsvOptions& options) {
+	if (type == TickRecordType::QUOTE) {
+		const std::vector<QuoteTick> quotes = readQuoteCsv(csvPath, options);
+		writeTickFile(tickPath, quotes);
+		return quotes.size();
+	}
+	const std::vector<Tick> ticks = readTradeCsv(csvPath, options);
+	writeTickFile(tickPath, ticks);
+	return ticks.size();
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Tick.h"
+#include "TickColumns.h"
+#include "TickFile.h"
+
+/**
+ * @brief How CSV tick files are read
+ *
+ * Every line is one record, its fields in struct order:
+ * - trades: timestamp,price,volume[,symbol]
+ * - quotes: timestamp,bid,ask,volume[,symbol]
+ *
+ * The timestamp is an integer (milliseconds for recorded data), the symbol
+ * an optional SymbolId (0 if absent). Spaces around fields, blank lines and
+ * CRLF line endings are accepted, and a first line that doesn't start with a
+ * number is skipped as a header. Records must already be in time order.
+ */
+struct CsvOptions {
+	char delimiter = ',';    // Field separator
+	size_t threadCount = 0;  // Parsing threads (0 = one per hardware thread)
+};
+
+/**
+ * @brief Reads a CSV file of trade ticks
+ *
+ * The file is memory-mapped and split into one chunk per thread at line
+ * boundaries. A first pass counts the records of every chunk, so the output
+ * is allocated once and each thread then parses its chunk with
+ * std::from_chars straight into its own range of the result.
+ *
+ * @param path Path of the CSV file
+ * @param options Delimiter and number of threads
+ * @return The ticks, in file order
+ * @throws std::runtime_error If the file can't be read or a line is malformed (the message gives its line number)
+ */
+std::vector<Tick> readTradeCsv(const std::string& path, const CsvOptions& options = {});
+
+/**
+ * @brief Reads a CSV file of quote ticks
+ *
+ * Same as readTradeCsv() for quote ticks.
+ */
+std::vector<QuoteTick> readQuoteCsv(const std::string& path, const CsvOptions& options = {});
+
+/**
+ * @brief Reads a CSV file of trade ticks into column layout
+ *
+ * Same as readTradeCsv(), each thread writing its rows straight into the
+ * columns (no intermediate row array).
+ */
+TradeColumns readTradeCsvColumns(const std::string& path, const CsvOptions& options = {});
+
+/**
+ * @brief Reads a CSV file of quote ticks into column layout
+ *
+ * Same as readTradeCsvColumns() for quote ticks.
+ */
+QuoteColumns readQuoteCsvColumns(const std::string& path, const CsvOptions& options = {});
+
+/**
+ * @brief Converts a CSV tick file into a binary tick file
+ *
+ * Parsing is paid once: later runs map the binary file (MappedTickFile,
+ * BacktestEngine::loadTickFile()) and start without reading the CSV again.
+ * The records are held in memory between the two steps.
+ *
+ * @param csvPath Path of the CSV file
+ * @param tickPath Path of the binary tick file (overwritten if it exists)
+ * @param type Whether the CSV holds trades or quotes
+ * @param options Delimiter and number of threads
+ * @return Number of records converted
+ * @throws std::runtime_error If the CSV can't be read or parsed, or the tick file can't be written
+ */
+size_t convertCsvToTickFile(const std::string& csvPath, const std::string& tickPath, TickRecordType type, const CsvOptions& options = {});
@@ -0,0 +1,153 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "TickFile.h"
+
+namespace {
+
+constexpr char TICK_FILE_MAGIC[8] = { 'B', 'T', 'T', 'I', 'C', 'K', 'S', '\0' };
+
+/**
+ * @brief Record type stored in the header for each record struct
+ */
+template<typename T> constexpr TickRecordType recordTypeOf();
+template<> constexpr TickRecordType recordTypeOf<Tick>() { return TickRecordType::TRADE; }
+template<> constexpr TickRecordType recordTypeOf<QuoteTick>() { return TickRecordType::QUOTE; }
+
+/**
+ * @brief Builds an error message with the path and the system error text
+ */
+std::runtime_error fileError(const std::string& what, const std::string& path) {
+	return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+
+/**
+ * @brief Writes the header followed by the raw records
+ *
+ * Records are written in one fwrite() straight from the caller's array - the
+ * file layout is the in-memory layout, so there is nothing to convert.
+ */
+template<typename T>
+void writeRecords(const std::string& path, std::span<const T> records) {
+	FILE* file = std::fopen(path.c_str(), "wb");
+	if (!file) throw fileError("Cannot create tick file", path);
+
+	TickFileHeader header{};
+	std::memcpy(header.magic, TICK_FILE_MAGIC, sizeof(header.magic));
+	header.version = TICK_FILE_VERSION;
+	header.recordType = static_cast<uint32_t>(recordTypeOf<T>());
+	header.recordSize = sizeof(T);
+	header.count = records.size();
+
+	bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+	if (ok && !records.empty()) ok = std::fwrite(records.data(), sizeof(T), records.size(), file) == records.size();
+	ok = (std::fclose(file) == 0) && ok;
+
+	if (!ok) throw fileError("Cannot write tick file", path);
+}
+
+} // namespace
+
+void writeTickFile(const std::string& path, std::span<const Tick> ticks) {
+	writeRecords(path, ticks);
+}
+
+void writeTickFile(const std::string& path, std::span<const QuoteTick> quotes) {
+	writeRecords(path, quotes);
+}
+
+/**
+ * @brief Maps the whole file read-only and checks the header against T
+ */
+template<typename T>
+MappedTickFile<T>::MappedTickFile(const std::string& path) {
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) throw fileError("Cannot open tick file", path);
+
+	struct stat info {};
+	if (::fstat(fd, &info) != 0) {
+		::close(fd);
+		throw fileError("Cannot stat tick file", path);
+	}
+	if (static_cast<size_t>(info.st_size) < sizeof(TickFileHeader)) {
+		::close(fd);
+		throw std::runtime_error("Tick file '" + path + "' is too small to hold a header.");
+	}
+
+	mappedSize = static_cast<size_t>(info.st_size);
+	mapping = ::mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);  // The mapping keeps the file alive
+	if (mapping == MAP_FAILED) {
+		mapping = nullptr;
+		throw fileError("Cannot map tick file", path);
+	}
+
+	// Validate the header before handing out any record
+	const auto* header = static_cast<const TickFileHeader*>(mapping);
+	std::string problem;
+	if (std::memcmp(header->magic, TICK_FILE_MAGIC, sizeof(header->magic)) != 0) {
+		problem = "is not a tick file";
+	} else if (header->version != TICK_FILE_VERSION) {
+		problem = "has unsupported version " + std::to_string(header->version);
+	} else if (header->recordType != static_cast<uint32_t>(recordTypeOf<T>()) || header->recordSize != sizeof(T)) {
+		problem = "does not contain records of the requested tick type";
+	} else if (header->count > (mappedSize - sizeof(TickFileHeader)) / sizeof(T)) {
+		problem = "is truncated";
+	}
+	if (!problem.empty()) {
+		unmap();
+		throw std::runtime_error("Tick file '" + path + "' " + problem + ".");
+	}
+
+	// The backtest reads the file front to back - let the kernel read ahead
+	::madvise(mapping, mappedSize, MADV_SEQUENTIAL);
+
+	const auto* first = reinterpret_cast<const T*>(static_cast<const char*>(mapping) + sizeof(TickFileHeader));
+	records = std::span<const T>(first, static_cast<size_t>(header->count));
+}
+
+template<typename T>
+MappedTickFile<T>::~MappedTickFile() {
+	unmap();
+}
+
+template<typename T>
+MappedTickFile<T>::MappedTickFile(MappedTickFile&& other) noexcept
+	: mapping(std::exchange(other.mapping, nullptr)),
+	  mappedSize(std::exchange(other.mappedSize, 0)),
+	  records(std::exchange(other.records, {})) {
+}
+
+template<typename T>
+MappedTickFile<T>& MappedTickFile<T>::operator=(MappedTickFile&& other) noexcept {
+	if (this != &other) {
+		unmap();
+		mapping = std::exchange(other.mapping, nullptr);
+		mappedSize = std::exchange(other.mappedSize, 0);
+		records = std::exchange(other.records, {});
+	}
+	return *this;
+}
+
+/**
+ * @brief Releases the mapping (no-op if nothing is mapped)
+ */
+template<typename T>
+void MappedTickFile<T>::unmap() {
+	if (mapping) ::munmap(mapping, mappedSize);
+	mapping = nullptr;
+	mappedSize = 0;
+	records = {};
+}
+
+// The only record types a tick file can hold
+template class MappedTickFile<Tick>;
+template class MappedTickFile<QuoteTick>;
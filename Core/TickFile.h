@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "Tick.h"
+
+/**
+ * @brief Kind of records stored in a tick file
+ */
+enum class TickRecordType : uint32_t {
+	TRADE = 1,  // Records are Tick
+	QUOTE = 2   // Records are QuoteTick
+};
+
+/**
+ * @brief Header at the start of every binary tick file
+ *
+ * File layout:
+ * - TickFileHeader (32 bytes)
+ * - count fixed-size records, each one exactly the in-memory layout of Tick or
+ *   QuoteTick (native byte order, no padding between records)
+ *
+ * Because the records have the same layout as the structs, a mapped file can
+ * be used directly as a Tick array without any parsing or copying. The header
+ * is 32 bytes so the records that follow stay 8-byte aligned.
+ *
+ * The header records the record size, so a file written by a build with a
+ * different Tick layout is rejected instead of being silently misread.
+ */
+struct TickFileHeader {
+	char magic[8];          // "BTTICKS\0"
+	uint32_t version;       // Format version (TICK_FILE_VERSION)
+	uint32_t recordType;    // TickRecordType of the records
+	uint32_t recordSize;    // sizeof(Tick) or sizeof(QuoteTick) of the writer
+	uint32_t reserved;      // Always 0 (keeps the header at 32 bytes)
+	uint64_t count;         // Number of records following the header
+};
+
+static_assert(sizeof(TickFileHeader) == 32, "TickFileHeader must stay 32 bytes");
+
+constexpr uint32_t TICK_FILE_VERSION = 2;  // 2: records carry a SymbolId
+
+/**
+ * @brief Writes trade ticks to a binary tick file
+ *
+ * @param path Output file path (overwritten if it exists)
+ * @param ticks Ticks to write
+ * @throws std::runtime_error If the file can't be written
+ */
+void writeTickFile(const std::string& path, std::span<const Tick> ticks);
+
+/**
+ * @brief Writes quote ticks to a binary tick file
+ *
+ * @param path Output file path (overwritten if it exists)
+ * @param quotes Quote ticks to write
+ * @throws std::runtime_error If the file can't be written
+ */
+void writeTickFile(const std::string& path, std::span<const QuoteTick> quotes);
+
+/**
+ * @brief Read-only memory mapping of a binary tick file
+ *
+ * The file is mapped with mmap(), so opening it costs the same for 1 MB or
+ * 100 GB: pages are only read from disk when the backtest first touches them,
+ * and the OS can drop them again under memory pressure. The mapping is
+ * advised as sequential so the kernel reads ahead of the backtest.
+ *
+ * The mapping is released when the object is destroyed. Objects can be moved
+ * but not copied.
+ *
+ * @tparam T Tick or QuoteTick
+ */
+template<typename T>
+class MappedTickFile {
+private:
+	void* mapping = nullptr;     // Start of the mapped file (header included)
+	size_t mappedSize = 0;       // Size of the mapping in bytes
+	std::span<const T> records;  // The records following the header
+
+	void unmap();
+
+public:
+	/**
+	 * @brief Maps a tick file and validates its header
+	 *
+	 * @param path Path of a file written by writeTickFile()
+	 * @throws std::runtime_error If the file can't be opened or mapped, or its header doesn't match T
+	 */
+	explicit MappedTickFile(const std::string& path);
+
+	~MappedTickFile();
+
+	MappedTickFile(MappedTickFile&& other) noexcept;
+	MappedTickFile& operator=(MappedTickFile&& other) noexcept;
+	MappedTickFile(const MappedTickFile&) = delete;
+	MappedTickFile& operator=(const MappedTickFile&) = delete;
+
+	/**
+	 * @brief Returns the records of the file, straight from the mapping
+	 */
+	std::span<const T> ticks() const { return records; }
+
+	/**
+	 * @brief Returns the number of records in the file
+	 */
+	size_t size() const { return records.size(); }
+};
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Tick.h"
+#include "TickSource.h"
+
+/**
+ * @brief Merges per-symbol tick sources into one timestamp-ordered stream
+ *
+ * Each source is one instrument, in time order; the merger stamps every tick
+ * with the symbol its source was added with and outputs all of them in
+ * timestamp order (ties go to the source added first, so the output is
+ * deterministic).
+ *
+ * The merge is a loser tree (tournament tree): the k sources are the leaves,
+ * each internal node remembers the loser of the match played there and the
+ * root holds the overall winner. Taking the next tick replays only the path
+ * from the winner's leaf to the root - one comparison per level, log2(k)
+ * comparisons per tick, against 2 * log2(k) for a binary heap.
+ *
+ * Memory is bounded: each source gets a fixed buffer of chunkSize ticks,
+ * refilled through TickSource::read() when it runs out, so a 500-symbol
+ * universe needs 500 * chunkSize ticks in memory however long the sources
+ * are. Nothing is allocated after the last addSource().
+ *
+ * A merger is itself a TickSource, so merged streams can be fed to anything
+ * that reads a source, including another merger.
+ *
+ * @tparam TickT Tick or QuoteTick
+ */
+template<typename TickT>
+class TickMerger : public TickSource<TickT> {
+private:
+	/**
+	 * @brief One source and its buffered chunk
+	 */
+	struct Input {
+		TickSource<TickT>* source;  // Not owned
+		SymbolId symbol;            // Stamped on every tick of the source
+		std::vector<TickT> buffer;  // Current chunk
+		size_t position = 0;        // Next tick of the chunk
+		size_t count = 0;           // Ticks in the chunk
+		uint64_t lastTimestamp = 0; // Timestamp of the last tick output (order check)
+		bool exhausted = false;     // Source has no more ticks
+	};
+
+	std::vector<Input> inputs;
+	std::vector<uint32_t> tree;     // tree[0] = winner, tree[1..k-1] = loser of each match
+	size_t chunkSize;
+	bool started = false;           // Tree is built on the first read()
+
+	/**
+	 * @brief Returns true if input a's next tick goes before input b's
+	 */
+	bool before(uint32_t a, uint32_t b) const {
+		const Input& ia = inputs[a];
+		const Input& ib = inputs[b];
+		if (ia.exhausted != ib.exhausted) return ib.exhausted;  // Exhausted inputs lose every match
+		if (ia.exhausted) return a < b;
+		const uint64_t ta = ia.buffer[ia.position].timestamp;
+		const uint64_t tb = ib.buffer[ib.position].timestamp;
+		return ta < tb || (ta == tb && a < b);
+	}
+
+	/**
+	 * @brief Loads the next chunk of an input, marking it exhausted at the end of its source
+	 */
+	void refill(Input& input) {
+		input.count = input.source->read(input.buffer);
+		input.position = 0;
+		input.exhausted = input.count == 0;
+	}
+
+	/**
+	 * @brief Plays the initial tournament bottom-up
+	 *
+	 * Leaf i is node k + i; node n's children are 2n and 2n + 1. Winners are
+	 * only needed while building, losers stay in the tree.
+	 */
+	void build() {
+		const size_t k = inputs.size();
+		for (Input& input : inputs) refill(input);
+
+		std::vector<uint32_t> winners(k);  // winners[n] = winner of the match at node n
+		auto winnerOf = [&](size_t node) { return node >= k ? static_cast<uint32_t>(node - k) : winners[node]; };
+		for (size_t node = k - 1; node >= 1; node--) {
+			const uint32_t left = winnerOf(2 * node);
+			const uint32_t right = winnerOf(2 * node + 1);
+			if (before(left, right)) {
+				winners[node] = left;
+				tree[node] = right;
+			} else {
+				winners[node] = right;
+				tree[node] = left;
+			}
+		}
+		tree[0] = k > 1 ? winners[1] : 0;
+		started = true;
+	}
+
+	/**
+	 * @brief Moves past the winner's tick and replays its path to the root
+	 */
+	void advance(uint32_t winner) {
+		Input& input = inputs[winner];
+		if (++input.position == input.count) refill(input);
+		if (!input.exhausted && input.buffer[input.position].timestamp < input.lastTimestamp) {
+			throw std::runtime_error("Tick source of symbol " + std::to_string(input.symbol) + " is not in time order.");
+		}
+
+		for (size_t node = (winner + inputs.size()) / 2; node >= 1; node /= 2) {
+			if (before(tree[node], winner)) std::swap(tree[node], winner);
+		}
+		tree[0] = winner;
+	}
+
+public:
+	/**
+	 * @brief Creates a merger with no source
+	 *
+	 * @param chunkSize Ticks buffered per source (must be > 0)
+	 */
+	explicit TickMerger(size_t chunkSize = 1024) : chunkSize(chunkSize) {
+		if (chunkSize == 0) throw std::invalid_argument("Merger chunk size must be greater than 0.");
+	}
+
+	/**
+	 * @brief Adds the source of one symbol
+	 *
+	 * Must be called before the first read(). The source is not owned and
+	 * must outlive the merger.
+	 *
+	 * @param source Ticks of the symbol, in time order (their symbol field is overwritten)
+	 * @param symbol Symbol written into every tick of the source
+	 * @throws std::logic_error If reading has already started
+	 */
+	void addSource(TickSource<TickT>& source, SymbolId symbol) {
+		if (started) throw std::logic_error("Sources must be added before the first read.");
+		inputs.push_back(Input{ &source, symbol, std::vector<TickT>(chunkSize) });
+		tree.resize(inputs.size());
+	}
+
+	/**
+	 * @brief Returns the number of sources
+	 */
+	size_t sourceCount() const { return inputs.size(); }
+
+	/**
+	 * @brief Writes the next ticks of the merged stream
+	 *
+	 * @param out Destination (fills at most out.size() ticks)
+	 * @return Number of ticks written, 0 once every source is exhausted
+	 * @throws std::runtime_error If a source goes back in time
+	 */
+	size_t read(std::span<TickT> out) override {
+		if (inputs.empty()) return 0;
+		if (!started) build();
+
+		size_t written = 0;
+		while (written < out.size()) {
+			const uint32_t winner = tree[0];
+			Input& input = inputs[winner];
+			if (input.exhausted) break;  // The best input is empty, so all are
+
+			TickT& tick = out[written++];
+			tick = input.buffer[input.position];
+			tick.symbol = input.symbol;
+			input.lastTimestamp = tick.timestamp;
+			advance(winner);
+		}
+		return written;
+	}
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "Tick.h"
+#include "TickColumns.h"
+
+/**
+ * @brief Read-only view of a tick stream stored either as rows or as columns
+ *
+ * The engine and the parameter sweep walk market data block by block. This
+ * view hides where the data lives:
+ * - Rows (a span over a vector or a memory-mapped tick file): a block is a subspan, nothing is copied
+ * - Columns (TradeColumns/QuoteColumns): a block is gathered into a small
+ *   caller-provided scratch buffer that stays in L1/L2, so per-tick strategies
+ *   keep their onTick(const Tick&) interface
+ *
+ * The view does not own the data - it must outlive every run that uses it.
+ *
+ * @tparam TickT Tick or QuoteTick
+ * @tparam ColumnsT TradeColumns or QuoteColumns
+ */
+template<typename TickT, typename ColumnsT>
+class TickSeries {
+private:
+	std::span<const TickT> rows;       // Row storage (if not columnar)
+	const ColumnsT* columns = nullptr; // Column storage (if columnar)
+
+public:
+	TickSeries() = default;
+
+	/**
+	 * @brief Views ticks stored as rows
+	 */
+	TickSeries(std::span<const TickT> rows) : rows(rows) {}
+
+	/**
+	 * @brief Views ticks stored as columns
+	 */
+	TickSeries(const ColumnsT& columns) : columns(&columns) {}
+
+	/**
+	 * @brief Returns the number of ticks
+	 */
+	size_t size() const { return columns ? columns->size() : rows.size(); }
+
+	/**
+	 * @brief Returns true if there are no ticks
+	 */
+	bool empty() const { return size() == 0; }
+
+	/**
+	 * @brief Returns the row storage (empty if the ticks are stored as columns)
+	 */
+	std::span<const TickT> getRows() const { return rows; }
+
+	/**
+	 * @brief Returns the column storage, or nullptr if the ticks are stored as rows
+	 */
+	const ColumnsT* getColumns() const { return columns; }
+
+	/**
+	 * @brief Returns ticks [begin, begin + count) as a contiguous row block
+	 *
+	 * @param begin First tick of the block
+	 * @param count Number of ticks (clamped to the end of the series)
+	 * @param scratch Buffer used when the data is columnar (resized as needed, reuse it across blocks)
+	 * @return The block - pointing into the row data, or into scratch
+	 */
+	std::span<const TickT> block(size_t begin, size_t count, std::vector<TickT>& scratch) const {
+		if (begin >= size()) return {};
+		if (count > size() - begin) count = size() - begin;
+
+		if (!columns) return rows.subspan(begin, count);
+
+		scratch.resize(count);
+		columns->gather(begin, scratch);
+		return scratch;
+	}
+};
+
+/**
+ * @brief Trade tick stream (rows or columns)
+ */
+using TradeSeries = TickSeries<Tick, TradeColumns>;
+
+/**
+ * @brief Quote tick stream (rows or columns)
+ */
+using QuoteSeries = TickSeries<QuoteTick, QuoteColumns>;
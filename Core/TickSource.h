@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+#include "Tick.h"
+
+/**
+ * @brief Stream of ticks read in chunks, in time order
+ *
+ * The common interface of anything that produces market data incrementally
+ * (in-memory arrays, mapped tick files, merged multi-symbol streams...).
+ * Reading a chunk at a time keeps the virtual call out of the per-tick path.
+ *
+ * @tparam TickT Tick or QuoteTick
+ */
+template<typename TickT>
+class TickSource {
+public:
+	virtual ~TickSource() = default;
+
+	/**
+	 * @brief Copies the next ticks of the stream into a buffer
+	 *
+	 * @param out Destination (fills at most out.size() ticks)
+	 * @return Number of ticks written, 0 once the stream is exhausted
+	 */
+	virtual size_t read(std::span<TickT> out) = 0;
+};
+
+/**
+ * @brief Tick source reading from a contiguous array
+ *
+ * The array is not copied and must outlive the source. Works with vectors as
+ * well as with the mapping of a MappedTickFile.
+ *
+ * @tparam TickT Tick or QuoteTick
+ */
+template<typename TickT>
+class SpanTickSource : public TickSource<TickT> {
+private:
+	std::span<const TickT> ticks;  // Whole stream
+	size_t position = 0;           // Next tick to read
+
+public:
+	explicit SpanTickSource(std::span<const TickT> ticks) : ticks(ticks) {}
+
+	size_t read(std::span<TickT> out) override {
+		const size_t count = std::min(out.size(), ticks.size() - position);
+		std::copy_n(ticks.begin() + position, count, out.begin());
+		position += count;
+		return count;
+	}
+};
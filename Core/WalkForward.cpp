@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "WalkForward.h"
+#include "StrategyContext.h"
+#include "Statistiques.h"
+#include "RunArena.h"
+
+namespace {
+
+/**
+ * @brief State of a training pass at a test boundary, shared by the folds forking from it
+ */
+struct Checkpoint {
+	OrderManager orderManager;      // Positions, cash and resting orders
+	StatsMap trainStats;            // Statistics of the training window
+	std::vector<std::byte> state;   // Strategy::saveState() output
+	bool saved;                     // false if the strategy can't be checkpointed
+};
+
+} // namespace
+
+/**
+ * @brief Creates a runner that reads the given (caller-owned) data
+ */
+WalkForward::WalkForward(TradeSeries ticks, QuoteSeries quotes)
+	: ticks(ticks), quotes(quotes) {
+}
+
+/**
+ * @brief Sets the number of worker threads
+ */
+void WalkForward::setThreadCount(size_t count) {
+	threadCount = count;
+}
+
+std::vector<WalkForwardFold> WalkForward::anchored(size_t tickCount, size_t firstTestBegin, size_t testSize) {
+	if (firstTestBegin == 0 || testSize == 0) throw std::invalid_argument("Walk-forward windows must not be empty.");
+
+	std::vector<WalkForwardFold> folds;
+	for (size_t testBegin = firstTestBegin; testBegin + testSize <= tickCount; testBegin += testSize) {
+		folds.push_back(WalkForwardFold{ 0, testBegin, testBegin + testSize });
+	}
+	return folds;
+}
+
+std::vector<WalkForwardFold> WalkForward::rolling(size_t tickCount, size_t trainSize, size_t testSize) {
+	if (trainSize == 0 || testSize == 0) throw std::invalid_argument("Walk-forward windows must not be empty.");
+
+	std::vector<WalkForwardFold> folds;
+	for (size_t trainBegin = 0; trainBegin + trainSize + testSize <= tickCount; trainBegin += testSize) {
+		folds.push_back(WalkForwardFold{ trainBegin, trainBegin + trainSize, trainBegin + trainSize + testSize });
+	}
+	return folds;
+}
+
+/**
+ * @brief Connects a fresh context and checks that it has data
+ */
+void WalkForward::prepare(StrategyContext& context) const {
+	context.statistics.setStoreSeries(false);
+	context.setup();
+
+	if (context.quoteStrategy ? quotes.empty() : ticks.empty()) {
+		throw std::runtime_error("No data available for backtest.");
+	}
+	if (ticks.getColumns() || quotes.getColumns()) {
+		context.strategy->setColumnarData(ticks.getColumns(), quotes.getColumns());
+	}
+}
+
+/**
+ * @brief Runs a context over ticks [begin, end) of the data it consumes
+ *
+ * Row data is processed as one block; columnar data is gathered block by block.
+ */
+void WalkForward::runRange(StrategyContext& context, size_t begin, size_t end) const {
+	if (context.quoteStrategy) {
+		std::vector<QuoteTick> scratch;
+		const size_t step = quotes.getColumns() ? blockSize : end - begin;
+		for (size_t at = begin; at < end; at += step) {
+			context.process(quotes.block(at, std::min(step, end - at), scratch));
+		}
+	} else {
+		std::vector<Tick> scratch;
+		const size_t step = ticks.getColumns() ? blockSize : end - begin;
+		for (size_t at = begin; at < end; at += step) {
+			context.process(ticks.block(at, std::min(step, end - at), scratch));
+		}
+	}
+}
+
+/**
+ * @brief Runs the training passes and the forks on a pool of workers
+ *
+ * 1. Folds are grouped by training start; each group is one task, the
+ *    training pass, which visits the group's test boundaries in order
+ * 2. At each boundary the pass takes a checkpoint and posts one fork task
+ *    per fold ending its training there, then carries on
+ * 3. A fork restores a fresh context from the checkpoint (or replays the
+ *    training window if the strategy couldn't be saved), then runs the test
+ *    window with a fresh StatsCollector
+ *
+ * Workers take tasks from one shared queue and stop when it is empty and no
+ * task is running (a running pass may still post forks). Each worker runs its
+ * tasks' contexts in its own RunArena, reset after every task; checkpoints are
+ * copied out of it with the default resource, since their forks may run on
+ * other workers. Each result is
+ * written to its own slot. After a failure, remaining tasks are skipped and
+ * the first exception is rethrown once all workers have stopped.
+ */
+std::vector<WalkForwardResult> WalkForward::run(std::span<const WalkForwardFold> folds, const StrategyBuilder& builder, TimeFrame tf, double initialCash) const {
+	std::vector<WalkForwardResult> results(folds.size());
+	if (folds.empty()) return results;
+
+	// Training start -> folds, ordered by test boundary
+	std::map<size_t, std::vector<size_t>> groups;
+	for (size_t i = 0; i < folds.size(); i++) {
+		const WalkForwardFold& fold = folds[i];
+		if (!(fold.trainBegin < fold.testBegin && fold.testBegin < fold.testEnd)) {
+			throw std::invalid_argument("Walk-forward folds need trainBegin < testBegin < testEnd.");
+		}
+		groups[fold.trainBegin].push_back(i);
+	}
+	for (auto& [trainBegin, members] : groups) {
+		std::stable_sort(members.begin(), members.end(), [&](size_t a, size_t b) { return folds[a].testBegin < folds[b].testBegin; });
+	}
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::deque<std::function<void(RunArena&)>> tasks;
+	size_t unfinished = 0;             // Tasks queued or running
+	std::atomic<bool> failed{ false };
+	std::exception_ptr error;
+
+	auto post = [&](std::function<void(RunArena&)> task) {
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(std::move(task));
+		unfinished++;
+		wake.notify_one();
+	};
+
+	auto fork = [&](RunArena& arena, size_t index, std::shared_ptr<const Checkpoint> checkpoint) {
+		const WalkForwardFold& fold = folds[index];
+		StrategyContext context("walk_forward", builder(), tf, initialCash, arena.resource());
+		if (checkpoint->saved) {
+			context.orderManager = checkpoint->orderManager;
+			prepare(context);
+			StateReader reader(checkpoint->state);
+			context.strategy->restoreState(reader);
+		} else {
+			prepare(context);
+			context.strategy->onStart();
+			runRange(context, fold.trainBegin, fold.testBegin);
+			context.statistics = StatsCollector(false, arena.resource());
+			registerUserStats(context.statistics, tf);
+		}
+		runRange(context, fold.testBegin, fold.testEnd);
+		results[index] = WalkForwardResult{ fold, checkpoint->trainStats, context.finish(), checkpoint->saved };
+	};
+
+	auto train = [&](RunArena& arena, size_t trainBegin, const std::vector<size_t>& members) {
+		StrategyContext context("walk_forward", builder(), tf, initialCash, arena.resource());
+		prepare(context);
+		const size_t available = context.quoteStrategy ? quotes.size() : ticks.size();
+		for (size_t index : members) {
+			if (folds[index].testEnd > available) throw std::invalid_argument("Walk-forward fold extends past the end of the data.");
+		}
+		context.strategy->onStart();
+
+		size_t position = trainBegin;
+		for (size_t m = 0; m < members.size() && !failed.load(std::memory_order_relaxed); ) {
+			const size_t boundary = folds[members[m]].testBegin;
+			runRange(context, position, boundary);
+			position = boundary;
+
+			StatsCollector trained = context.statistics.snapshot();
+			registerUserStats(trained, tf);
+			StateWriter writer;
+			const bool saved = context.strategy->saveState(writer);
+			auto checkpoint = std::make_shared<const Checkpoint>(Checkpoint{ context.orderManager, trained.computeStats(), writer.release(), saved });
+
+			for (; m < members.size() && folds[members[m]].testBegin == boundary; m++) {
+				post([&fork, index = members[m], checkpoint](RunArena& arena) { fork(arena, index, checkpoint); });
+			}
+		}
+	};
+
+	for (const auto& [trainBegin, members] : groups) {
+		post([&train, trainBegin = trainBegin, &members = members](RunArena& arena) { train(arena, trainBegin, members); });
+	}
+
+	auto worker = [&]() {
+		RunArena arena;
+		for (;;) {
+			std::function<void(RunArena&)> task;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&] { return !tasks.empty() || unfinished == 0; });
+				if (tasks.empty()) return;
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+
+			try {
+				if (!failed.load(std::memory_order_relaxed)) task(arena);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!error) error = std::current_exception();
+				failed.store(true, std::memory_order_relaxed);
+			}
+			arena.reset();
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--unfinished == 0) wake.notify_all();
+		}
+	};
+
+	const size_t workerCount = std::min(threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency()), folds.size());
+	std::vector<std::thread> workers;
+	workers.reserve(workerCount - 1);
+	for (size_t w = 1; w < workerCount; w++) workers.emplace_back(worker);
+	worker();
+	for (auto& thread : workers) thread.join();
+
+	if (error) std::rethrow_exception(error);
+	return results;
+}
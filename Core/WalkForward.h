@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "Tick.h"
+#include "TickSeries.h"
+#include "TimeFrame.h"
+#include "Strategy.h"
+#include "StatsCollector.h"
+
+struct StrategyContext;
+
+/**
+ * @brief One train/test split of a walk-forward analysis, in tick indices
+ *
+ * The strategy runs over [trainBegin, testBegin) and then, continuing with
+ * the state, positions and cash it reached there, over [testBegin, testEnd).
+ */
+struct WalkForwardFold {
+	size_t trainBegin;  // First tick of the training window
+	size_t testBegin;   // First tick of the test window (end of the training window)
+	size_t testEnd;     // End of the test window (exclusive)
+};
+
+/**
+ * @brief Statistics of one fold
+ */
+struct WalkForwardResult {
+	WalkForwardFold fold;   // The split evaluated
+	StatsMap trainStats;    // Statistics over the training window
+	StatsMap testStats;     // Statistics over the test window only
+	bool forked;            // true if the test started from a checkpoint, false if the training was replayed
+};
+
+/**
+ * @brief Builds the strategy evaluated by a walk-forward analysis
+ *
+ * Called once per training pass and once per fold, possibly from several
+ * threads at the same time: every call must return an identically configured
+ * instance, and must not modify shared state.
+ */
+using StrategyBuilder = std::function<std::unique_ptr<Strategy>()>;
+
+/**
+ * @brief Walk-forward / time-series cross-validation runner
+ *
+ * Folds that start training at the same tick share that training: one pass
+ * runs from their common start and, at each fold's test boundary, takes a
+ * checkpoint - a copy of the OrderManager, the statistics of the training
+ * window and the strategy's own state (Strategy::saveState()). Each test
+ * window is then evaluated by a fork restored from its checkpoint, so
+ * anchored folds (expanding training windows) cost one pass over the data
+ * plus their test windows, instead of one pass from the start per fold.
+ *
+ * Training passes and forks run on a pool of worker threads: a fork starts as
+ * soon as its checkpoint is taken, while the pass carries on to the next
+ * boundary. A strategy that doesn't implement saveState() still gets correct
+ * results: its forks replay their training window first.
+ *
+ * All folds read the same immutable tick data (views only, nothing is copied).
+ * PnL series are never stored, statistics come from the online accumulators.
+ */
+class WalkForward {
+private:
+	TradeSeries ticks;                    // Trade ticks for strategies derived from Strategy
+	QuoteSeries quotes;                   // Quote ticks for strategies derived from QuoteStrategy
+	size_t threadCount = 0;               // Number of workers (0 = one per hardware thread)
+	size_t blockSize = 4096;              // Ticks gathered at a time when the data is columnar
+
+	void prepare(StrategyContext& context) const;
+	void runRange(StrategyContext& context, size_t begin, size_t end) const;
+
+public:
+	/**
+	 * @brief Creates a runner over the given data
+	 *
+	 * The data is not copied - it must stay alive and unchanged until run() returns.
+	 *
+	 * @param ticks Trade ticks for strategies derived from Strategy
+	 * @param quotes Quote ticks for strategies derived from QuoteStrategy
+	 */
+	WalkForward(TradeSeries ticks, QuoteSeries quotes = {});
+
+	/**
+	 * @brief Sets how many worker threads run() uses
+	 *
+	 * @param count Number of workers (0 = std::thread::hardware_concurrency())
+	 */
+	void setThreadCount(size_t count);
+
+	/**
+	 * @brief Folds with an expanding training window, all starting at tick 0
+	 *
+	 * Fold k trains on [0, firstTestBegin + k * testSize) and tests on the
+	 * testSize ticks that follow, for as long as they fit in tickCount. These
+	 * folds share all of their training.
+	 *
+	 * @param tickCount Number of ticks in the data
+	 * @param firstTestBegin End of the first training window (> 0)
+	 * @param testSize Ticks per test window (> 0)
+	 * @throws std::invalid_argument If firstTestBegin or testSize is 0
+	 */
+	static std::vector<WalkForwardFold> anchored(size_t tickCount, size_t firstTestBegin, size_t testSize);
+
+	/**
+	 * @brief Folds with a training window of fixed length sliding forward
+	 *
+	 * Fold k trains on [k * testSize, k * testSize + trainSize) and tests on
+	 * the testSize ticks that follow. Every fold starts its training elsewhere,
+	 * so they don't share any computation but run in parallel.
+	 *
+	 * @param tickCount Number of ticks in the data
+	 * @param trainSize Ticks per training window (> 0)
+	 * @param testSize Ticks per test window (> 0)
+	 * @throws std::invalid_argument If trainSize or testSize is 0
+	 */
+	static std::vector<WalkForwardFold> rolling(size_t tickCount, size_t trainSize, size_t testSize);
+
+	/**
+	 * @brief Evaluates every fold
+	 *
+	 * @param folds Splits to evaluate (any order, may overlap)
+	 * @param builder Builds the strategy
+	 * @param tf Time frame used for the statistics
+	 * @param initialCash Starting capital, at the start of each training window
+	 * @return One result per fold, in the order of folds
+	 * @throws std::invalid_argument If a fold is empty, inverted or extends past the data
+	 * @throws std::runtime_error If the strategy has no data of the kind it consumes
+	 * @throws Any exception thrown by the builder or a strategy (the first one is rethrown)
+	 */
+	std::vector<WalkForwardResult> run(std::span<const WalkForwardFold> folds, const StrategyBuilder& builder, TimeFrame tf, double initialCash) const;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+/**
+ * @brief Per-worker job queue that other workers can steal from
+ *
+ * Each worker owns one queue. The owner takes jobs from the back (the jobs it
+ * was given most recently, which are usually the most cache-friendly), while
+ * idle workers steal from the front (the oldest jobs, far away from what the
+ * owner is working on). This keeps all cores busy even when some jobs take
+ * much longer than others, without a single shared queue becoming a hot spot.
+ *
+ * Jobs are whole backtest runs (milliseconds to seconds each), so a mutex per
+ * queue is cheap compared to the work and keeps the implementation simple.
+ *
+ * @tparam Job Type of a job (e.g. an index into a parameter grid)
+ */
+template<typename Job>
+class WorkStealingQueue {
+private:
+	std::deque<Job> jobs;  // Owner works at the back, thieves at the front
+	mutable std::mutex mutex;
+
+public:
+	/**
+	 * @brief Adds a job at the back of the queue
+	 *
+	 * @param job The job to add
+	 */
+	void push(Job job) {
+		std::lock_guard<std::mutex> lock(mutex);
+		jobs.push_back(std::move(job));
+	}
+
+	/**
+	 * @brief Takes the most recently added job (called by the owning worker)
+	 *
+	 * @return The job, or nullopt if the queue is empty
+	 */
+	std::optional<Job> pop() {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (jobs.empty()) return std::nullopt;
+		Job job = std::move(jobs.back());
+		jobs.pop_back();
+		return job;
+	}
+
+	/**
+	 * @brief Takes the oldest job (called by other workers when they run out of work)
+	 *
+	 * @return The job, or nullopt if the queue is empty
+	 */
+	std::optional<Job> steal() {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (jobs.empty()) return std::nullopt;
+		Job job = std::move(jobs.front());
+		jobs.pop_front();
+		return job;
+	}
+
+	/**
+	 * @brief Returns true if the queue has no jobs left
+	 */
+	bool empty() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return jobs.empty();
+	}
+};
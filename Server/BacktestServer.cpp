@@ -0,0 +1,637 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "BacktestServer.h"
+#include "BacktestEngine.h"
+#include "ResultFile.h"
+#include "MeanReversionSimpleStrategy.h"
+#include "BreakoutStrategy.h"
+#include "RollingBreakoutStrategy.h"
+#include "SpreadStrategy.h"
+
+/**
+ * @brief Lets a cancel request reach a job, whether it is still queued or already running
+ */
+struct BacktestServer::JobControl {
+	std::mutex mutex;
+	bool cancelled = false;
+	BacktestEngine* engine = nullptr;  // Engine of the job while it runs
+
+	void cancel() {
+		std::lock_guard<std::mutex> lock(mutex);
+		cancelled = true;
+		if (engine) engine->cancel();
+	}
+
+	/**
+	 * @brief Points cancel requests at the engine (or at nothing), forwarding a cancellation already requested
+	 */
+	void attach(BacktestEngine* running) {
+		std::lock_guard<std::mutex> lock(mutex);
+		engine = running;
+		if (engine && cancelled) engine->cancel();
+	}
+
+	bool isCancelled() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return cancelled;
+	}
+};
+
+/**
+ * @brief One client socket, shared by its reader thread and the jobs it queued
+ *
+ * The socket is closed when the last owner lets go, so a job still running
+ * after the client left never writes to a recycled descriptor.
+ */
+struct BacktestServer::Connection {
+	int fd;
+	std::mutex writeMutex;               // One event line at a time
+	std::atomic<bool> broken{ false };   // A send failed - the client is gone
+	std::atomic<bool> finished{ false }; // The reader thread has exited
+
+	// Jobs of this connection by id (dumped), for cancel requests - read by the reader thread only
+	std::map<std::string, std::weak_ptr<JobControl>> jobs;
+
+	explicit Connection(int fd) : fd(fd) {}
+	~Connection() { ::close(fd); }
+
+	/**
+	 * @brief Sends one event as a JSON line (dropped if the client is gone)
+	 */
+	void send(const JsonValue& event) {
+		std::string line = event.dump();
+		line += '\n';
+
+		std::lock_guard<std::mutex> lock(writeMutex);
+		size_t sent = 0;
+		while (!broken && sent < line.size()) {
+			const ssize_t n = ::send(fd, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+			if (n < 0 && errno == EINTR) continue;
+			if (n <= 0) broken = true;
+			else sent += static_cast<size_t>(n);
+		}
+	}
+};
+
+namespace {
+
+constexpr size_t READ_CHUNK = 64 * 1024;              // Bytes per recv()
+constexpr size_t MAX_REQUEST_BYTES = 1024 * 1024;     // Longest request line accepted
+constexpr double DEFAULT_CAPITAL = 10000.0;
+constexpr double DEFAULT_MAX_POINTS = 2000;
+
+/**
+ * @brief Built-in strategies a request can name
+ *
+ * Names are those of the command line program (and of the web interface).
+ */
+struct NamedStrategy {
+	const char* name;
+	void (*add)(BacktestEngine& engine, const std::string& name, double capital);
+};
+
+constexpr NamedStrategy NAMED_STRATEGIES[] = {
+	{ "Mean_Reversion", [](BacktestEngine& engine, const std::string& name, double capital) {
+		engine.addTypedStrategy(name, std::make_unique<MeanReversionSimple>(), TimeFrame::MINUTE, capital);
+	} },
+	{ "Breakout_Win20", [](BacktestEngine& engine, const std::string& name, double capital) {
+		engine.addTypedStrategy(name, std::make_unique<BreakoutStrategy<20>>(), TimeFrame::MINUTE, capital);
+	} },
+	{ "Spread", [](BacktestEngine& engine, const std::string& name, double capital) {
+		engine.addTypedStrategy(name, std::make_unique<SpreadStrategy>(), TimeFrame::MINUTE, capital);
+	} },
+};
+
+const NamedStrategy* findStrategy(const std::string& name) {
+	for (const NamedStrategy& strategy : NAMED_STRATEGIES) {
+		if (name == strategy.name) return &strategy;
+	}
+	return nullptr;
+}
+
+/**
+ * @brief Reads a sweep parameter, falling back to the strategy's default
+ */
+double param(const SweepParams& params, const char* name, double fallback) {
+	const auto found = params.find(name);
+	return found != params.end() ? found->second : fallback;
+}
+
+/**
+ * @brief Built-in strategies a sweep request can name, with the parameters their factory reads
+ */
+struct SweepableStrategy {
+	const char* name;
+	const char* parameters[4];  // Accepted parameter names (unused slots are null)
+	bool quotes;                // Consumes quote ticks
+	std::unique_ptr<Strategy> (*build)(const SweepParams& params);
+};
+
+const SweepableStrategy SWEEPABLE_STRATEGIES[] = {
+	{ "Mean_Reversion", {}, false, [](const SweepParams&) -> std::unique_ptr<Strategy> {
+		return std::make_unique<MeanReversionSimple>();
+	} },
+	{ "Breakout", { "window" }, false, [](const SweepParams& p) -> std::unique_ptr<Strategy> {
+		return std::make_unique<RollingBreakoutStrategy>(static_cast<size_t>(param(p, "window", 20)));
+	} },
+	{ "Spread", { "size", "minSpread", "offset", "requote" }, true, [](const SweepParams& p) -> std::unique_ptr<Strategy> {
+		return std::make_unique<SpreadStrategy>(param(p, "size", 1.0), param(p, "minSpread", 0.01), param(p, "offset", 0.005), param(p, "requote", 0) != 0);
+	} },
+};
+
+const SweepableStrategy* findSweepable(const std::string& name) {
+	for (const SweepableStrategy& strategy : SWEEPABLE_STRATEGIES) {
+		if (name == strategy.name) return &strategy;
+	}
+	return nullptr;
+}
+
+/**
+ * @brief Reads an optional integer member, checking its range
+ */
+double integerField(const JsonValue& request, const char* key, double fallback, double min, double max) {
+	const JsonValue* member = request.find(key);
+	if (!member) return fallback;
+	const double value = member->asNumber();
+	if (value != std::floor(value) || value < min || value > max) {
+		throw std::invalid_argument(std::string("'") + key + "' must be an integer between " +
+			std::to_string(static_cast<long long>(min)) + " and " + std::to_string(static_cast<long long>(max)) + ".");
+	}
+	return value;
+}
+
+JsonValue event(const JsonValue& id, const char* name) {
+	JsonValue e;
+	e.set("id", id).set("event", name);
+	return e;
+}
+
+JsonValue errorEvent(const JsonValue& id, const std::string& message) {
+	JsonValue e = event(id, "error");
+	e.set("error", message);
+	return e;
+}
+
+} // namespace
+
+BacktestServer::BacktestServer(ServerConfig config)
+	: config(std::move(config)), datasets(this->config.maxDatasets, this->config.cacheDirectory) {}
+
+BacktestServer::~BacktestServer() {
+	stop();
+}
+
+/**
+ * @brief Binds, starts the pool, then accepts connections until stopped
+ */
+void BacktestServer::run(const std::function<void(uint16_t)>& onListening) {
+	listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+	if (listenFd < 0) throw std::runtime_error(std::string("Cannot create socket: ") + std::strerror(errno));
+
+	const int reuse = 1;
+	::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	sockaddr_in address{};
+	address.sin_family = AF_INET;
+	address.sin_port = htons(config.port);
+	if (::inet_pton(AF_INET, config.bindAddress.c_str(), &address.sin_addr) != 1) {
+		::close(listenFd);
+		listenFd = -1;
+		throw std::runtime_error("Invalid bind address '" + config.bindAddress + "'.");
+	}
+	if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listenFd, 64) != 0) {
+		const std::string reason = std::strerror(errno);
+		::close(listenFd);
+		listenFd = -1;
+		throw std::runtime_error("Cannot listen on " + config.bindAddress + ":" + std::to_string(config.port) + ": " + reason);
+	}
+
+	socklen_t length = sizeof(address);
+	::getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+	boundPort = ntohs(address.sin_port);
+
+	const size_t workerCount = config.workerCount != 0 ? config.workerCount : std::max(1u, std::thread::hardware_concurrency());
+	poolSize = workerCount;
+	for (size_t w = 0; w < workerCount; w++) workers.emplace_back(&BacktestServer::workerLoop, this);
+
+	if (onListening) onListening(boundPort);
+
+	while (!stopping) {
+		const int fd = ::accept(listenFd, nullptr, nullptr);
+		if (fd < 0) {
+			if (errno == EINTR || errno == ECONNABORTED) continue;
+			break;  // Listening socket shut down by stop()
+		}
+
+		std::lock_guard<std::mutex> lock(connectionMutex);
+		if (stopping) {
+			::close(fd);
+			break;
+		}
+
+		// Reap the threads of connections that have ended
+		for (size_t i = 0; i < connections.size();) {
+			if (connections[i]->finished) {
+				connectionThreads[i].join();
+				connections.erase(connections.begin() + i);
+				connectionThreads.erase(connectionThreads.begin() + i);
+			} else {
+				i++;
+			}
+		}
+
+		auto connection = std::make_shared<Connection>(fd);
+		connections.push_back(connection);
+		connectionThreads.emplace_back(&BacktestServer::serveConnection, this, connection);
+	}
+
+	stop();
+	closeConnections();
+
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		jobs.clear();
+	}
+	jobReady.notify_all();
+	for (auto& worker : workers) worker.join();
+	workers.clear();
+
+	::close(listenFd);
+	listenFd = -1;
+}
+
+/**
+ * @brief Wakes the accept loop by shutting the listening socket down
+ */
+void BacktestServer::stop() {
+	if (stopping.exchange(true)) return;
+	if (listenFd >= 0) ::shutdown(listenFd, SHUT_RDWR);
+}
+
+/**
+ * @brief Unblocks every reader thread and waits for them
+ */
+void BacktestServer::closeConnections() {
+	std::lock_guard<std::mutex> lock(connectionMutex);
+	for (auto& connection : connections) ::shutdown(connection->fd, SHUT_RDWR);
+	for (auto& thread : connectionThreads) thread.join();
+	connections.clear();
+	connectionThreads.clear();
+}
+
+/**
+ * @brief Reads request lines from one client until it disconnects
+ */
+void BacktestServer::serveConnection(std::shared_ptr<Connection> connection) {
+	std::string pending;
+	std::vector<char> chunk(READ_CHUNK);
+
+	while (!stopping) {
+		const ssize_t n = ::recv(connection->fd, chunk.data(), chunk.size(), 0);
+		if (n < 0 && errno == EINTR) continue;
+		if (n <= 0) break;
+
+		pending.append(chunk.data(), static_cast<size_t>(n));
+		size_t begin = 0;
+		for (size_t end; (end = pending.find('\n', begin)) != std::string::npos; begin = end + 1) {
+			const std::string line = pending.substr(begin, end - begin);
+			if (line.find_first_not_of(" \t\r") != std::string::npos) handleRequest(connection, line);
+		}
+		pending.erase(0, begin);
+
+		if (pending.size() > MAX_REQUEST_BYTES) {
+			connection->send(errorEvent(nullptr, "Request too long."));
+			break;
+		}
+	}
+	connection->finished = true;
+}
+
+/**
+ * @brief Answers small requests directly and queues backtests on the pool
+ */
+void BacktestServer::handleRequest(const std::shared_ptr<Connection>& connection, const std::string& line) {
+	JsonValue id;
+	try {
+		JsonValue request = JsonValue::parse(line);
+		if (!request.isObject()) throw std::invalid_argument("Request must be a JSON object.");
+		if (const JsonValue* member = request.find("id")) id = *member;
+
+		const JsonValue* typeMember = request.find("type");
+		const std::string type = typeMember ? typeMember->asString() : "run";
+
+		if (type == "ping") {
+			JsonValue pong = event(id, "pong");
+			pong.set("workers", poolSize);
+			connection->send(pong);
+		} else if (type == "shutdown") {
+			connection->send(event(id, "done"));
+			stop();
+		} else if (type == "run") {
+			// Validated up front, so a bad request is rejected before it waits in the queue
+			Job job = parseJob(request, id);
+			job.control = std::make_shared<JobControl>();
+			std::erase_if(connection->jobs, [](const auto& entry) { return entry.second.expired(); });
+			connection->jobs[id.dump()] = job.control;
+
+			JsonValue accepted = event(id, "accepted");
+			accepted.set("seed", static_cast<double>(job.seed));
+			connection->send(accepted);
+			enqueue([this, connection, job = std::move(job)] { runJob(connection, job); });
+		} else if (type == "sweep") {
+			SweepJob job = parseSweepJob(request, id);
+			job.control = std::make_shared<JobControl>();
+			std::erase_if(connection->jobs, [](const auto& entry) { return entry.second.expired(); });
+			connection->jobs[id.dump()] = job.control;
+
+			JsonValue accepted = event(id, "accepted");
+			accepted.set("seed", static_cast<double>(job.seed));
+			connection->send(accepted);
+			enqueue([this, connection, job = std::move(job)] { runSweepJob(connection, job); });
+		} else if (type == "cancel") {
+			const auto entry = connection->jobs.find(id.dump());
+			const std::shared_ptr<JobControl> control = entry != connection->jobs.end() ? entry->second.lock() : nullptr;
+			if (!control) throw std::invalid_argument("No queued or running job with this id.");
+			control->cancel();
+		} else {
+			throw std::invalid_argument("Unknown request type '" + type + "'.");
+		}
+	} catch (const std::exception& e) {
+		connection->send(errorEvent(id, e.what()));
+	}
+}
+
+/**
+ * @brief Reads the dataset (ticks, seed) and the capital of a run or sweep request
+ */
+void BacktestServer::parseDataset(const JsonValue& request, size_t& ticks, uint64_t& seed, double& capital) const {
+	if (!request.find("ticks")) throw std::invalid_argument("'ticks' is required.");
+	ticks = static_cast<size_t>(integerField(request, "ticks", 0, 10, static_cast<double>(config.maxTicks)));
+
+	// Random seeds stay below 2^53 so they survive the trip through a JSON number
+	if (request.find("seed")) {
+		seed = static_cast<uint64_t>(integerField(request, "seed", 0, 0, 9007199254740991.0));
+	} else {
+		std::random_device rd;
+		seed = ((uint64_t(rd()) << 32) | rd()) & ((uint64_t(1) << 53) - 1);
+	}
+
+	capital = request.find("capital") ? request.find("capital")->asNumber() : DEFAULT_CAPITAL;
+	if (!(capital > 0.0)) throw std::invalid_argument("'capital' must be positive.");
+}
+
+/**
+ * @brief Checks a run request and fills in the defaults
+ */
+BacktestServer::Job BacktestServer::parseJob(const JsonValue& request, const JsonValue& id) const {
+	Job job;
+	job.id = id;
+
+	const JsonValue* strategies = request.find("strategies");
+	if (!strategies || !strategies->isArray() || strategies->asArray().empty()) {
+		throw std::invalid_argument("'strategies' must be a non-empty array.");
+	}
+	for (const JsonValue& name : strategies->asArray()) {
+		if (!findStrategy(name.asString())) throw std::invalid_argument("Unknown strategy '" + name.asString() + "'.");
+		job.strategies.push_back(name.asString());
+	}
+
+	parseDataset(request, job.ticks, job.seed, job.capital);
+
+	job.maxPoints = static_cast<long long>(integerField(request, "max_points", DEFAULT_MAX_POINTS, -1, 1e12));
+	if (job.maxPoints > 0 && job.maxPoints < 4) throw std::invalid_argument("'max_points' must be -1, 0 or at least 4.");
+
+	job.threads = static_cast<size_t>(integerField(request, "threads", 1, 1, 256));
+	job.progressMs = static_cast<long long>(integerField(request, "progress_ms", 0, 1, 3600000));
+
+	if (const JsonValue* resultDir = request.find("result_dir")) {
+		if (!resultDir->isString() || !std::filesystem::is_directory(resultDir->asString())) {
+			throw std::invalid_argument("'result_dir' must be an existing directory.");
+		}
+		job.resultDir = resultDir->asString();
+	}
+	return job;
+}
+
+/**
+ * @brief Checks a sweep request: known strategy, and only parameters its factory reads
+ */
+BacktestServer::SweepJob BacktestServer::parseSweepJob(const JsonValue& request, const JsonValue& id) const {
+	SweepJob job;
+	job.id = id;
+
+	const JsonValue* strategy = request.find("strategy");
+	if (!strategy) throw std::invalid_argument("'strategy' is required.");
+	const SweepableStrategy* sweepable = findSweepable(strategy->asString());
+	if (!sweepable) throw std::invalid_argument("Strategy '" + strategy->asString() + "' can't be swept.");
+	job.strategy = sweepable->name;
+
+	const JsonValue* variants = request.find("variants");
+	if (!variants || !variants->isArray() || variants->asArray().empty()) {
+		throw std::invalid_argument("'variants' must be a non-empty array.");
+	}
+	for (const JsonValue& variant : variants->asArray()) {
+		SweepParams params;
+		for (const auto& [name, value] : variant.asObject()) {
+			const auto& accepted = sweepable->parameters;
+			if (std::none_of(std::begin(accepted), std::end(accepted), [&](const char* p) { return p && name == p; })) {
+				throw std::invalid_argument("Strategy '" + job.strategy + "' has no parameter '" + name + "'.");
+			}
+			params[name] = value.asNumber();
+		}
+		job.variants.push_back(std::move(params));
+	}
+
+	parseDataset(request, job.ticks, job.seed, job.capital);
+	job.threads = static_cast<size_t>(integerField(request, "threads", 1, 1, 256));
+	return job;
+}
+
+/**
+ * @brief Runs one backtest on a worker, streaming each strategy's result as it completes
+ */
+void BacktestServer::runJob(const std::shared_ptr<Connection>& connection, const Job& job) {
+	if (connection->broken) return;  // Nobody left to send the results to
+
+	const JsonValue& id = job.id;
+	if (job.control->isCancelled()) {
+		JsonValue done = event(id, "done");
+		done.set("elapsed_ms", 0.0).set("cached", false).set("cancelled", true);
+		connection->send(done);
+		return;
+	}
+
+	try {
+		const auto start = std::chrono::steady_clock::now();
+		const DatasetKey key{ job.ticks, TimeFrame::MINUTE, job.seed };
+		DatasetOrigin tickOrigin, quoteOrigin;
+		std::shared_ptr<const std::vector<Tick>> ticks = datasets.ticks(key, &tickOrigin);
+		std::shared_ptr<const std::vector<QuoteTick>> quotes = datasets.quotes(key, &quoteOrigin);
+		const bool cached = tickOrigin != DatasetOrigin::GENERATED && quoteOrigin != DatasetOrigin::GENERATED;
+
+		BacktestEngine engine;
+		engine.setThreadCount(job.threads);
+		engine.setStoreSeries(job.maxPoints >= 0 || !job.resultDir.empty());
+		engine.setTickData(ticks);
+		engine.setTickData(quotes);
+		for (const std::string& name : job.strategies) findStrategy(name)->add(engine, name, job.capital);
+
+		engine.setResultCallback([&](const std::string& name, const StatsCollector& statistics, const StatsMap& stats) {
+			if (!job.resultDir.empty()) {
+				writeResultFile(job.resultDir + "/" + name + "_results.bin", statistics, {}, job.maxPoints > 0 ? static_cast<size_t>(job.maxPoints) : 0);
+			}
+
+			JsonValue statsObject = JsonValue::Object{};
+			for (const auto& [metric, value] : stats) statsObject.set(metric, value);
+
+			JsonValue result = event(id, "result");
+			result.set("strategy", name).set("stats", std::move(statsObject));
+			if (job.maxPoints >= 0) {
+				const std::span<const double> pnl = statistics.getPnLSeries();
+				JsonValue::Array index, values;
+				for (uint64_t tick : decimateSeries(pnl, static_cast<size_t>(job.maxPoints))) {
+					index.emplace_back(static_cast<double>(tick));
+					values.emplace_back(pnl[tick]);
+				}
+				JsonValue series;
+				series.set("index", std::move(index)).set("pnl", std::move(values));
+				result.set("pnl", std::move(series));
+			}
+			connection->send(result);
+		});
+		if (job.progressMs > 0) {
+			engine.setProgressObserver([&](const std::string& name, std::span<const ProgressEvent> events, uint64_t dropped) {
+				JsonValue::Array index, values, fills;
+				uint64_t ticks = 0;
+				for (const ProgressEvent& e : events) {
+					if (e.type == ProgressEvent::Type::PROGRESS) {
+						ticks = e.ticks;
+						index.emplace_back(static_cast<double>(e.ticks));
+						values.emplace_back(e.pnl);
+					} else {
+						JsonValue fill;
+						fill.set("timestamp", static_cast<double>(e.fill.timestamp))
+							.set("order", static_cast<double>(e.fill.orderId))
+							.set("side", e.fill.side == Order::Side::BUY ? "BUY" : "SELL")
+							.set("price", e.fill.price)
+							.set("volume", e.fill.volume)
+							.set("symbol", static_cast<double>(e.fill.symbol))
+							.set("fee", e.fill.fee);
+						fills.push_back(std::move(fill));
+					}
+				}
+
+				JsonValue series;
+				series.set("index", std::move(index)).set("pnl", std::move(values));
+				JsonValue progress = event(id, "progress");
+				progress.set("strategy", name).set("ticks", static_cast<double>(ticks)).set("pnl", std::move(series))
+					.set("fills", std::move(fills)).set("dropped", static_cast<double>(dropped));
+				connection->send(progress);
+			}, std::chrono::milliseconds(job.progressMs));
+		}
+
+		job.control->attach(&engine);
+		try {
+			engine.runAll(false);
+		} catch (...) {
+			job.control->attach(nullptr);
+			throw;
+		}
+		job.control->attach(nullptr);
+
+		const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		JsonValue done = event(id, "done");
+		done.set("elapsed_ms", elapsed).set("cached", cached).set("cancelled", engine.wasCancelled());
+		connection->send(done);
+	} catch (const std::exception& e) {
+		connection->send(errorEvent(id, e.what()));
+	}
+}
+
+/**
+ * @brief Runs one sweep on a worker and sends the statistics of every variant
+ */
+void BacktestServer::runSweepJob(const std::shared_ptr<Connection>& connection, const SweepJob& job) {
+	if (connection->broken) return;
+
+	const JsonValue& id = job.id;
+	if (job.control->isCancelled()) {
+		JsonValue done = event(id, "done");
+		done.set("elapsed_ms", 0.0).set("cached", false).set("cancelled", true);
+		connection->send(done);
+		return;
+	}
+
+	try {
+		const auto start = std::chrono::steady_clock::now();
+		const SweepableStrategy& sweepable = *findSweepable(job.strategy);
+		const DatasetKey key{ job.ticks, TimeFrame::MINUTE, job.seed };
+
+		// Only the kind of data the strategy consumes is generated or loaded
+		DatasetOrigin origin;
+		std::shared_ptr<const std::vector<Tick>> ticks;
+		std::shared_ptr<const std::vector<QuoteTick>> quotes;
+		if (sweepable.quotes) quotes = datasets.quotes(key, &origin);
+		else ticks = datasets.ticks(key, &origin);
+
+		ParameterSweep sweep(ticks ? TradeSeries(std::span<const Tick>(*ticks)) : TradeSeries(),
+			quotes ? QuoteSeries(std::span<const QuoteTick>(*quotes)) : QuoteSeries());
+		sweep.setThreadCount(job.threads);
+		const std::vector<SweepResult> results = sweep.run(job.variants, sweepable.build, TimeFrame::MINUTE, job.capital);
+
+		for (const SweepResult& variant : results) {
+			JsonValue statsObject = JsonValue::Object{};
+			for (const auto& [metric, value] : variant.stats) statsObject.set(metric, value);
+
+			JsonValue result = event(id, "result");
+			result.set("variant", variant.index).set("stats", std::move(statsObject));
+			connection->send(result);
+		}
+
+		const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		JsonValue done = event(id, "done");
+		done.set("elapsed_ms", elapsed).set("cached", origin != DatasetOrigin::GENERATED).set("cancelled", false);
+		connection->send(done);
+	} catch (const std::exception& e) {
+		connection->send(errorEvent(id, e.what()));
+	}
+}
+
+void BacktestServer::enqueue(std::function<void()> job) {
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		jobs.push_back(std::move(job));
+	}
+	jobReady.notify_one();
+}
+
+/**
+ * @brief Runs queued jobs until the server stops
+ */
+void BacktestServer::workerLoop() {
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(jobMutex);
+			jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+			if (stopping) return;
+			job = std::move(jobs.front());
+			jobs.pop_front();
+		}
+		job();
+	}
+}
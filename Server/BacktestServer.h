@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DatasetCache.h"
+#include "Json.h"
+#include "ParameterSweep.h"
+
+/**
+ * @brief Settings of a BacktestServer
+ */
+struct ServerConfig {
+	std::string bindAddress = "127.0.0.1";  // IPv4 address to listen on ("0.0.0.0" = every interface)
+	uint16_t port = 5002;                   // TCP port (0 = any free port, see BacktestServer::getPort())
+	size_t workerCount = 0;                 // Backtests run at the same time (0 = one per hardware thread)
+	size_t maxDatasets = 8;                 // Generated datasets kept resident (least recently used are dropped)
+	size_t maxTicks = 20'000'000;           // Largest dataset a request may ask for
+	std::string cacheDirectory;             // On-disk dataset cache shared across restarts ("" = memory only)
+};
+
+/**
+ * @brief Long-lived backtest process serving JSON requests over TCP
+ *
+ * Running the engine as a server avoids paying process start-up and data
+ * generation on every backtest: generated datasets stay in a DatasetCache and
+ * are shared (not copied) by every job that uses them, and jobs run
+ * concurrently on a fixed pool of worker threads.
+ *
+ * Protocol: newline-delimited JSON. Each line a client sends is one request
+ * object; each line the server sends is one event object. Several requests
+ * may be in flight on one connection - every event carries the "id" of its
+ * request (any JSON value, echoed back as given).
+ *
+ * Requests:
+ * - {"type": "run", "id": ..., "ticks": N, "seed": S, "capital": C,
+ *    "strategies": ["Mean_Reversion", "Breakout_Win20", "Spread"],
+ *    "max_points": P, "threads": T, "progress_ms": M, "result_dir": D}
+ *   Backtests the named strategies on the dataset of N ticks generated with
+ *   seed S (a random seed when omitted - it is reported back, so the run can
+ *   be repeated on the same data). Only "ticks" and "strategies" are
+ *   required; "type" defaults to "run". The PnL series of each strategy is
+ *   decimated to at most P points (default 2000, 0 = every tick, -1 = no series),
+ *   each job uses T engine threads (default 1). With "progress_ms", progress
+ *   events are sent about every M milliseconds while the job runs.
+ *   With "result_dir", each strategy's results are also written to
+ *   D/<strategy>_results.bin before its result event is sent (D is a
+ *   directory of the server's machine, which must exist): the full PnL and
+ *   returns series, plus the P chart points if P > 0, as binary columns (see
+ *   writeResultFile(), without fills), so a full-resolution export doesn't
+ *   go through JSON.
+ * - {"type": "sweep", "id": ..., "ticks": N, "seed": S, "capital": C,
+ *    "strategy": "Spread", "variants": [{"minSpread": 0.01, "offset": 0.005}, ...],
+ *    "threads": T}
+ *   Runs one strategy once per variant (an object of parameter values,
+ *   missing ones at their default) on the dataset of N ticks generated with
+ *   seed S, as a ParameterSweep on T threads (default 1). Only the statistics
+ *   come back. Sweepable strategies and their parameters: "Mean_Reversion"
+ *   (none), "Breakout" (window) and "Spread" (size, minSpread, offset,
+ *   requote). This is the request a SweepCoordinator sends to its workers.
+ * - {"type": "cancel", "id": ...}: stops the queued or running job of this
+ *   connection with the same id (its "done" event reports the cancellation;
+ *   a sweep can only be cancelled while it is queued)
+ * - {"type": "ping", "id": ...}
+ * - {"type": "shutdown", "id": ...}: stops the server (queued jobs are dropped)
+ *
+ * Events:
+ * - {"id": ..., "event": "accepted", "seed": S}: the job is queued
+ * - {"id": ..., "event": "progress", "strategy": name, "ticks": n,
+ *    "pnl": {"index": [...], "pnl": [...]}, "fills": [{...}], "dropped": d}:
+ *   what a strategy did since its last progress event - its PnL once per
+ *   engine block and its executions; d counts the events lost so far because
+ *   the backtest outpaced the connection (progress_ms requests only)
+ * - {"id": ..., "event": "result", "strategy": name, "stats": {...},
+ *    "pnl": {"index": [...], "pnl": [...]}}: one per strategy, sent as
+ *   soon as that strategy finishes
+ * - {"id": ..., "event": "result", "variant": k, "stats": {...}}: statistics
+ *   of variants[k] (sweep requests, one per variant)
+ * - {"id": ..., "event": "done", "elapsed_ms": t, "cached": b, "cancelled": c}:
+ *   the job is complete (cached tells whether the dataset was resident or on
+ *   disk, cancelled whether a cancel request cut it short - the results
+ *   then cover the ticks processed until then)
+ * - {"id": ..., "event": "pong", "workers": w}: w is the number of backtests
+ *   the server runs at the same time
+ * - {"id": ..., "event": "error", "error": message}: the request failed
+ *   (also sent for lines that aren't valid JSON, with a null id)
+ */
+class BacktestServer {
+private:
+	/**
+	 * @brief A validated run request
+	 */
+	struct JobControl;
+
+	struct Job {
+		JsonValue id;                         // Echoed in every event of the job
+		std::vector<std::string> strategies;  // Built-in strategy names
+		size_t ticks;                         // Dataset length
+		uint64_t seed;                        // Dataset seed
+		double capital;                       // Initial cash of each strategy
+		long long maxPoints;                  // PnL points per result (0 = all, -1 = none)
+		size_t threads;                       // Engine threads of the job
+		long long progressMs;                 // Period of the progress events (0 = none)
+		std::string resultDir;                // Directory of the result files ("" = none)
+		std::shared_ptr<JobControl> control;  // Target of the cancel requests
+	};
+
+	/**
+	 * @brief A validated sweep request
+	 */
+	struct SweepJob {
+		JsonValue id;                         // Echoed in every event of the job
+		std::string strategy;                 // Sweepable strategy name
+		std::vector<SweepParams> variants;    // Parameters of each run
+		size_t ticks;                         // Dataset length
+		uint64_t seed;                        // Dataset seed
+		double capital;                       // Initial cash of each variant
+		size_t threads;                       // Sweep threads of the job
+		std::shared_ptr<JobControl> control;  // Target of the cancel requests
+	};
+
+	struct Connection;
+
+	ServerConfig config;
+	std::atomic<int> listenFd{ -1 };
+	std::atomic<uint16_t> boundPort{ 0 };
+	std::atomic<bool> stopping{ false };
+	size_t poolSize = 0;  // Workers started by run(), reported by pong events
+
+	// Worker pool
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> jobs;
+	std::mutex jobMutex;
+	std::condition_variable jobReady;
+
+	// Connections
+	std::vector<std::shared_ptr<Connection>> connections;
+	std::vector<std::thread> connectionThreads;
+	std::mutex connectionMutex;
+
+	DatasetCache datasets;
+
+	void serveConnection(std::shared_ptr<Connection> connection);
+	void handleRequest(const std::shared_ptr<Connection>& connection, const std::string& line);
+	void parseDataset(const JsonValue& request, size_t& ticks, uint64_t& seed, double& capital) const;
+	Job parseJob(const JsonValue& request, const JsonValue& id) const;
+	SweepJob parseSweepJob(const JsonValue& request, const JsonValue& id) const;
+	void runJob(const std::shared_ptr<Connection>& connection, const Job& job);
+	void runSweepJob(const std::shared_ptr<Connection>& connection, const SweepJob& job);
+	void enqueue(std::function<void()> job);
+	void workerLoop();
+	void closeConnections();
+
+public:
+	/**
+	 * @brief Creates a server (nothing is opened until run())
+	 *
+	 * @param config Listening address, pool size and limits
+	 * @throws std::runtime_error If the cache directory can't be created
+	 */
+	explicit BacktestServer(ServerConfig config = {});
+
+	/**
+	 * @brief Stops the server if it is still running
+	 */
+	~BacktestServer();
+
+	BacktestServer(const BacktestServer&) = delete;
+	BacktestServer& operator=(const BacktestServer&) = delete;
+
+	/**
+	 * @brief Listens and serves requests until stop() or a shutdown request
+	 *
+	 * Blocks the calling thread. Each connection is read by its own thread;
+	 * backtests run on the worker pool.
+	 *
+	 * @param onListening Called once the socket is listening, with the bound port (optional)
+	 * @throws std::runtime_error If the address can't be bound or listened on
+	 */
+	void run(const std::function<void(uint16_t)>& onListening = {});
+
+	/**
+	 * @brief Makes run() return (thread-safe, can be called from any thread)
+	 *
+	 * Open connections are closed; queued jobs are dropped, running ones finish first.
+	 */
+	void stop();
+
+	/**
+	 * @brief Returns the port the server listens on (0 before run() has bound it)
+	 */
+	uint16_t getPort() const { return boundPort.load(); }
+};
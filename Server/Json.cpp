@@ -0,0 +1,313 @@
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Json.h"
+
+namespace {
+
+/**
+ * @brief Recursive descent parser over a text buffer
+ */
+class Parser {
+private:
+	std::string_view text;
+	size_t pos = 0;
+	size_t depth = 0;
+
+	static constexpr size_t MAX_DEPTH = 256;  // Nesting limit (keeps hostile input from exhausting the stack)
+
+	[[noreturn]] void fail(const std::string& what) const {
+		throw std::runtime_error("Invalid JSON at offset " + std::to_string(pos) + ": " + what);
+	}
+
+	void skipWhitespace() {
+		while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) pos++;
+	}
+
+	void expect(char c) {
+		if (pos >= text.size() || text[pos] != c) fail(std::string("expected '") + c + "'");
+		pos++;
+	}
+
+	void literal(std::string_view word) {
+		if (text.substr(pos, word.size()) != word) fail("unknown literal");
+		pos += word.size();
+	}
+
+	uint32_t hex4() {
+		if (pos + 4 > text.size()) fail("truncated \\u escape");
+		uint32_t code = 0;
+		const auto [end, ec] = std::from_chars(text.data() + pos, text.data() + pos + 4, code, 16);
+		if (ec != std::errc() || end != text.data() + pos + 4) fail("bad \\u escape");
+		pos += 4;
+		return code;
+	}
+
+	static void appendUtf8(std::string& out, uint32_t code) {
+		if (code < 0x80) {
+			out += static_cast<char>(code);
+		} else if (code < 0x800) {
+			out += static_cast<char>(0xC0 | (code >> 6));
+			out += static_cast<char>(0x80 | (code & 0x3F));
+		} else if (code < 0x10000) {
+			out += static_cast<char>(0xE0 | (code >> 12));
+			out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (code & 0x3F));
+		} else {
+			out += static_cast<char>(0xF0 | (code >> 18));
+			out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+			out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (code & 0x3F));
+		}
+	}
+
+	std::string string() {
+		expect('"');
+		std::string out;
+		while (true) {
+			if (pos >= text.size()) fail("unterminated string");
+			const char c = text[pos++];
+			if (c == '"') return out;
+			if (static_cast<unsigned char>(c) < 0x20) fail("control character in string");
+			if (c != '\\') {
+				out += c;
+				continue;
+			}
+			if (pos >= text.size()) fail("unterminated escape");
+			switch (text[pos++]) {
+			case '"': out += '"'; break;
+			case '\\': out += '\\'; break;
+			case '/': out += '/'; break;
+			case 'b': out += '\b'; break;
+			case 'f': out += '\f'; break;
+			case 'n': out += '\n'; break;
+			case 'r': out += '\r'; break;
+			case 't': out += '\t'; break;
+			case 'u': {
+				uint32_t code = hex4();
+				if (code >= 0xD800 && code < 0xDC00) {
+					// High surrogate: must be followed by the low half of the pair
+					if (text.substr(pos, 2) != "\\u") fail("unpaired surrogate");
+					pos += 2;
+					const uint32_t low = hex4();
+					if (low < 0xDC00 || low >= 0xE000) fail("unpaired surrogate");
+					code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+				} else if (code >= 0xDC00 && code < 0xE000) {
+					fail("unpaired surrogate");
+				}
+				appendUtf8(out, code);
+				break;
+			}
+			default: fail("unknown escape");
+			}
+		}
+	}
+
+	double number() {
+		// Validate the JSON number grammar, then let from_chars convert it
+		const size_t begin = pos;
+		if (pos < text.size() && text[pos] == '-') pos++;
+		if (pos >= text.size() || !std::isdigit(static_cast<unsigned char>(text[pos]))) fail("bad number");
+		if (text[pos] == '0') pos++;
+		else while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) pos++;
+		if (pos < text.size() && text[pos] == '.') {
+			pos++;
+			if (pos >= text.size() || !std::isdigit(static_cast<unsigned char>(text[pos]))) fail("bad number");
+			while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) pos++;
+		}
+		if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+			pos++;
+			if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) pos++;
+			if (pos >= text.size() || !std::isdigit(static_cast<unsigned char>(text[pos]))) fail("bad number");
+			while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) pos++;
+		}
+
+		double result = 0.0;
+		const auto [end, ec] = std::from_chars(text.data() + begin, text.data() + pos, result);
+		if (ec != std::errc() || end != text.data() + pos) fail("number out of range");
+		return result;
+	}
+
+public:
+	explicit Parser(std::string_view text) : text(text) {}
+
+	JsonValue value() {
+		skipWhitespace();
+		if (pos >= text.size()) fail("unexpected end of input");
+
+		switch (text[pos]) {
+		case '{': {
+			if (++depth > MAX_DEPTH) fail("nesting too deep");
+			pos++;
+			JsonValue::Object members;
+			skipWhitespace();
+			if (pos < text.size() && text[pos] == '}') {
+				pos++;
+			} else {
+				while (true) {
+					skipWhitespace();
+					std::string key = string();
+					skipWhitespace();
+					expect(':');
+					members.emplace_back(std::move(key), value());
+					skipWhitespace();
+					if (pos < text.size() && text[pos] == ',') { pos++; continue; }
+					expect('}');
+					break;
+				}
+			}
+			depth--;
+			return JsonValue(std::move(members));
+		}
+		case '[': {
+			if (++depth > MAX_DEPTH) fail("nesting too deep");
+			pos++;
+			JsonValue::Array elements;
+			skipWhitespace();
+			if (pos < text.size() && text[pos] == ']') {
+				pos++;
+			} else {
+				while (true) {
+					elements.push_back(value());
+					skipWhitespace();
+					if (pos < text.size() && text[pos] == ',') { pos++; continue; }
+					expect(']');
+					break;
+				}
+			}
+			depth--;
+			return JsonValue(std::move(elements));
+		}
+		case '"': return JsonValue(string());
+		case 't': literal("true"); return JsonValue(true);
+		case 'f': literal("false"); return JsonValue(false);
+		case 'n': literal("null"); return JsonValue(nullptr);
+		default: return JsonValue(number());
+		}
+	}
+
+	void end() {
+		skipWhitespace();
+		if (pos != text.size()) fail("trailing characters");
+	}
+};
+
+void dumpString(std::string& out, const std::string& s) {
+	static constexpr char HEX[] = "0123456789abcdef";
+	out += '"';
+	for (const char c : s) {
+		switch (c) {
+		case '"': out += "\\\""; break;
+		case '\\': out += "\\\\"; break;
+		case '\n': out += "\\n"; break;
+		case '\r': out += "\\r"; break;
+		case '\t': out += "\\t"; break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20) {
+				out += "\\u00";
+				out += HEX[(c >> 4) & 0xF];
+				out += HEX[c & 0xF];
+			} else {
+				out += c;
+			}
+		}
+	}
+	out += '"';
+}
+
+} // namespace
+
+JsonValue JsonValue::parse(std::string_view text) {
+	Parser parser(text);
+	JsonValue result = parser.value();
+	parser.end();
+	return result;
+}
+
+std::string JsonValue::dump() const {
+	std::string out;
+	dumpTo(out);
+	return out;
+}
+
+/**
+ * @brief Appends the value to out (numbers with std::to_chars, the shortest round-trip form)
+ */
+void JsonValue::dumpTo(std::string& out) const {
+	if (isNull()) {
+		out += "null";
+	} else if (isBool()) {
+		out += std::get<bool>(value) ? "true" : "false";
+	} else if (isNumber()) {
+		const double d = std::get<double>(value);
+		if (!std::isfinite(d)) {
+			out += "null";
+			return;
+		}
+		char buffer[32];
+		const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), d);
+		out.append(buffer, end);
+	} else if (isString()) {
+		dumpString(out, std::get<std::string>(value));
+	} else if (isArray()) {
+		out += '[';
+		const Array& elements = std::get<Array>(value);
+		for (size_t i = 0; i < elements.size(); i++) {
+			if (i != 0) out += ',';
+			elements[i].dumpTo(out);
+		}
+		out += ']';
+	} else {
+		out += '{';
+		const Object& members = std::get<Object>(value);
+		for (size_t i = 0; i < members.size(); i++) {
+			if (i != 0) out += ',';
+			dumpString(out, members[i].first);
+			out += ':';
+			members[i].second.dumpTo(out);
+		}
+		out += '}';
+	}
+}
+
+bool JsonValue::asBool() const {
+	if (!isBool()) throw std::runtime_error("JSON value is not a boolean.");
+	return std::get<bool>(value);
+}
+
+double JsonValue::asNumber() const {
+	if (!isNumber()) throw std::runtime_error("JSON value is not a number.");
+	return std::get<double>(value);
+}
+
+const std::string& JsonValue::asString() const {
+	if (!isString()) throw std::runtime_error("JSON value is not a string.");
+	return std::get<std::string>(value);
+}
+
+const JsonValue::Array& JsonValue::asArray() const {
+	if (!isArray()) throw std::runtime_error("JSON value is not an array.");
+	return std::get<Array>(value);
+}
+
+const JsonValue::Object& JsonValue::asObject() const {
+	if (!isObject()) throw std::runtime_error("JSON value is not an object.");
+	return std::get<Object>(value);
+}
+
+const JsonValue* JsonValue::find(std::string_view key) const {
+	for (const auto& [name, member] : asObject()) {
+		if (name == key) return &member;
+	}
+	return nullptr;
+}
+
+JsonValue& JsonValue::set(std::string key, JsonValue member) {
+	if (isNull()) value = Object{};
+	if (!isObject()) throw std::runtime_error("JSON value is not an object.");
+	std::get<Object>(value).emplace_back(std::move(key), std::move(member));
+	return *this;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief Minimal JSON document model for the server protocol
+ *
+ * Holds one JSON value: null, boolean, number (double), string, array or
+ * object. Objects keep their members in insertion order and are searched
+ * linearly - protocol messages have a handful of keys, so this beats a map.
+ *
+ * parse() accepts standard JSON (RFC 8259), dump() writes compact JSON on a
+ * single line, which is what the newline-delimited protocol needs.
+ */
+class JsonValue {
+public:
+	using Array = std::vector<JsonValue>;
+	using Object = std::vector<std::pair<std::string, JsonValue>>;
+
+private:
+	std::variant<std::nullptr_t, bool, double, std::string, Array, Object> value;
+
+	void dumpTo(std::string& out) const;
+
+public:
+	JsonValue() : value(nullptr) {}
+	JsonValue(std::nullptr_t) : value(nullptr) {}
+	JsonValue(bool b) : value(b) {}
+	JsonValue(double d) : value(d) {}
+	JsonValue(int i) : value(static_cast<double>(i)) {}
+	JsonValue(size_t n) : value(static_cast<double>(n)) {}
+	JsonValue(const char* s) : value(std::string(s)) {}
+	JsonValue(std::string s) : value(std::move(s)) {}
+	JsonValue(Array a) : value(std::move(a)) {}
+	JsonValue(Object o) : value(std::move(o)) {}
+
+	/**
+	 * @brief Parses a JSON text (surrounding whitespace allowed)
+	 *
+	 * @param text JSON document
+	 * @return The parsed value
+	 * @throws std::runtime_error If the text is not valid JSON (the message gives the offset)
+	 */
+	static JsonValue parse(std::string_view text);
+
+	/**
+	 * @brief Serializes the value as compact, single-line JSON
+	 *
+	 * Numbers use the shortest representation that reads back to the same
+	 * double. NaN and infinities, which JSON can't represent, are written as null.
+	 */
+	std::string dump() const;
+
+	bool isNull() const { return std::holds_alternative<std::nullptr_t>(value); }
+	bool isBool() const { return std::holds_alternative<bool>(value); }
+	bool isNumber() const { return std::holds_alternative<double>(value); }
+	bool isString() const { return std::holds_alternative<std::string>(value); }
+	bool isArray() const { return std::holds_alternative<Array>(value); }
+	bool isObject() const { return std::holds_alternative<Object>(value); }
+
+	/**
+	 * @brief Typed accessors
+	 *
+	 * @throws std::runtime_error If the value is of another type
+	 */
+	bool asBool() const;
+	double asNumber() const;
+	const std::string& asString() const;
+	const Array& asArray() const;
+	const Object& asObject() const;
+
+	/**
+	 * @brief Returns the member with the given key, or nullptr if there is none
+	 *
+	 * @throws std::runtime_error If the value is not an object
+	 */
+	const JsonValue* find(std::string_view key) const;
+
+	/**
+	 * @brief Adds a member to an object (a null value becomes an empty object first)
+	 *
+	 * Keys are not checked for duplicates.
+	 *
+	 * @return This value, so calls can be chained
+	 * @throws std::runtime_error If the value is neither an object nor null
+	 */
+	JsonValue& set(std::string key, JsonValue member);
+};
@@ -0,0 +1,482 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "SweepCoordinator.h"
+#include "Json.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t READ_CHUNK = 64 * 1024;  // Bytes per recv()
+constexpr int POLL_MS = 50;               // Longest wait before the stragglers are looked at again
+constexpr size_t SHARDS_PER_SLOT = 8;     // Default shard count per worker slot
+constexpr size_t MAX_SHARD_SIZE = 1024;   // Largest default shard
+
+/**
+ * @brief Connection to one worker
+ */
+struct Peer {
+	std::string name;      // "host:port", for error messages
+	int fd = -1;
+	std::string pending;   // Received bytes not yet forming a whole line
+	size_t slots = 1;      // Backtests the worker runs at the same time
+	size_t inFlight = 0;   // Shards sent and not finished
+	bool alive = true;
+
+	Peer() = default;
+	Peer(const Peer&) = delete;
+	Peer& operator=(const Peer&) = delete;
+	~Peer() { if (fd >= 0) ::close(fd); }
+
+	void close() {
+		if (fd >= 0) ::close(fd);
+		fd = -1;
+		alive = false;
+	}
+};
+
+/**
+ * @brief Splits "host:port", checking the port
+ */
+void splitAddress(const std::string& address, std::string& host, std::string& port) {
+	const size_t colon = address.rfind(':');
+	if (colon == std::string::npos || colon == 0 || colon + 1 == address.size()) {
+		throw std::invalid_argument("Worker address '" + address + "' must be host:port.");
+	}
+	host = address.substr(0, colon);
+	port = address.substr(colon + 1);
+	if (port.find_first_not_of("0123456789") != std::string::npos || port.size() > 5 || std::stoul(port) == 0 || std::stoul(port) > 65535) {
+		throw std::invalid_argument("Worker address '" + address + "' has an invalid port.");
+	}
+}
+
+/**
+ * @brief Opens a TCP connection, giving up after timeoutMs
+ */
+int connectTo(const std::string& address, int timeoutMs) {
+	std::string host, port;
+	splitAddress(address, host, port);
+
+	addrinfo hints{};
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	addrinfo* found = nullptr;
+	if (const int error = ::getaddrinfo(host.c_str(), port.c_str(), &hints, &found); error != 0) {
+		throw std::runtime_error("Cannot resolve worker '" + address + "': " + ::gai_strerror(error));
+	}
+	std::unique_ptr<addrinfo, decltype(&::freeaddrinfo)> addresses(found, &::freeaddrinfo);
+
+	const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+	if (fd < 0) throw std::runtime_error(std::string("Cannot create socket: ") + std::strerror(errno));
+
+	// Non-blocking connect, so an unreachable host costs at most the timeout
+	const int flags = ::fcntl(fd, F_GETFL, 0);
+	::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+	int error = 0;
+	if (::connect(fd, addresses->ai_addr, addresses->ai_addrlen) != 0) {
+		error = errno;
+		if (error == EINPROGRESS) {
+			pollfd waiting{ fd, POLLOUT, 0 };
+			const int ready = ::poll(&waiting, 1, timeoutMs);
+			socklen_t length = sizeof(error);
+			if (ready <= 0) error = ready == 0 ? ETIMEDOUT : errno;
+			else ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+		}
+	}
+	if (error != 0) {
+		::close(fd);
+		throw std::runtime_error("Cannot connect to worker '" + address + "': " + std::strerror(error));
+	}
+	::fcntl(fd, F_SETFL, flags);
+
+	// Requests and events are single short lines - send them right away
+	const int noDelay = 1;
+	::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+	return fd;
+}
+
+/**
+ * @brief Sends one request as a JSON line
+ *
+ * @return false if the worker is gone
+ */
+bool sendLine(Peer& peer, const JsonValue& request) {
+	std::string line = request.dump();
+	line += '\n';
+
+	size_t sent = 0;
+	while (sent < line.size()) {
+		const ssize_t n = ::send(peer.fd, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+		if (n < 0 && errno == EINTR) continue;
+		if (n <= 0) return false;
+		sent += static_cast<size_t>(n);
+	}
+	return true;
+}
+
+/**
+ * @brief Reads what the worker has sent and appends the complete lines to lines
+ *
+ * @return false if the connection was closed
+ */
+bool receiveLines(Peer& peer, std::vector<std::string>& lines) {
+	char chunk[READ_CHUNK];
+	ssize_t n;
+	do {
+		n = ::recv(peer.fd, chunk, sizeof(chunk), 0);
+	} while (n < 0 && errno == EINTR);
+	if (n <= 0) return false;
+
+	peer.pending.append(chunk, static_cast<size_t>(n));
+	size_t begin = 0;
+	for (size_t end; (end = peer.pending.find('\n', begin)) != std::string::npos; begin = end + 1) {
+		lines.push_back(peer.pending.substr(begin, end - begin));
+	}
+	peer.pending.erase(0, begin);
+	return true;
+}
+
+/**
+ * @brief Pings a worker and reads its pool size from the pong
+ */
+void handshake(Peer& peer, int timeoutMs) {
+	JsonValue ping;
+	ping.set("type", "ping").set("id", "hello");
+	if (!sendLine(peer, ping)) throw std::runtime_error("Worker '" + peer.name + "' closed the connection.");
+
+	const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+	while (true) {
+		const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+		pollfd waiting{ peer.fd, POLLIN, 0 };
+		if (left <= 0 || ::poll(&waiting, 1, static_cast<int>(left)) <= 0) {
+			throw std::runtime_error("Worker '" + peer.name + "' did not answer.");
+		}
+
+		std::vector<std::string> lines;
+		if (!receiveLines(peer, lines)) throw std::runtime_error("Worker '" + peer.name + "' closed the connection.");
+		for (const std::string& line : lines) {
+			const JsonValue pong = JsonValue::parse(line);
+			const JsonValue* id = pong.find("id");
+			if (!id || !id->isString() || id->asString() != "hello") continue;
+
+			const JsonValue* workers = pong.find("workers");
+			peer.slots = workers ? std::max<size_t>(1, static_cast<size_t>(workers->asNumber())) : 1;
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Returns a field of a worker's event
+ *
+ * @throws std::runtime_error If the event has no such field, or not of the expected type
+ */
+const JsonValue& eventField(const JsonValue& event, const char* field, bool (JsonValue::*expected)() const, const Peer& peer) {
+	const JsonValue* value = event.find(field);
+	if (!value || !(value->*expected)()) {
+		throw std::runtime_error("Worker '" + peer.name + "' sent an event without a valid '" + field + "' field.");
+	}
+	return *value;
+}
+
+/**
+ * @brief Converts the stats object of a result event (NaN travels as null)
+ */
+StatsMap statsFromJson(const JsonValue& stats) {
+	StatsMap map;
+	for (const auto& [metric, value] : stats.asObject()) {
+		map[metric] = value.isNull() ? std::numeric_limits<double>::quiet_NaN() : value.asNumber();
+	}
+	return map;
+}
+
+} // namespace
+
+SweepCoordinator::SweepCoordinator(CoordinatorConfig config) : config(std::move(config)) {
+	if (this->config.workers.empty()) throw std::invalid_argument("A sweep needs at least one worker.");
+	for (const std::string& address : this->config.workers) {
+		std::string host, port;
+		splitAddress(address, host, port);
+	}
+	if (this->config.threadsPerShard == 0 || this->config.threadsPerShard > 256) {
+		throw std::invalid_argument("Threads per shard must be between 1 and 256.");
+	}
+	if (!(this->config.stragglerFactor >= 1.0)) throw std::invalid_argument("Straggler factor must be at least 1.");
+	if (this->config.connectTimeoutMs <= 0) throw std::invalid_argument("Connect timeout must be positive.");
+}
+
+/**
+ * @brief Hands out the shards, collects the results, backs up stragglers and survives lost workers
+ *
+ * Every shard sent is an attempt, identified by the id of its request. A
+ * shard is complete when one of its attempts is done: its results are kept,
+ * its other attempts are cancelled and forgotten, so whatever they still
+ * send is ignored. A cancelled attempt still counts against its worker's
+ * pool until its "done" event (a sweep that has started runs to its end).
+ * An attempt cut short (worker lost, cancelled) puts its
+ * shard back at the front of the queue if it was the shard's last one.
+ */
+std::vector<SweepResult> SweepCoordinator::run(size_t ticks, uint64_t seed, const std::string& strategy, const ParameterGrid& grid, double capital) {
+	report = {};
+	const size_t variantCount = grid.size();
+	std::vector<SweepResult> results(variantCount);
+	if (variantCount == 0) return results;
+
+	// Connect and learn each worker's pool size; unreachable workers are left out (and reported)
+	std::vector<std::unique_ptr<Peer>> peers;
+	std::string failures;
+	for (const std::string& address : config.workers) {
+		auto peer = std::make_unique<Peer>();
+		peer->name = address;
+		try {
+			peer->fd = connectTo(address, config.connectTimeoutMs);
+			handshake(*peer, config.connectTimeoutMs);
+			peers.push_back(std::move(peer));
+		} catch (const std::exception& e) {
+			report.unreachable.push_back(e.what());
+			failures += std::string("\n  ") + e.what();
+		}
+	}
+	if (peers.empty()) throw std::runtime_error("No sweep worker could be reached:" + failures);
+	report.workers = peers.size();
+
+	size_t slots = 0;
+	for (const auto& peer : peers) slots += peer->slots;
+	const size_t shardSize = config.shardSize != 0 ? config.shardSize
+		: std::clamp<size_t>((variantCount + slots * SHARDS_PER_SLOT - 1) / (slots * SHARDS_PER_SLOT), 1, MAX_SHARD_SIZE);
+
+	struct Shard {
+		size_t begin, end;  // Grid indices [begin, end)
+		size_t live = 0;    // Attempts running
+		bool done = false;
+	};
+	struct Attempt {
+		size_t shard;
+		Peer* peer;
+		Clock::time_point started;
+		std::vector<StatsMap> stats;  // Per variant of the shard
+		size_t received = 0;
+	};
+
+	std::vector<Shard> shards;
+	std::deque<size_t> queue;
+	for (size_t begin = 0; begin < variantCount; begin += shardSize) {
+		queue.push_back(shards.size());
+		shards.push_back(Shard{ begin, std::min(begin + shardSize, variantCount) });
+	}
+	report.shards = shards.size();
+
+	std::map<uint64_t, Attempt> attempts;
+	uint64_t nextAttempt = 0;
+	size_t completed = 0;
+	double completedSeconds = 0.0;  // Total duration of the completed shards
+
+	// Cancelled attempts, each holding a place in its worker's inFlight until its "done" arrives
+	std::map<uint64_t, Peer*> cancelling;
+
+	auto forget = [&](std::map<uint64_t, Attempt>::iterator attempt) {
+		shards[attempt->second.shard].live--;
+		attempt->second.peer->inFlight--;
+		return attempts.erase(attempt);
+	};
+
+	auto setAside = [&](std::map<uint64_t, Attempt>::iterator attempt) {
+		shards[attempt->second.shard].live--;
+		cancelling.emplace(attempt->first, attempt->second.peer);
+		return attempts.erase(attempt);
+	};
+
+	auto dropPeer = [&](Peer& peer) {
+		peer.close();
+		for (auto copy = cancelling.begin(); copy != cancelling.end(); ) {
+			if (copy->second != &peer) {
+				++copy;
+				continue;
+			}
+			peer.inFlight--;
+			copy = cancelling.erase(copy);
+		}
+		for (auto attempt = attempts.begin(); attempt != attempts.end(); ) {
+			if (attempt->second.peer != &peer) {
+				++attempt;
+				continue;
+			}
+			const size_t shard = attempt->second.shard;
+			attempt = forget(attempt);
+			if (!shards[shard].done && shards[shard].live == 0) {
+				queue.push_front(shard);
+				report.requeued++;
+			}
+		}
+	};
+
+	auto dispatch = [&](Peer& peer, size_t shard) {
+		JsonValue::Array variants;
+		for (size_t i = shards[shard].begin; i < shards[shard].end; i++) {
+			JsonValue variant = JsonValue::Object{};
+			for (const auto& [name, value] : grid.at(i)) variant.set(name, value);
+			variants.push_back(std::move(variant));
+		}
+
+		const uint64_t id = nextAttempt++;
+		JsonValue request;
+		request.set("type", "sweep").set("id", static_cast<double>(id))
+			.set("ticks", ticks).set("seed", static_cast<double>(seed)).set("capital", capital)
+			.set("strategy", strategy).set("variants", std::move(variants)).set("threads", config.threadsPerShard);
+
+		attempts.emplace(id, Attempt{ shard, &peer, Clock::now(), std::vector<StatsMap>(shards[shard].end - shards[shard].begin) });
+		shards[shard].live++;
+		peer.inFlight++;
+		if (!sendLine(peer, request)) dropPeer(peer);
+	};
+
+	// The straggler a free worker should back up: the longest-running shard with a single attempt elsewhere
+	auto straggler = [&](const Peer& peer) -> std::optional<size_t> {
+		if (completed == 0) return std::nullopt;
+		const auto threshold = std::chrono::duration<double>(config.stragglerFactor * completedSeconds / completed);
+		const Attempt* oldest = nullptr;
+		for (const auto& [id, attempt] : attempts) {
+			if (attempt.peer == &peer || shards[attempt.shard].live != 1) continue;
+			if (Clock::now() - attempt.started <= threshold) continue;
+			if (!oldest || attempt.started < oldest->started) oldest = &attempt;
+		}
+		return oldest ? std::optional<size_t>(oldest->shard) : std::nullopt;
+	};
+
+	auto assign = [&] {
+		for (const auto& peer : peers) {
+			// Queued shards keep each worker one ahead of its pool; backups only go to idle pool threads
+			while (peer->alive && peer->inFlight <= peer->slots) {
+				if (!queue.empty()) {
+					const size_t shard = queue.front();
+					queue.pop_front();
+					dispatch(*peer, shard);
+					continue;
+				}
+				const std::optional<size_t> shard = peer->inFlight < peer->slots ? straggler(*peer) : std::nullopt;
+				if (!shard) break;
+				dispatch(*peer, *shard);
+				report.backups++;
+			}
+		}
+	};
+
+	auto handleEvent = [&](Peer& peer, const std::string& line) {
+		JsonValue event;
+		try {
+			event = JsonValue::parse(line);
+		} catch (const std::exception& e) {
+			throw std::runtime_error("Worker '" + peer.name + "' sent an invalid event: " + e.what());
+		}
+		const JsonValue* id = event.find("id");
+		const JsonValue* name = event.find("event");
+		if (!id || !id->isNumber() || !name) return;
+		const std::string& type = name->asString();
+		const uint64_t attemptId = static_cast<uint64_t>(id->asNumber());
+		const auto attempt = attempts.find(attemptId);
+		if (attempt == attempts.end()) {
+			// A cancelled attempt frees its place in the worker's pool once it is over
+			const auto copy = cancelling.find(attemptId);
+			if (copy != cancelling.end() && (type == "done" || type == "error")) {
+				copy->second->inFlight--;
+				cancelling.erase(copy);
+			}
+			return;  // A cancelled or lost attempt
+		}
+
+		Attempt& current = attempt->second;
+		Shard& shard = shards[current.shard];
+
+		if (type == "result") {
+			const double variant = eventField(event, "variant", &JsonValue::isNumber, peer).asNumber();
+			if (!(variant >= 0.0 && variant < static_cast<double>(current.stats.size()))) {
+				throw std::runtime_error("Worker '" + peer.name + "' sent a result for a variant outside of its shard.");
+			}
+			current.stats[static_cast<size_t>(variant)] = statsFromJson(eventField(event, "stats", &JsonValue::isObject, peer));
+			current.received++;
+		} else if (type == "done") {
+			const JsonValue* cancelled = event.find("cancelled");
+			if ((cancelled && cancelled->asBool()) || current.received != current.stats.size()) {
+				const size_t index = current.shard;
+				forget(attempt);
+				if (!shards[index].done && shards[index].live == 0) queue.push_front(index);
+				return;
+			}
+
+			for (size_t k = 0; k < current.stats.size(); k++) {
+				const size_t index = shard.begin + k;
+				results[index] = SweepResult{ index, grid.at(index), std::move(current.stats[k]) };
+			}
+			shard.done = true;
+			completed++;
+			completedSeconds += std::chrono::duration<double>(Clock::now() - current.started).count();
+
+			// The other copies of the shard are no longer needed. They are all set aside before any
+			// cancel is sent, as dropping a worker that can't be reached erases attempts too
+			const size_t index = current.shard;
+			forget(attempt);
+			std::vector<std::pair<Peer*, uint64_t>> cancels;  // Owner and attempt ID of each copy
+			for (auto other = attempts.begin(); other != attempts.end(); ) {
+				if (other->second.shard != index) {
+					++other;
+					continue;
+				}
+				cancels.emplace_back(other->second.peer, other->first);
+				other = setAside(other);
+			}
+			for (const auto& [owner, copy] : cancels) {
+				if (!owner->alive) continue;  // Dropped by an earlier cancel
+				JsonValue cancel;
+				cancel.set("type", "cancel").set("id", static_cast<double>(copy));
+				if (!sendLine(*owner, cancel)) dropPeer(*owner);
+			}
+		} else if (type == "error") {
+			throw std::runtime_error("Worker '" + peer.name + "' rejected a shard: " + eventField(event, "error", &JsonValue::isString, peer).asString());
+		}
+	};
+
+	while (completed < shards.size()) {
+		assign();
+
+		std::vector<pollfd> waiting;
+		std::vector<Peer*> owners;
+		for (const auto& peer : peers) {
+			if (!peer->alive) continue;
+			waiting.push_back(pollfd{ peer->fd, POLLIN, 0 });
+			owners.push_back(peer.get());
+		}
+		if (waiting.empty()) throw std::runtime_error("Every sweep worker was lost before the sweep finished.");
+
+		if (::poll(waiting.data(), waiting.size(), POLL_MS) < 0 && errno != EINTR) {
+			throw std::runtime_error(std::string("Cannot poll the sweep workers: ") + std::strerror(errno));
+		}
+		for (size_t p = 0; p < waiting.size(); p++) {
+			if (waiting[p].revents == 0 || !owners[p]->alive) continue;
+
+			std::vector<std::string> lines;
+			const bool open = receiveLines(*owners[p], lines);
+			for (const std::string& line : lines) handleEvent(*owners[p], line);
+			if (!open) dropPeer(*owners[p]);
+		}
+	}
+	return results;
+}
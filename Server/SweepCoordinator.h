@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ParameterSweep.h"
+
+/**
+ * @brief Settings of a SweepCoordinator
+ */
+struct CoordinatorConfig {
+	std::vector<std::string> workers;  // "host:port" of each worker (a BacktestServer)
+	size_t shardSize = 0;              // Variants per shard (0 = about 8 shards per worker slot)
+	size_t threadsPerShard = 1;        // Sweep threads a worker gives each shard
+	double stragglerFactor = 2.0;      // Shards running this many times longer than the mean get a backup copy
+	int connectTimeoutMs = 5000;       // Time allowed to reach each worker at the start of a run
+};
+
+/**
+ * @brief Counters of the last SweepCoordinator::run()
+ */
+struct CoordinatorReport {
+	size_t workers = 0;   // Workers that took part
+	size_t shards = 0;    // Shards the grid was cut into
+	size_t backups = 0;   // Backup copies started for straggling shards
+	size_t requeued = 0;  // Shards sent again because their worker was lost
+	std::vector<std::string> unreachable;  // Why each worker that couldn't be reached was left out
+};
+
+/**
+ * @brief Spreads a parameter sweep over several machines running the backtest server
+ *
+ * The grid is cut into shards of contiguous variants, and each shard is sent
+ * to a worker as one "sweep" request: the dataset ID (ticks and seed, which
+ * every worker generates or finds in its own DatasetCache), the strategy
+ * name and the parameters of its variants. Workers only send back the
+ * statistics of each variant, so the traffic doesn't depend on the length
+ * of the dataset.
+ *
+ * Scheduling:
+ * - Every worker is kept one shard ahead of its pool size (from its pong),
+ *   so it never waits for the coordinator between two shards
+ * - Once no shard is left to hand out, a free worker starts a backup copy of
+ *   the shard that has been running longest, if that is more than
+ *   stragglerFactor times the mean shard duration so far. The first copy to
+ *   finish wins, and the other one is cancelled (or discarded if it already
+ *   started)
+ * - The shards of a worker that disconnects are handed out again
+ *
+ * Everything runs on the calling thread, multiplexing the worker connections
+ * with poll().
+ */
+class SweepCoordinator {
+private:
+	CoordinatorConfig config;
+	CoordinatorReport report;
+
+public:
+	/**
+	 * @brief Creates a coordinator (workers are only contacted by run())
+	 *
+	 * @param config Worker addresses and scheduling settings
+	 * @throws std::invalid_argument If there is no worker or a setting is out of range
+	 */
+	explicit SweepCoordinator(CoordinatorConfig config);
+
+	/**
+	 * @brief Runs every variant of the grid on the workers
+	 *
+	 * @param ticks Length of the generated dataset
+	 * @param seed Seed of the generated dataset
+	 * @param strategy Name of a sweepable strategy of the server (see BacktestServer)
+	 * @param grid Parameter space to sweep
+	 * @param capital Starting capital of every variant
+	 * @return One result per grid point, ordered by grid index (same as ParameterSweep::run())
+	 * @throws std::runtime_error If no worker can be reached, all of them are lost, or a worker rejects a shard or sends a malformed event
+	 */
+	std::vector<SweepResult> run(size_t ticks, uint64_t seed, const std::string& strategy, const ParameterGrid& grid, double capital);
+
+	/**
+	 * @brief Returns the counters of the last run()
+	 */
+	const CoordinatorReport& getReport() const { return report; }
+};
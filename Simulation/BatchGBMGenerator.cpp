@@ -0,0 +1,453 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <thread>
+
+#include "BatchGBMGenerator.h"
+#include "Philox.h"
+
+namespace {
+
+constexpr size_t BLOCK_TICKS = 1024;  // Ticks generated per block (8 KB of doubles, stays in L1)
+
+/**
+ * @brief Independent random streams of a path (second word of the Philox counter)
+ */
+enum Stream : uint32_t {
+	DIFFUSION = 0,  // Normal draws of the Brownian increments
+	VOLUME = 1,     // Uniform draws of the tick volumes
+	SPREAD = 2,     // Normal draws of the quote spreads
+	JUMP_GAP = 3,   // Uniform draws of the gaps between jumps
+	JUMP_SIZE = 4   // Normal draws of the jump sizes
+};
+
+/**
+ * @brief Returns the random words for draw pair `index` of a stream of a path
+ */
+Philox4x32::Counter draw(Philox4x32::Key key, Stream stream, uint64_t path, uint64_t index) {
+	return Philox4x32::generate({ { uint32_t(index), stream, uint32_t(path), uint32_t(path >> 32) } }, key);
+}
+
+/**
+ * @brief Fills out with uniforms in (0, 1): draws [first, first + out.size()) of a stream
+ *
+ * Each counter gives two uniforms, so first must be even.
+ */
+void fillUniforms(Philox4x32::Key key, Stream stream, uint64_t path, size_t first, std::span<double> out) {
+	for (size_t i = 0; i < out.size(); i += 2) {
+		const Philox4x32::Counter r = draw(key, stream, path, (first + i) / 2);
+		out[i] = Philox4x32::toUniform(r.v[0], r.v[1]);
+		if (i + 1 < out.size()) out[i + 1] = Philox4x32::toUniform(r.v[2], r.v[3]);
+	}
+}
+
+/**
+ * @brief Fills out with standard normals: draws [first, first + out.size()) of a stream
+ *
+ * Box-Muller transform: each counter gives two uniforms, turned into two
+ * normals. Uniforms are drawn first in a pure integer loop, then transformed in
+ * a separate loop, so that each loop can be vectorized on its own.
+ * first must be even and out.size() <= BLOCK_TICKS.
+ */
+void fillNormals(Philox4x32::Key key, Stream stream, uint64_t path, size_t first, std::span<double> out) {
+	double radius[BLOCK_TICKS / 2];
+	double angle[BLOCK_TICKS / 2];
+	const size_t pairs = (out.size() + 1) / 2;
+
+	for (size_t p = 0; p < pairs; p++) {
+		const Philox4x32::Counter r = draw(key, stream, path, first / 2 + p);
+		radius[p] = Philox4x32::toUniform(r.v[0], r.v[1]);
+		angle[p] = Philox4x32::toUniform(r.v[2], r.v[3]);
+	}
+	for (size_t p = 0; p < pairs; p++) {
+		radius[p] = std::sqrt(-2.0 * std::log(radius[p]));
+		angle[p] *= 2.0 * std::numbers::pi;
+	}
+	for (size_t p = 0; p < pairs; p++) {
+		out[2 * p] = radius[p] * std::cos(angle[p]);
+		if (2 * p + 1 < out.size()) out[2 * p + 1] = radius[p] * std::sin(angle[p]);
+	}
+}
+
+/**
+ * @brief Walks the jump times of a path (Poisson thinning of the ticks)
+ *
+ * A jump happens on each tick with probability lambda, independently. The
+ * number of jump-free ticks before the next jump then follows a geometric
+ * distribution: gap = floor(log(U) / log(1 - lambda)). Drawing the gaps gives
+ * exactly the same process as one Bernoulli draw per tick, at the cost of one
+ * draw per jump.
+ */
+class JumpSchedule {
+private:
+	Philox4x32::Key key;
+	uint64_t path;
+	double logNoJump;        // log(1 - lambda)
+	double jumpMu;
+	double jumpSigma;
+	uint64_t jumpCount = 0;  // Jumps drawn so far (counter of the jump streams)
+	size_t nextTick;         // Tick of the next jump (max() = no more jumps)
+
+	void advance(size_t from) {
+		const Philox4x32::Counter r = draw(key, JUMP_GAP, path, jumpCount);
+		const double gap = std::floor(std::log(Philox4x32::toUniform(r.v[0], r.v[1])) / logNoJump);
+		const double limit = double(std::numeric_limits<size_t>::max() / 2);
+		nextTick = gap < limit - double(from) ? from + size_t(gap) : std::numeric_limits<size_t>::max();
+	}
+
+public:
+	JumpSchedule(Philox4x32::Key key, uint64_t path, double lambda, double jumpMu, double jumpSigma)
+		: key(key), path(path), logNoJump(std::log1p(-std::min(lambda, 1.0))), jumpMu(jumpMu), jumpSigma(jumpSigma) {
+		if (lambda <= 0.0) nextTick = std::numeric_limits<size_t>::max();
+		else if (lambda >= 1.0) nextTick = 0;
+		else advance(0);
+	}
+
+	/**
+	 * @brief Tick of the next jump
+	 */
+	size_t next() const { return nextTick; }
+
+	/**
+	 * @brief Returns the size of the next jump and moves to the one after it
+	 */
+	double pop() {
+		const Philox4x32::Counter r = draw(key, JUMP_SIZE, path, jumpCount);
+		const double u1 = Philox4x32::toUniform(r.v[0], r.v[1]);
+		const double u2 = Philox4x32::toUniform(r.v[2], r.v[3]);
+		const double size = jumpMu + jumpSigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * std::numbers::pi * u2);
+
+		jumpCount++;
+		if (std::isinf(logNoJump)) nextTick++;  // lambda = 1: a jump on every tick
+		else advance(nextTick + 1);
+		return size;
+	}
+};
+
+/**
+ * @brief Walks the log-price of one path, one block of ticks at a time
+ *
+ * For each block of up to BLOCK_TICKS ticks:
+ * 1. Draw the standard normals Z of the block
+ * 2. Log-return of tick i: r = (mu - 0.5*sigma^2)*dt + sigma*sqrt(dt)*Z
+ * 3. Add the jumps falling inside the block to their tick's log-return
+ * 4. Accumulate the log-price (the only loop-carried dependency)
+ * 5. prices = exp(log-price) - one exp() per tick
+ *
+ * The walker carries the log-price and the jump schedule from one block to the
+ * next, so a path can be produced in pieces (streaming) and still be the exact
+ * same path as one generated in one go. Blocks must start on multiples of
+ * BLOCK_TICKS (only the last block of a path may be shorter).
+ */
+class PathWalker {
+private:
+	Philox4x32::Key key;
+	uint64_t path;
+	double drift;            // (mu - 0.5*sigma^2)*dt
+	double diffusion;        // sigma*sqrt(dt)
+	JumpSchedule jumps;
+	double logPrice;
+	size_t position = 0;     // Index of the next tick
+
+public:
+	PathWalker(Philox4x32::Key key, uint64_t path, TimeFrame tf, double startPrice, double mu, double impVol,
+		double jumpLambda, double jumpMu, double jumpSigma)
+		: key(key), path(path), jumps(key, path, jumpLambda, jumpMu, jumpSigma), logPrice(std::log(startPrice)) {
+		const double dt = 1.0 / (252.0 * getTicksPerDay(tf));
+		drift = (mu - 0.5 * impVol * impVol) * dt;
+		diffusion = impVol * std::sqrt(dt);
+	}
+
+	/**
+	 * @brief Writes the prices of the next out.size() ticks (at most BLOCK_TICKS)
+	 */
+	void next(std::span<double> out) {
+		const size_t begin = position;
+		const size_t count = out.size();
+		const size_t end = begin + count;
+		double block[BLOCK_TICKS];
+
+		fillNormals(key, DIFFUSION, path, begin, std::span<double>(block, count));
+		for (size_t i = 0; i < count; i++) {
+			block[i] = drift + diffusion * block[i];
+		}
+		while (jumps.next() < end) {
+			const size_t tick = jumps.next();
+			block[tick - begin] += jumps.pop();
+		}
+		for (size_t i = 0; i < count; i++) {
+			logPrice += block[i];
+			block[i] = logPrice;
+		}
+		for (size_t i = 0; i < count; i++) {
+			out[i] = std::exp(block[i]);
+		}
+		position = end;
+	}
+
+	/**
+	 * @brief Index of the next tick
+	 */
+	size_t tell() const { return position; }
+};
+
+/**
+ * @brief Builds trade ticks from a block of prices, adding uniform(0.5, 1.5) volumes
+ *
+ * begin is the index of the first tick in the path (even), at most BLOCK_TICKS ticks.
+ */
+void makeTicks(Philox4x32::Key key, uint64_t path, size_t begin, std::span<const double> prices, Tick* out) {
+	double volumes[BLOCK_TICKS];
+	fillUniforms(key, VOLUME, path, begin, std::span<double>(volumes, prices.size()));
+	for (size_t i = 0; i < prices.size(); i++) {
+		out[i] = Tick{ static_cast<uint64_t>(begin + i), prices[i], 0.5 + volumes[i] };
+	}
+}
+
+/**
+ * @brief Builds quote ticks around a block of mid-prices
+ *
+ * The spread is N(spreadMu, spreadSigma) truncated to a minimum of 0.001.
+ * begin is the index of the first tick in the path (even), at most BLOCK_TICKS ticks.
+ */
+void makeQuotes(Philox4x32::Key key, uint64_t path, size_t begin, std::span<const double> prices,
+	double spreadMu, double spreadSigma, QuoteTick* out) {
+	double volumes[BLOCK_TICKS];
+	double spreads[BLOCK_TICKS];
+	fillUniforms(key, VOLUME, path, begin, std::span<double>(volumes, prices.size()));
+	fillNormals(key, SPREAD, path, begin, std::span<double>(spreads, prices.size()));
+	for (size_t i = 0; i < prices.size(); i++) {
+		const double mid = prices[i];
+		const double halfSpread = std::max(0.001, spreadMu + spreadSigma * spreads[i]) / 2.0;
+		out[i] = QuoteTick{ static_cast<uint64_t>(begin + i), mid - halfSpread, mid + halfSpread, 0.5 + volumes[i] };
+	}
+}
+
+/**
+ * @brief Tick source generating one path block by block
+ *
+ * Holds one block of ticks, so memory doesn't depend on the path length.
+ * makeBlock(begin, prices, out) turns a block of prices into ticks.
+ */
+template<typename TickT, typename MakeBlock>
+class PathTickSource : public TickSource<TickT> {
+private:
+	PathWalker walker;
+	size_t nTicks;
+	MakeBlock makeBlock;
+	TickT buffer[BLOCK_TICKS];
+	size_t bufferCount = 0;
+	size_t bufferPosition = 0;
+
+public:
+	PathTickSource(PathWalker walker, size_t nTicks, MakeBlock makeBlock)
+		: walker(walker), nTicks(nTicks), makeBlock(makeBlock) {}
+
+	size_t read(std::span<TickT> out) override {
+		size_t written = 0;
+		while (written < out.size()) {
+			if (bufferPosition == bufferCount) {
+				const size_t begin = walker.tell();
+				if (begin >= nTicks) break;
+
+				double prices[BLOCK_TICKS];
+				const size_t count = std::min(BLOCK_TICKS, nTicks - begin);
+				walker.next(std::span<double>(prices, count));
+				makeBlock(begin, std::span<const double>(prices, count), buffer);
+				bufferCount = count;
+				bufferPosition = 0;
+			}
+			const size_t count = std::min(out.size() - written, bufferCount - bufferPosition);
+			std::copy_n(buffer + bufferPosition, count, out.begin() + written);
+			bufferPosition += count;
+			written += count;
+		}
+		return written;
+	}
+};
+
+/**
+ * @brief Runs job(worker, index) for every index in [0, count) on a pool of threads
+ *
+ * Every path costs the same, so there is no need for work stealing: each
+ * worker simply takes the next index from a shared atomic counter until there
+ * is none left. If a job throws, the remaining indices are abandoned and the
+ * first exception is rethrown once all workers have stopped.
+ */
+void parallelFor(size_t threadCount, size_t count, const std::function<void(size_t worker, size_t index)>& job) {
+	if (count == 0) return;
+
+	size_t workerCount = threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+	workerCount = std::min(workerCount, count);
+
+	std::atomic<size_t> next{ 0 };
+	std::atomic<bool> failed{ false };
+	std::exception_ptr firstError;
+	std::mutex errorMutex;
+
+	auto worker = [&](size_t self) {
+		while (!failed.load(std::memory_order_relaxed)) {
+			const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+			if (index >= count) return;
+
+			try {
+				job(self, index);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if (!firstError) firstError = std::current_exception();
+				failed.store(true, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	// Launch the extra workers, run the first one on the calling thread
+	std::vector<std::thread> workers;
+	workers.reserve(workerCount - 1);
+	for (size_t w = 1; w < workerCount; w++) {
+		workers.emplace_back(worker, w);
+	}
+	worker(0);
+
+	for (auto& thread : workers) {
+		thread.join();
+	}
+
+	if (firstError) std::rethrow_exception(firstError);
+}
+
+} // namespace
+
+/**
+ * @brief Stores the model parameters (nothing is precomputed per path)
+ */
+BatchGBMGenerator::BatchGBMGenerator(size_t nTicks,
+	TimeFrame tf,
+	uint64_t seed,
+	double startPrice,
+	double mu,
+	double impVol,
+	double jumpLambda,
+	double jumpMu,
+	double jumpSigma,
+	double spreadMu,
+	double spreadSigma)
+	: nTicks(nTicks),
+	  tf(tf),
+	  seed(seed),
+	  startPrice(startPrice),
+	  mu(mu),
+	  impVol(impVol),
+	  jumpLambda(jumpLambda),
+	  jumpMu(jumpMu),
+	  jumpSigma(jumpSigma),
+	  spreadMu(spreadMu),
+	  spreadSigma(spreadSigma) {
+}
+
+/**
+ * @brief Sets the number of worker threads
+ */
+void BatchGBMGenerator::setThreadCount(size_t count) {
+	threadCount = count;
+}
+
+/**
+ * @brief Generates one path block by block (see PathWalker)
+ *
+ * The log-price starts at log(startPrice), so the first price already includes
+ * the first tick's move (same convention as GBMJumpGenerator).
+ */
+void BatchGBMGenerator::generatePath(uint64_t pathIndex, std::span<double> prices) const {
+	PathWalker walker(Philox4x32::keyFromSeed(seed), pathIndex, tf, startPrice, mu, impVol, jumpLambda, jumpMu, jumpSigma);
+	for (size_t begin = 0; begin < prices.size(); begin += BLOCK_TICKS) {
+		walker.next(prices.subspan(begin, std::min(BLOCK_TICKS, prices.size() - begin)));
+	}
+}
+
+/**
+ * @brief Generates one path and adds uniform(0.5, 1.5) volumes
+ */
+std::vector<Tick> BatchGBMGenerator::generateTicks(uint64_t pathIndex) const {
+	const Philox4x32::Key key = Philox4x32::keyFromSeed(seed);
+	std::vector<double> prices(nTicks);
+	generatePath(pathIndex, prices);
+
+	std::vector<Tick> ticks(nTicks);
+	for (size_t begin = 0; begin < nTicks; begin += BLOCK_TICKS) {
+		const size_t count = std::min(BLOCK_TICKS, nTicks - begin);
+		makeTicks(key, pathIndex, begin, std::span<const double>(prices).subspan(begin, count), ticks.data() + begin);
+	}
+	return ticks;
+}
+
+/**
+ * @brief Generates one mid-price path and builds bid/ask around it
+ */
+std::vector<QuoteTick> BatchGBMGenerator::generateQuotes(uint64_t pathIndex) const {
+	const Philox4x32::Key key = Philox4x32::keyFromSeed(seed);
+	std::vector<double> prices(nTicks);
+	generatePath(pathIndex, prices);
+
+	std::vector<QuoteTick> quotes(nTicks);
+	for (size_t begin = 0; begin < nTicks; begin += BLOCK_TICKS) {
+		const size_t count = std::min(BLOCK_TICKS, nTicks - begin);
+		makeQuotes(key, pathIndex, begin, std::span<const double>(prices).subspan(begin, count), spreadMu, spreadSigma, quotes.data() + begin);
+	}
+	return quotes;
+}
+
+/**
+ * @brief Wraps a PathWalker in a tick source that builds trade ticks block by block
+ */
+std::unique_ptr<TickSource<Tick>> BatchGBMGenerator::streamTicks(uint64_t pathIndex) const {
+	const Philox4x32::Key key = Philox4x32::keyFromSeed(seed);
+	auto makeBlock = [key, pathIndex](size_t begin, std::span<const double> prices, Tick* out) {
+		makeTicks(key, pathIndex, begin, prices, out);
+	};
+	PathWalker walker(key, pathIndex, tf, startPrice, mu, impVol, jumpLambda, jumpMu, jumpSigma);
+	return std::make_unique<PathTickSource<Tick, decltype(makeBlock)>>(walker, nTicks, makeBlock);
+}
+
+/**
+ * @brief Wraps a PathWalker in a tick source that builds quote ticks block by block
+ */
+std::unique_ptr<TickSource<QuoteTick>> BatchGBMGenerator::streamQuotes(uint64_t pathIndex) const {
+	const Philox4x32::Key key = Philox4x32::keyFromSeed(seed);
+	auto makeBlock = [key, pathIndex, spreadMu = spreadMu, spreadSigma = spreadSigma](size_t begin, std::span<const double> prices, QuoteTick* out) {
+		makeQuotes(key, pathIndex, begin, prices, spreadMu, spreadSigma, out);
+	};
+	PathWalker walker(key, pathIndex, tf, startPrice, mu, impVol, jumpLambda, jumpMu, jumpSigma);
+	return std::make_unique<PathTickSource<QuoteTick, decltype(makeBlock)>>(walker, nTicks, makeBlock);
+}
+
+/**
+ * @brief Generates paths in parallel straight into one contiguous buffer
+ */
+std::vector<double> BatchGBMGenerator::generatePaths(uint64_t firstPath, size_t nPaths) const {
+	std::vector<double> prices(nPaths * nTicks);
+	parallelFor(threadCount, nPaths, [&](size_t, size_t offset) {
+		generatePath(firstPath + offset, std::span<double>(prices.data() + offset * nTicks, nTicks));
+	});
+	return prices;
+}
+
+/**
+ * @brief Generates paths in parallel, each worker reusing its own path buffer
+ */
+void BatchGBMGenerator::forEachPath(uint64_t firstPath, size_t nPaths,
+	const std::function<void(uint64_t pathIndex, std::span<const double> prices)>& onPath) const {
+	const size_t workerCount = threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+	std::vector<std::vector<double>> buffers(std::min(workerCount, nPaths));
+
+	parallelFor(threadCount, nPaths, [&](size_t worker, size_t offset) {
+		std::vector<double>& prices = buffers[worker];
+		prices.resize(nTicks);  // Allocated on the worker's first path
+		generatePath(firstPath + offset, prices);
+		onPath(firstPath + offset, prices);
+	});
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "Tick.h"
+#include "TickSource.h"
+#include "TimeFrame.h"
+
+/**
+ * @brief Generates many independent, reproducible GBM + Jump price paths
+ *
+ * Same model as GBMJumpGenerator (log-normal diffusion plus Bernoulli(jumpLambda)
+ * jumps of size N(jumpMu, jumpSigma) per tick), built for Monte Carlo runs
+ * of thousands to millions of paths:
+ * - Random numbers come from Philox4x32 keyed by the seed, with the path index
+ *   and tick index as the counter. A path is a pure function of (seed, pathIndex),
+ *   whatever the number of threads or the order in which paths are generated.
+ * - Ticks are produced in blocks: one loop draws the block's normals, one adds
+ *   drift/diffusion, one accumulates the log-price and one calls exp() - simple
+ *   independent loops the compiler can vectorize, and a single exp() per tick.
+ *   sqrt(dt) and the Ito-corrected drift are computed once per path.
+ * - Jumps are sampled by Poisson thinning: instead of drawing a uniform on
+ *   every tick, the gap to the next jump is drawn from the geometric
+ *   distribution, so the cost is proportional to the number of jumps.
+ * - generatePaths() / forEachPath() spread the paths over worker threads.
+ *
+ * Draws of different quantities (diffusion, volume, spread, jumps) use separate
+ * streams, so e.g. generating quotes instead of trades gives the same mid-price path.
+ *
+ * A path has at most 2^33 ticks (the per-stream counter is 32 bits, 2 draws per counter).
+ */
+class BatchGBMGenerator {
+private:
+	size_t nTicks;                 // Number of ticks per path
+	TimeFrame tf;                  // Time frame for calculating time step
+	uint64_t seed;                 // Key of every random stream
+	double startPrice;             // Starting price of every path
+	double mu;                     // Drift rate / expected annual return
+	double impVol;                 // Implied (annual) volatility
+	double jumpLambda;             // Probability of a jump on each tick
+	double jumpMu;                 // Mean of jump size (log-price)
+	double jumpSigma;              // Standard deviation of jump size
+	double spreadMu;               // Mean bid/ask spread (quotes only)
+	double spreadSigma;            // Standard deviation of the spread (quotes only)
+	size_t threadCount = 0;        // Number of workers for multi-path generation (0 = one per hardware thread)
+
+public:
+	/**
+	 * @brief Constructs a batch generator
+	 *
+	 * Parameters and defaults are the same as GBMJumpGenerator / QuoteGBMJumpGenerator.
+	 *
+	 * @param nTicks Number of ticks per path
+	 * @param tf Time frame for calculating time step
+	 * @param seed Seed - the same seed always gives the same paths
+	 * @param startPrice Starting price (default: 100.0)
+	 * @param mu Drift rate (default: 0.03 = 3% annual)
+	 * @param impVol Implied volatility (default: 0.2 = 20% annual)
+	 * @param jumpLambda Probability of a jump per tick (default: 0.01 = 1%)
+	 * @param jumpMu Mean jump size (default: -0.01 = -1%)
+	 * @param jumpSigma Standard deviation of jump size (default: 0.03 = 3%)
+	 * @param spreadMu Mean spread, used by generateQuotes() (default: 0.01)
+	 * @param spreadSigma Standard deviation of spread, used by generateQuotes() (default: 0.002)
+	 */
+	BatchGBMGenerator(size_t nTicks,
+		TimeFrame tf,
+		uint64_t seed,
+		double startPrice = 100.0,
+		double mu = 0.03,
+		double impVol = 0.2,
+		double jumpLambda = 0.01,
+		double jumpMu = -0.01,
+		double jumpSigma = 0.03,
+		double spreadMu = 0.01,
+		double spreadSigma = 0.002);
+
+	/**
+	 * @brief Sets how many worker threads generatePaths() and forEachPath() use
+	 *
+	 * @param count Number of workers (0 = std::thread::hardware_concurrency())
+	 */
+	void setThreadCount(size_t count);
+
+	/**
+	 * @brief Returns the number of ticks per path
+	 */
+	size_t getTickCount() const { return nTicks; }
+
+	/**
+	 * @brief Writes the prices of one path
+	 *
+	 * Writes the first prices.size() ticks of the path (usually nTicks). A
+	 * shorter span gives a prefix of the same path.
+	 *
+	 * @param pathIndex Index of the path
+	 * @param prices Output buffer, one price per tick
+	 */
+	void generatePath(uint64_t pathIndex, std::span<double> prices) const;
+
+	/**
+	 * @brief Generates one path as trade ticks (price + volume)
+	 *
+	 * @param pathIndex Index of the path (default: 0)
+	 * @return nTicks ticks, timestamps are the tick index
+	 */
+	std::vector<Tick> generateTicks(uint64_t pathIndex = 0) const;
+
+	/**
+	 * @brief Generates one path as quote ticks around the mid-price
+	 *
+	 * The mid-price is the same path as generateTicks(pathIndex); the spread is
+	 * N(spreadMu, spreadSigma) truncated to a minimum of 0.001.
+	 *
+	 * @param pathIndex Index of the path (default: 0)
+	 * @return nTicks quote ticks, timestamps are the tick index
+	 */
+	std::vector<QuoteTick> generateQuotes(uint64_t pathIndex = 0) const;
+
+	/**
+	 * @brief Streams one path as trade ticks, generated as they are read
+	 *
+	 * Same ticks as generateTicks(pathIndex), but only one block of ticks is
+	 * held in memory at a time, so paths of any length (up to 2^33 ticks) can
+	 * be replayed with BacktestEngine::setTickStream().
+	 *
+	 * @param pathIndex Index of the path (default: 0)
+	 * @return Source of nTicks ticks (independent of the generator, which can be destroyed)
+	 */
+	std::unique_ptr<TickSource<Tick>> streamTicks(uint64_t pathIndex = 0) const;
+
+	/**
+	 * @brief Streams one path as quote ticks, generated as they are read
+	 *
+	 * Same quotes as generateQuotes(pathIndex), one block in memory at a time.
+	 *
+	 * @param pathIndex Index of the path (default: 0)
+	 * @return Source of nTicks quote ticks
+	 */
+	std::unique_ptr<TickSource<QuoteTick>> streamQuotes(uint64_t pathIndex = 0) const;
+
+	/**
+	 * @brief Generates several paths in parallel
+	 *
+	 * @param firstPath Index of the first path
+	 * @param nPaths Number of paths
+	 * @return nPaths * nTicks prices, path after path (path p starts at (p - firstPath) * nTicks)
+	 */
+	std::vector<double> generatePaths(uint64_t firstPath, size_t nPaths) const;
+
+	/**
+	 * @brief Generates paths in parallel and hands each one to a callback
+	 *
+	 * Memory stays at one path buffer per worker however many paths are
+	 * generated, which is what Monte Carlo runs over millions of paths need.
+	 * The callback is called concurrently from several threads (never twice at
+	 * once for the same path), and the span is only valid during the call.
+	 * If a callback throws, the remaining paths are abandoned and the first
+	 * exception is rethrown once all workers have stopped.
+	 *
+	 * @param firstPath Index of the first path
+	 * @param nPaths Number of paths
+	 * @param onPath Called with (pathIndex, prices) for every path
+	 */
+	void forEachPath(uint64_t firstPath, size_t nPaths,
+		const std::function<void(uint64_t pathIndex, std::span<const double> prices)>& onPath) const;
+};
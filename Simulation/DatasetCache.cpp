@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <unistd.h>
+
+#include "DatasetCache.h"
+#include "BatchGBMGenerator.h"
+
+namespace {
+
+/**
+ * @brief Incremental FNV-1a over 64-bit words
+ */
+class Fnv1a {
+private:
+	uint64_t state = 14695981039346656037ull;
+
+public:
+	void add(uint64_t word) {
+		for (int i = 0; i < 8; i++) {
+			state ^= (word >> (8 * i)) & 0xFF;
+			state *= 1099511628211ull;
+		}
+	}
+
+	// +0.0 turns -0.0 into 0.0, so keys that compare equal hash equal
+	void add(double value) { add(std::bit_cast<uint64_t>(value + 0.0)); }
+
+	uint64_t value() const { return state; }
+};
+
+/**
+ * @brief Generates one dataset of the key
+ */
+template<typename T> std::vector<T> generate(const DatasetKey& key);
+
+template<> std::vector<Tick> generate<Tick>(const DatasetKey& key) {
+	return BatchGBMGenerator(key.nTicks, key.tf, key.seed, key.startPrice, key.mu, key.impVol,
+		key.jumpLambda, key.jumpMu, key.jumpSigma).generateTicks();
+}
+
+template<> std::vector<QuoteTick> generate<QuoteTick>(const DatasetKey& key) {
+	return BatchGBMGenerator(key.nTicks, key.tf, key.seed, key.startPrice, key.mu, key.impVol,
+		key.jumpLambda, key.jumpMu, key.jumpSigma, key.spreadMu, key.spreadSigma).generateQuotes();
+}
+
+template<typename T> constexpr TickRecordType recordTypeOf();
+template<> constexpr TickRecordType recordTypeOf<Tick>() { return TickRecordType::TRADE; }
+template<> constexpr TickRecordType recordTypeOf<QuoteTick>() { return TickRecordType::QUOTE; }
+
+} // namespace
+
+uint64_t DatasetKey::hash() const {
+	Fnv1a h;
+	h.add(uint64_t(DATASET_CACHE_VERSION));
+	h.add(uint64_t(nTicks));
+	h.add(uint64_t(tf));
+	h.add(seed);
+	h.add(startPrice);
+	h.add(mu);
+	h.add(impVol);
+	h.add(jumpLambda);
+	h.add(jumpMu);
+	h.add(jumpSigma);
+	h.add(spreadMu);
+	h.add(spreadSigma);
+	return h.value();
+}
+
+DatasetCache::DatasetCache(size_t maxEntries, std::string directory)
+	: maxEntries(std::max<size_t>(maxEntries, 1)), directory(std::move(directory)) {
+	if (!this->directory.empty()) {
+		std::error_code error;
+		std::filesystem::create_directories(this->directory, error);
+		if (error) throw std::runtime_error("Cannot create dataset cache directory '" + this->directory + "': " + error.message());
+	}
+}
+
+std::shared_ptr<const std::vector<Tick>> DatasetCache::ticks(const DatasetKey& key, DatasetOrigin* origin) {
+	return get(tickEntries, key, origin);
+}
+
+std::shared_ptr<const std::vector<QuoteTick>> DatasetCache::quotes(const DatasetKey& key, DatasetOrigin* origin) {
+	return get(quoteEntries, key, origin);
+}
+
+std::string DatasetCache::filePath(const DatasetKey& key, TickRecordType type) const {
+	if (directory.empty()) return "";
+
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.%s", static_cast<unsigned long long>(key.hash()),
+		type == TickRecordType::TRADE ? "ticks" : "quotes");
+	return (std::filesystem::path(directory) / name).string();
+}
+
+void DatasetCache::clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+	tickEntries.clear();
+	quoteEntries.clear();
+}
+
+/**
+ * @brief Returns the resident dataset of the key, loading it at most once
+ *
+ * The first caller of a key inserts a pending entry and loads the data outside
+ * the lock; callers arriving meanwhile wait on the same shared_future. A failed
+ * load is removed again, so the next caller retries.
+ */
+template<typename T>
+std::shared_ptr<const std::vector<T>> DatasetCache::get(std::vector<Entry<T>>& entries, const DatasetKey& key, DatasetOrigin* origin) {
+	std::promise<std::shared_ptr<const std::vector<T>>> promise;
+	std::shared_future<std::shared_ptr<const std::vector<T>>> future;
+	bool owner = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		clock++;
+		auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry<T>& entry) { return entry.key == key; });
+		if (it != entries.end()) {
+			it->lastUsed = clock;
+			future = it->data;
+		} else {
+			if (entries.size() >= maxEntries) {
+				entries.erase(std::min_element(entries.begin(), entries.end(),
+					[](const Entry<T>& a, const Entry<T>& b) { return a.lastUsed < b.lastUsed; }));
+			}
+			future = promise.get_future().share();
+			entries.push_back(Entry<T>{ key, future, clock });
+			owner = true;
+		}
+	}
+
+	DatasetOrigin from = DatasetOrigin::MEMORY;
+	if (owner) {
+		try {
+			promise.set_value(load<T>(key, from));
+		} catch (...) {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				std::erase_if(entries, [&](const Entry<T>& entry) { return entry.key == key; });
+			}
+			promise.set_exception(std::current_exception());
+		}
+	}
+	if (origin) *origin = from;
+	return future.get();
+}
+
+/**
+ * @brief Reads a dataset from the cache directory, or generates (and stores) it
+ *
+ * The disk is only an accelerator: a file that is missing, unreadable or
+ * doesn't hold the expected ticks is regenerated, and a file that can't be
+ * written is skipped - the data is returned either way.
+ */
+template<typename T>
+std::shared_ptr<const std::vector<T>> DatasetCache::load(const DatasetKey& key, DatasetOrigin& origin) const {
+	const std::string path = filePath(key, recordTypeOf<T>());
+
+	if (!path.empty() && std::filesystem::exists(path)) {
+		try {
+			MappedTickFile<T> file(path);
+			if (file.size() == key.nTicks) {
+				origin = DatasetOrigin::DISK;
+				return std::make_shared<const std::vector<T>>(file.ticks().begin(), file.ticks().end());
+			}
+		} catch (const std::runtime_error&) {
+			// Corrupt or from an incompatible build - overwritten below
+		}
+	}
+
+	auto data = std::make_shared<const std::vector<T>>(generate<T>(key));
+	origin = DatasetOrigin::GENERATED;
+
+	if (!path.empty()) {
+		// Unique temporary name per process and thread, then an atomic rename into place
+		const std::string temporary = path + ".tmp." + std::to_string(::getpid()) + "."
+			+ std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+		try {
+			writeTickFile(temporary, std::span<const T>(*data));
+			std::filesystem::rename(temporary, path);
+		} catch (const std::exception&) {
+			std::error_code ignored;
+			std::filesystem::remove(temporary, ignored);
+		}
+	}
+	return data;
+}
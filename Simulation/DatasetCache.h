@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Tick.h"
+#include "TickFile.h"
+#include "TimeFrame.h"
+
+/**
+ * @brief Everything that determines a generated dataset
+ *
+ * Two keys that compare equal always describe the same ticks: the data is a
+ * pure function of these fields (see BatchGBMGenerator). Defaults are the
+ * generator defaults.
+ */
+struct DatasetKey {
+	size_t nTicks;                 // Number of ticks
+	TimeFrame tf;                  // Time frame for calculating time step
+	uint64_t seed;                 // Generator seed
+	double startPrice = 100.0;     // Starting (mid-)price
+	double mu = 0.03;              // Drift rate / expected annual return
+	double impVol = 0.2;           // Implied (annual) volatility
+	double jumpLambda = 0.01;      // Probability of a jump per tick
+	double jumpMu = -0.01;         // Mean jump size
+	double jumpSigma = 0.03;       // Standard deviation of jump size
+	double spreadMu = 0.01;        // Mean bid/ask spread (quotes only)
+	double spreadSigma = 0.002;    // Standard deviation of the spread (quotes only)
+
+	bool operator==(const DatasetKey&) const = default;
+
+	/**
+	 * @brief Returns a 64-bit FNV-1a hash of the key
+	 *
+	 * Stable across runs and builds (it hashes the values, not the memory
+	 * layout), so it can name files. DATASET_CACHE_VERSION is mixed in, so
+	 * changing the generator invalidates every file written before.
+	 */
+	uint64_t hash() const;
+};
+
+/**
+ * @brief Where DatasetCache found a dataset
+ */
+enum class DatasetOrigin {
+	MEMORY,    // Already resident (or being generated for another caller)
+	DISK,      // Loaded from the cache directory
+	GENERATED  // Generated by this call
+};
+
+// Bump whenever BatchGBMGenerator output changes for the same parameters
+constexpr uint32_t DATASET_CACHE_VERSION = 1;
+
+/**
+ * @brief Content-addressed cache of generated market data
+ *
+ * Datasets are looked up by DatasetKey in two levels:
+ * - Memory: the last maxEntries datasets of each kind (trades, quotes) stay
+ *   resident, shared read-only by every caller. The least recently used one
+ *   is dropped first; callers still holding it keep their reference.
+ * - Disk (optional): each dataset is stored as a binary tick file named after
+ *   the key hash (<hash>.ticks / <hash>.quotes), so other runs and other
+ *   processes skip the generation too. Files are written to a temporary name
+ *   and renamed, so a reader never sees a partial file. The disk only speeds
+ *   things up: an unreadable file is regenerated, an unwritable one skipped.
+ *
+ * A dataset is generated at most once however many threads ask for it at the
+ * same time: the first caller generates it outside the lock, the others wait
+ * for it.
+ *
+ * Thread-safe.
+ */
+class DatasetCache {
+private:
+	/**
+	 * @brief Resident dataset, or the load in progress for it
+	 */
+	template<typename T>
+	struct Entry {
+		DatasetKey key;
+		std::shared_future<std::shared_ptr<const std::vector<T>>> data;  // Shared by every caller waiting for the same key
+		uint64_t lastUsed;                                                // Value of clock at the last lookup
+	};
+
+	size_t maxEntries;             // Resident datasets of each kind
+	std::string directory;         // Cache directory ("" = memory only)
+
+	std::vector<Entry<Tick>> tickEntries;
+	std::vector<Entry<QuoteTick>> quoteEntries;
+	uint64_t clock = 0;
+	std::mutex mutex;
+
+	template<typename T>
+	std::shared_ptr<const std::vector<T>> get(std::vector<Entry<T>>& entries, const DatasetKey& key, DatasetOrigin* origin);
+
+	template<typename T>
+	std::shared_ptr<const std::vector<T>> load(const DatasetKey& key, DatasetOrigin& origin) const;
+
+public:
+	/**
+	 * @brief Creates a cache
+	 *
+	 * @param maxEntries Datasets of each kind kept in memory (at least 1)
+	 * @param directory Directory of the on-disk cache, created if missing ("" = memory only)
+	 * @throws std::runtime_error If the directory can't be created
+	 */
+	explicit DatasetCache(size_t maxEntries = 8, std::string directory = "");
+
+	DatasetCache(const DatasetCache&) = delete;
+	DatasetCache& operator=(const DatasetCache&) = delete;
+
+	/**
+	 * @brief Returns the trade ticks of a dataset, generating them on a miss
+	 *
+	 * Same ticks as BatchGBMGenerator(key...).generateTicks().
+	 *
+	 * @param key Generator parameters and seed
+	 * @param origin Output (optional): where the dataset came from
+	 * @return Shared, read-only ticks (usable with BacktestEngine::setTickData())
+	 */
+	std::shared_ptr<const std::vector<Tick>> ticks(const DatasetKey& key, DatasetOrigin* origin = nullptr);
+
+	/**
+	 * @brief Returns the quote ticks of a dataset, generating them on a miss
+	 *
+	 * Same quotes as BatchGBMGenerator(key...).generateQuotes(); the mid-price
+	 * is the same path as ticks(key).
+	 *
+	 * @param key Generator parameters and seed
+	 * @param origin Output (optional): where the dataset came from
+	 * @return Shared, read-only quote ticks
+	 */
+	std::shared_ptr<const std::vector<QuoteTick>> quotes(const DatasetKey& key, DatasetOrigin* origin = nullptr);
+
+	/**
+	 * @brief Returns the file a dataset is stored in ("" for a memory-only cache)
+	 *
+	 * @param key Generator parameters and seed
+	 * @param type TRADE for ticks(), QUOTE for quotes()
+	 */
+	std::string filePath(const DatasetKey& key, TickRecordType type) const;
+
+	/**
+	 * @brief Drops every resident dataset (files on disk are kept)
+	 */
+	void clear();
+};
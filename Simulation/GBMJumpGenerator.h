@@ -1,6 +1,7 @@
 #pragma once
 
-#include <random>
+#include <cstdint>
+#include <vector>
 
 #include "Tick.h"
 #include "TimeFrame.h"
@@ -29,10 +30,14 @@
  * - sigma: Volatility
  * - dW: Random Wiener process (Brownian motion)
  * - jumpFactor: Random jump multiplier (1.0 if no jump, exp(jump) if jump occurs)
+ * 
+ * Ticks are generated by BatchGBMGenerator (path 0 of the seed). The seed is
+ * random unless set with setSeed(); use BatchGBMGenerator directly for
+ * multi-path generation.
  */
 class GBMJumpGenerator {
 private:
-	std::mt19937 rng;              // Random number generator (Mersenne Twister)
+	uint64_t seed;                 // Seed of the path (drawn from a random device unless set)
 
 	size_t nTicks;                 // Number of ticks to generate
 	TimeFrame tf;                  // Time frame for calculating time step
@@ -65,19 +70,35 @@ public:
 		double jumpMu = -0.01,
 		double jumpSigma = 0.03);
 
+	/**
+	 * @brief Sets the seed, making generateTicks() reproducible
+	 * 
+	 * The same seed and parameters always give the same ticks, also the same
+	 * ticks as BatchGBMGenerator path 0 or a DatasetCache entry of that seed.
+	 * 
+	 * @param seed Seed of the path
+	 */
+	void setSeed(uint64_t seed) { this->seed = seed; }
+
+	/**
+	 * @brief Returns the seed (the random one if setSeed() wasn't called), to repeat a run
+	 */
+	uint64_t getSeed() const { return seed; }
+
 	/**
 	 * @brief Generates a vector of synthetic ticks
 	 * 
 	 * For each tick:
 	 * 1. Generates a random normal variable Z (standard normal distribution)
 	 * 2. Calculates price change using GBM formula: dS = (mu - 0.5*sigma^2)*dt + sigma*Z*sqrt(dt)
-	 * 3. Randomly decides if a jump occurs (based on jumpLambda probability)
-	 * 4. If jump occurs, applies jump factor: exp(jump) where jump ~ N(jumpMu, jumpSigma)
-	 * 5. Updates price: newPrice = oldPrice * exp(dS) * jumpFactor
-	 * 6. Generates random volume
-	 * 7. Creates Tick with timestamp, price, and volume
+	 * 3. Adds a jump ~ N(jumpMu, jumpSigma) with probability jumpLambda
+	 * 4. Updates price: newPrice = oldPrice * exp(dS + jump)
+	 * 5. Generates random volume
+	 * 6. Creates Tick with timestamp, price, and volume
+	 * 
+	 * See BatchGBMGenerator::generatePath() for how this is computed in blocks.
 	 * 
 	 * @return Vector of generated ticks
 	 */
 	std::vector<Tick> generateTicks();
-};
\ No newline at end of file
+};
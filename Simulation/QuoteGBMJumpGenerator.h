@@ -1,6 +1,6 @@
 #pragma once
 
-#include <random>
+#include <cstdint>
 #include <vector>
 #include "TimeFrame.h"
 #include "Tick.h"
@@ -25,10 +25,15 @@
  * - Spread ~ N(spreadMu, spreadSigma), truncated to minimum 0.001
  * - Bid = mid - spread/2
  * - Ask = mid + spread/2
+ * 
+ * Quotes are generated by BatchGBMGenerator (path 0 of the seed), which
+ * shares the mid-price model with GBMJumpGenerator: with the same seed, the
+ * mid-prices are the trade prices of GBMJumpGenerator. The seed is random
+ * unless set with setSeed().
  */
 class QuoteGBMJumpGenerator {
 private:
-    std::mt19937 rng;              // Random number generator
+    uint64_t seed;                 // Seed of the path (drawn from a random device unless set)
 
     size_t nTicks;                 // Number of ticks to generate
     TimeFrame tf;                  // Time frame for calculating time step
@@ -68,6 +73,18 @@ public:
         double spreadMu = 0.01,
         double spreadSigma = 0.002);
 
+    /**
+     * @brief Sets the seed, making generateTicks() reproducible
+     * 
+     * @param seed Seed of the path
+     */
+    void setSeed(uint64_t seed) { this->seed = seed; }
+
+    /**
+     * @brief Returns the seed (the random one if setSeed() wasn't called), to repeat a run
+     */
+    uint64_t getSeed() const { return seed; }
+
     /**
      * @brief Generates a vector of synthetic quote ticks
      * 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 /**
  * @brief Enumeration of available time frames for bar aggregation
  * 
@@ -37,4 +39,22 @@ inline double getTicksPerDay(TimeFrame tf) {
         case TimeFrame::DAY: return 1.0;            // 1 day per day
         default: return 1.0;
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Returns the length of one bar of a time frame in milliseconds
+ * 
+ * Used as the window size of bar aggregation (bar timestamps are in milliseconds).
+ * 
+ * @param tf The time frame
+ * @return Bar length in milliseconds (MINUTE = 60000, FIVEMINTUES = 300000, ...)
+ */
+inline uint64_t getBarMillis(TimeFrame tf) {
+    switch (tf) {
+        case TimeFrame::MINUTE: return 60'000;
+        case TimeFrame::FIVEMINTUES: return 300'000;
+        case TimeFrame::HOUR: return 3'600'000;
+        case TimeFrame::DAY: return 86'400'000;
+        default: return 60'000;
+    }
+}
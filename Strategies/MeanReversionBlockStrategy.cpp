@@ -0,0 +1,51 @@
+#include "MeanReversionBlockStrategy.h"
+
+bool MeanReversionBlock::saveState(StateWriter& out) const {
+	out.write(lastPrice);
+	out.write(inPosition);
+	out.write(entryPrice);
+	return true;
+}
+
+void MeanReversionBlock::restoreState(StateReader& in) {
+	in.read(lastPrice);
+	in.read(inPosition);
+	in.read(entryPrice);
+}
+
+/**
+ * @brief Walks the position through the block, from one signal to the next
+ * 
+ * The comparisons are those of MeanReversionSimple::onTick() (same
+ * thresholds, same order of operations), so both strategies place exactly
+ * the same orders. Before the first tick ever seen lastPrice is -1, and no
+ * price is below -1 * 0.995: the first tick only sets the reference price.
+ */
+void MeanReversionBlock::onTicks(std::span<const Tick> ticks, BlockOrders& orders) {
+	const size_t count = ticks.size();
+	if (count == 0) return;
+
+	double previous = lastPrice;
+	for (size_t i = 0; i < count; i++) {
+		if (!inPosition) {
+			// Flat: look for the next drop of 0.5% from the previous tick
+			for (; i < count && !(ticks[i].price < previous * 0.995); i++) previous = ticks[i].price;
+			if (i == count) break;
+
+			orders.submit(i, Order{ Order::Side::BUY, OrderType::MARKET, ticks[i].timestamp, 1.0, ticks[i].price });
+			entryPrice = ticks[i].price;
+			inPosition = true;
+		} else {
+			// In position: look for the exit level
+			const double exitLevel = entryPrice * 1.005;
+			for (; i < count && !(ticks[i].price > exitLevel); i++) {}
+			if (i == count) break;
+
+			orders.submit(i, Order{ Order::Side::SELL, OrderType::MARKET, ticks[i].timestamp, 1.0, ticks[i].price });
+			inPosition = false;
+		}
+		previous = ticks[i].price;
+	}
+
+	lastPrice = ticks[count - 1].price;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <span>
+
+#include "BlockStrategy.h"
+
+/**
+ * @brief MeanReversionSimple taking its ticks a block at a time
+ * 
+ * Same rules, orders and results as MeanReversionSimple:
+ * - BUY when price drops 0.5% from the previous tick (if not in position)
+ * - SELL when price rises 0.5% from the entry price (if in position)
+ * 
+ * Instead of testing both rules on every tick, each block is walked from one
+ * signal to the next: while flat, a tight loop looks for the next drop;
+ * while in position, another one compares prices against the exit level.
+ * A reference implementation of BlockStrategy more than a faster one - the
+ * engine's matching and PnL recording dominate the cost of such a cheap rule.
+ */
+class MeanReversionBlock : public BlockStrategy {
+private:
+	double lastPrice = -1.0;   // Price of the last tick seen (-1 = no tick seen yet)
+	bool inPosition = false;   // Whether we currently hold a position
+	double entryPrice = 0.0;   // Price at which we entered the current position
+
+public:
+	/**
+	 * @brief Saves the last price and the open position (see Strategy::saveState())
+	 */
+	bool saveState(StateWriter& out) const override;
+
+	/**
+	 * @brief Restores the state saved by saveState()
+	 */
+	void restoreState(StateReader& in) override;
+
+	/**
+	 * @brief Main strategy logic - called for each block of ticks
+	 * 
+	 * @param ticks Block of trade ticks, in time order
+	 * @param orders Orders of the block, staged at the tick that triggered them
+	 */
+	void onTicks(std::span<const Tick> ticks, BlockOrders& orders) override;
+};
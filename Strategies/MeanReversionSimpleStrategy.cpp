@@ -7,6 +7,19 @@ void MeanReversionSimple::setOrderManager(OrderManager* om) {
 	orderManager = om;
 }
 
+bool MeanReversionSimple::saveState(StateWriter& out) const {
+	out.write(lastPrice);
+	out.write(inPosition);
+	out.write(entryPrice);
+	return true;
+}
+
+void MeanReversionSimple::restoreState(StateReader& in) {
+	in.read(lastPrice);
+	in.read(inPosition);
+	in.read(entryPrice);
+}
+
 /**
  * @brief Main strategy logic - implements mean reversion trading
  * 
@@ -43,6 +43,16 @@ public:
 	 */
 	void setOrderManager(OrderManager* om) override;
 
+	/**
+	 * @brief Saves the last price and the open position (see Strategy::saveState())
+	 */
+	bool saveState(StateWriter& out) const override;
+
+	/**
+	 * @brief Restores the state saved by saveState()
+	 */
+	void restoreState(StateReader& in) override;
+
 	/**
 	 * @brief Main strategy logic - called for each market tick
 	 * 
@@ -0,0 +1,83 @@
+#include "RollingBreakoutStrategy.h"
+
+/**
+ * @brief Constructs the strategy and sizes the rolling high/low windows
+ */
+RollingBreakoutStrategy::RollingBreakoutStrategy(size_t window, OrderManager* om)
+	: orderManager(om), windowHigh(window), windowLow(window) {
+}
+
+/**
+ * @brief Sets the OrderManager for submitting orders
+ */
+void RollingBreakoutStrategy::setOrderManager(OrderManager* om) {
+	orderManager = om;
+}
+
+bool RollingBreakoutStrategy::saveState(StateWriter& out) const {
+	windowHigh.save(out);
+	windowLow.save(out);
+	out.write(inPosition);
+	out.write(entryPrice);
+	return true;
+}
+
+void RollingBreakoutStrategy::restoreState(StateReader& in) {
+	windowHigh.restore(in);
+	windowLow.restore(in);
+	in.read(inPosition);
+	in.read(entryPrice);
+}
+
+/**
+ * @brief Main strategy logic - implements breakout trading
+ * 
+ * The breakout levels are the high and low of the previous `window` ticks
+ * (the current tick is added to the window only after the decision).
+ */
+void RollingBreakoutStrategy::onTick(const Tick& tick) {
+	// Only trade if we have enough historical data (window is full)
+	if (windowHigh.full()) {
+		// Highest and lowest prices in the rolling window - O(1)
+		double high = windowHigh.value();
+		double low = windowLow.value();
+
+		// BUY SIGNAL: Price breaks above the window high (upward breakout)
+		// Only buy if we're not already in a position
+		if (!inPosition && tick.price > high) {
+			// Create a MARKET buy order for 1 share at current price
+			Order buy = { 
+				Order::Side::BUY,      // Buy side
+				OrderType::MARKET,      // Market order (executes immediately)
+				tick.timestamp,         // Current timestamp
+				1.0,                    // Volume: 1 share
+				tick.price              // Price (for MARKET orders, this is the execution price)
+			};
+			orderManager->submit(buy);
+			
+			// Record entry price and mark that we're in a position
+			entryPrice = tick.price;
+			inPosition = true;
+		}
+		// SELL SIGNAL: Price breaks below the window low (downward breakout)
+		// Only sell if we're in a position
+		else if (inPosition && tick.price < low) {
+			// Create a MARKET sell order for 1 share at current price
+			Order sell = { 
+				Order::Side::SELL,     // Sell side
+				OrderType::MARKET,      // Market order (executes immediately)
+				tick.timestamp,         // Current timestamp
+				1.0,                    // Volume: 1 share
+				tick.price              // Price (for MARKET orders, this is the execution price)
+			};
+			orderManager->submit(sell);
+			
+			// Mark that we're no longer in a position
+			inPosition = false;
+		}
+	}
+
+	// Update the rolling window: the oldest price drops out automatically once it is full
+	windowHigh.push(tick.price);
+	windowLow.push(tick.price);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Strategy.h"
+#include "OrderManager.h"
+#include "RollingExtremum.h"
+
+/**
+ * @brief Breakout trading strategy with a window size chosen at runtime
+ * 
+ * Same logic as BreakoutStrategy:
+ * - BUY when price breaks above the highest price of the last `window` ticks (upward breakout)
+ * - SELL when price breaks below the lowest price of the last `window` ticks (downward breakout)
+ * 
+ * The high and low of the window are tracked with RollingMax/RollingMin
+ * (monotonic deques on fixed ring buffers), so each tick costs amortized O(1)
+ * no matter how large the window is - a 1000-tick window costs the same per
+ * tick as a 20-tick window, and nothing is allocated after construction.
+ * 
+ * Because the window is a constructor argument, parameter sweeps over the
+ * window don't need one template instantiation per window size.
+ */
+class RollingBreakoutStrategy : public Strategy {
+private:
+	OrderManager* orderManager;  // Pointer to OrderManager for submitting orders
+	RollingMax windowHigh;       // Highest price of the last `window` ticks
+	RollingMin windowLow;        // Lowest price of the last `window` ticks
+	bool inPosition = false;     // Whether we currently hold a position
+	double entryPrice = 0.0;     // Price at which we entered the current position
+	
+public:
+	/**
+	 * @brief Constructs the strategy with the given rolling window
+	 * 
+	 * @param window Number of past ticks the breakout levels are computed over (default: 20)
+	 * @param om OrderManager pointer (can be set later via setOrderManager)
+	 */
+	RollingBreakoutStrategy(size_t window = 20, OrderManager* om = nullptr);
+
+	/**
+	 * @brief Sets the OrderManager for this strategy
+	 * 
+	 * Called by BacktestEngine before backtesting starts.
+	 */
+	void setOrderManager(OrderManager* om) override;
+
+	/**
+	 * @brief Saves the price window and the open position (see Strategy::saveState())
+	 */
+	bool saveState(StateWriter& out) const override;
+
+	/**
+	 * @brief Restores the state saved by saveState()
+	 */
+	void restoreState(StateReader& in) override;
+
+	/**
+	 * @brief Main strategy logic - called for each market tick
+	 * 
+	 * Implements breakout detection:
+	 * 1. When the window is full, reads its high and low in O(1)
+	 * 2. BUY signal: Price breaks above window high (upward momentum)
+	 * 3. SELL signal: Price breaks below window low (downward momentum)
+	 * 4. Adds the current price to the window
+	 * 
+	 * @param tick Current market tick
+	 */
+	void onTick(const Tick& tick) override;
+};
@@ -7,19 +7,82 @@ void SpreadStrategy::setOrderManager(OrderManager* om) {
 	orderManager = om;
 }
 
+/**
+ * @brief Saves the IDs of the resting quotes (the orders themselves are in the OrderManager)
+ */
+bool SpreadStrategy::saveState(StateWriter& out) const {
+	out.write(bidId);
+	out.write(askId);
+	out.write(bidPrice);
+	out.write(askPrice);
+	return true;
+}
+
+void SpreadStrategy::restoreState(StateReader& in) {
+	in.read(bidId);
+	in.read(askId);
+	in.read(bidPrice);
+	in.read(askPrice);
+}
+
+/**
+ * @brief Places the quote on one side
+ * 
+ * In requote mode replace() keeps the order's slot and ID, so requoting every
+ * tick does not allocate. If the previous quote was filled (or never existed)
+ * replace() fails and a fresh LIMIT order is submitted instead.
+ * 
+ * The tick is only matched after onTick(): a resting quote that it crosses is
+ * kept at its price, or moving it would always pull it away from the tick
+ * that fills it (and requote mode would never trade).
+ */
+void SpreadStrategy::quote(OrderId& id, double& restingPrice, Order::Side side, double price, const QuoteTick& tick) {
+	if (requoteMode && id != 0) {
+		const bool crossed = side == Order::Side::BUY ? restingPrice >= tick.ask : restingPrice <= tick.bid;
+		if (crossed && orderManager->isPending(id)) return;
+		if (orderManager->replace(id, price, orderSize)) {
+			restingPrice = price;
+			return;
+		}
+	}
+
+	Order order = Order{
+		.side = side,                   // Buy or sell side
+		.type = OrderType::LIMIT,       // LIMIT order (executes when the market crosses our price)
+		.timestamp = tick.timestamp,    // Current timestamp
+		.volume = orderSize,            // Order volume
+		.price = price                  // Limit price
+	};
+	id = orderManager->submit(order);
+	restingPrice = price;
+}
+
+/**
+ * @brief Pulls the resting quote on one side
+ * 
+ * Only requote mode tracks its quotes - in the default mode old orders are
+ * intentionally left resting.
+ */
+void SpreadStrategy::pull(OrderId& id) {
+	if (!requoteMode) return;
+
+	orderManager->cancel(id);
+	id = 0;
+}
+
 /**
  * @brief Main strategy logic - implements market making with spread trading
  * 
  * Strategy steps:
  * 1. Calculate the bid-ask spread
- * 2. Check if spread is large enough (>= minSpread)
+ * 2. Check if spread is large enough (>= minSpread), otherwise skip (and pull quotes in requote mode)
  * 3. Calculate quote prices:
  *    - Buy quote: bid - offset (trying to buy below market)
  *    - Sell quote: ask + offset (trying to sell above market)
- * 4. Place LIMIT buy order if position is not too large (< 5.0)
- * 5. Place LIMIT sell order if position is not too negative (> -5.0)
+ * 4. Quote a LIMIT buy order if position is not too large (< 5.0)
+ * 5. Quote a LIMIT sell order if position is not too negative (> -5.0)
  * 
- * The strategy continuously places LIMIT orders on both sides, hoping to:
+ * The strategy continuously quotes LIMIT orders on both sides, hoping to:
  * - Buy at a discount (below bid) and sell at a premium (above ask)
  * - Profit from the spread when orders are filled
  * 
@@ -34,38 +97,32 @@ void SpreadStrategy::onTick(const QuoteTick& tick) {
 	// Get current position to check position limits
 	double position = orderManager->getPosition();
 
-	// Only trade if spread is large enough to be profitable
-	// If spread is too small, we skip this tick
-	if (spread < minSpread) return;
+	// Only quote if spread is large enough to be profitable
+	// If spread is too small, skip this tick (pulling stale quotes in requote mode)
+	if (spread < minSpread) {
+		pull(bidId);
+		pull(askId);
+		return;
+	}
 
 	// Calculate our quote prices (where we want to place orders)
 	// We place orders slightly away from market to improve fill probability
 	double bidQuote = tick.bid - offset;  // Buy order: below bid (trying to buy cheap)
 	double askQuote = tick.ask + offset;   // Sell order: above ask (trying to sell expensive)
 
-	// Place LIMIT BUY order if we're not too long already
+	// Quote the BUY side if we're not too long already
 	// Position limit: won't buy if position >= 5.0 (avoid excessive long exposure)
 	if (position < 5.0) {
-		Order buy = Order{
-			.side = Order::Side::BUY,       // Buy side
-			.type = OrderType::LIMIT,      // LIMIT order (executes when price drops to bidQuote)
-			.timestamp = tick.timestamp,   // Current timestamp
-			.volume = orderSize,            // Order volume
-			.price = bidQuote               // Limit price (below current bid)
-		};
-		orderManager->submit(buy);
+		quote(bidId, bidPrice, Order::Side::BUY, bidQuote, tick);
+	} else {
+		pull(bidId);
 	}
 
-	// Place LIMIT SELL order if we're not too short already
+	// Quote the SELL side if we're not too short already
 	// Position limit: won't sell if position <= -5.0 (avoid excessive short exposure)
 	if (position > -5.0) {
-		Order sell = Order{
-			.side = Order::Side::SELL,     // Sell side
-			.type = OrderType::LIMIT,        // LIMIT order (executes when price rises to askQuote)
-			.timestamp = tick.timestamp,     // Current timestamp
-			.volume = orderSize,            // Order volume
-			.price = askQuote                // Limit price (above current ask)
-		};
-		orderManager->submit(sell);
+		quote(askId, askPrice, Order::Side::SELL, askQuote, tick);
+	} else {
+		pull(askId);
 	}
 }
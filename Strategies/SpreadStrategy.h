@@ -14,14 +14,26 @@
  * Strategy logic:
  * 1. Calculate the bid-ask spread
  * 2. Only trade if spread is large enough (>= minSpread)
- * 3. Place LIMIT buy order at (bid - offset) - trying to buy below market
- * 4. Place LIMIT sell order at (ask + offset) - trying to sell above market
+ * 3. Quote a LIMIT buy order at (bid - offset) - trying to buy below market
+ * 4. Quote a LIMIT sell order at (ask + offset) - trying to sell above market
  * 5. Maintain position limits to avoid excessive exposure
  * 
+ * Quoting modes:
+ * - Default: a new pair of LIMIT orders is added on every tick and old ones are
+ *   left resting until the market reaches them.
+ * - Requote (requote = true): the strategy keeps at most one resting quote per side.
+ *   On every tick the existing quote is moved to the new price with
+ *   OrderManager::replace(), unless the tick crosses it: onTick() runs before
+ *   the tick is matched, so that quote is left where it is to be filled.
+ *   Stale quotes are cancelled when the spread gets too tight or a position
+ *   limit is hit, so the book never grows with the length of the run and
+ *   steady-state quoting doesn't allocate.
+ * 
  * Parameters:
  * - orderSize: Volume for each order (default: 1.0)
  * - minSpread: Minimum spread required to trade (default: 0.01 = 1%)
  * - offset: Price offset from bid/ask (default: 0.005 = 0.5%)
+ * - requote: Keep one quote per side and move it instead of adding new ones (default: false)
  * 
  * Position limits:
  * - Won't buy if position >= 5.0 (avoid too much long exposure)
@@ -36,6 +48,33 @@ private:
 	double orderSize;            // Volume for each order
 	double minSpread;            // Minimum spread required to trade (as fraction, e.g., 0.01 = 1%)
 	double offset;               // Price offset from bid/ask (as fraction, e.g., 0.005 = 0.5%)
+	bool requoteMode;            // Move one resting quote per side instead of stacking new ones
+	OrderId bidId = 0;           // Our resting BUY quote (0 = none)
+	OrderId askId = 0;           // Our resting SELL quote (0 = none)
+	double bidPrice = 0.0;       // Limit price of bidId
+	double askPrice = 0.0;       // Limit price of askId
+
+	/**
+	 * @brief Places our quote on one side
+	 * 
+	 * In requote mode the existing quote is moved to the new price (or placed if
+	 * there is none), unless the tick crosses it. Otherwise a new LIMIT order
+	 * is always submitted.
+	 * 
+	 * @param id ID of the resting quote on this side (updated if a new order is placed)
+	 * @param restingPrice Limit price of the resting quote (updated with it)
+	 * @param side Side of the quote
+	 * @param price New limit price
+	 * @param tick Current quote tick
+	 */
+	void quote(OrderId& id, double& restingPrice, Order::Side side, double price, const QuoteTick& tick);
+
+	/**
+	 * @brief Cancels our resting quote on one side (requote mode only)
+	 * 
+	 * @param id ID of the resting quote on this side (reset to 0)
+	 */
+	void pull(OrderId& id);
 	
 public:
 	/**
@@ -44,9 +83,10 @@ public:
 	 * @param size Order volume (default: 1.0)
 	 * @param minSpread Minimum spread to trade, as fraction (default: 0.01 = 1%)
 	 * @param offset Price offset from bid/ask, as fraction (default: 0.005 = 0.5%)
+	 * @param requote Keep one quote per side and move it every tick (default: false)
 	 */
-	SpreadStrategy(double size = 1.0, double minSpread = 0.01, double offset = 0.005) 
-		: orderSize(size), minSpread(minSpread), offset(offset) {}
+	SpreadStrategy(double size = 1.0, double minSpread = 0.01, double offset = 0.005, bool requote = false) 
+		: orderSize(size), minSpread(minSpread), offset(offset), requoteMode(requote) {}
 
 	/**
 	 * @brief Sets the OrderManager for this strategy
@@ -55,6 +95,16 @@ public:
 	 */
 	void setOrderManager(OrderManager* om) override;
 
+	/**
+	 * @brief Saves the IDs of the resting quotes (see Strategy::saveState())
+	 */
+	bool saveState(StateWriter& out) const override;
+
+	/**
+	 * @brief Restores the state saved by saveState()
+	 */
+	void restoreState(StateReader& in) override;
+
 	/**
 	 * @brief Main strategy logic - called for each quote tick
 	 * 
@@ -4,17 +4,94 @@ Backtest Engine Web Interface
 Simple Flask backend providing Web API
 """
 
-from flask import Flask, render_template, request, jsonify, send_file
+from flask import Flask, Response, render_template, request, jsonify, send_file
 import subprocess
 import os
 import json
 import csv
+import socket
 from pathlib import Path
 import time
 
+from result_file import read_result_file, pnl_to_csv
+
 app = Flask(__name__, template_folder='templates', static_folder='static')
 # Results directory is in project root
 RESULTS_DIR = Path(__file__).parent.parent / "results"
+# Largest number of PnL points sent to the chart (result files also keep every tick, for downloads)
+CHART_POINTS = 2000
+# Persistent backtest server (./build/BacktestEngine --serve), used instead of docker run when it is up
+BACKTEST_SERVER = os.environ.get('BACKTEST_SERVER', '127.0.0.1:5002')
+SERVER_TIMEOUT = 600
+
+
+def run_on_server(num_ticks, initial_capital, strategies, result_dir, seed=None):
+    """
+    Runs a backtest on the persistent server
+
+    Returns (results, done) where results maps each strategy to its result
+    event, or None if no server is listening. Without a seed the server picks
+    one; done['seed'] reports it either way. The result events carry the
+    chart points, and the server writes the full-resolution result files to
+    result_dir (so it must run on the same machine).
+    """
+    host, _, port = BACKTEST_SERVER.rpartition(':')
+    try:
+        sock = socket.create_connection((host, int(port)), timeout=2)
+    except OSError:
+        return None
+
+    with sock, sock.makefile('rwb') as stream:
+        sock.settimeout(SERVER_TIMEOUT)
+        request = {
+            'id': 1,
+            'ticks': num_ticks,
+            'capital': initial_capital,
+            'strategies': strategies,
+            'max_points': CHART_POINTS,
+            'result_dir': str(result_dir),
+        }
+        if seed is not None:
+            request['seed'] = seed
+        stream.write(json.dumps(request).encode() + b'\n')
+        stream.flush()
+
+        # Events stream in as each strategy finishes
+        results = {}
+        for line in stream:
+            event = json.loads(line)
+            if event['event'] == 'error':
+                raise RuntimeError(event['error'])
+            if event['event'] == 'accepted':
+                seed = event['seed']
+            elif event['event'] == 'result':
+                results[event['strategy']] = event
+            elif event['event'] == 'done':
+                return results, dict(event, seed=seed)
+    raise RuntimeError('Backtest server closed the connection')
+
+
+def stats_to_csv(stats):
+    """Formats statistics as the engine's <strategy>_statistics.csv"""
+    lines = ['Metric,Value']
+    # NaN travels through JSON as null, written back as the engine writes it
+    lines.extend(f'{name},{"nan" if value is None else format(value, "g")}' for name, value in stats.items())
+    return '\n'.join(lines) + '\n'
+
+
+def csv_response(text, filename):
+    return Response(text, mimetype='text/csv',
+                    headers={'Content-Disposition': f'attachment; filename={filename}'})
+
+
+def new_session(strategies):
+    """Creates a session key and makes it the current session of each strategy"""
+    import hashlib
+    session_key = hashlib.md5(f"{time.time()}{strategies}".encode()).hexdigest()
+    app.strategy_sessions = getattr(app, 'strategy_sessions', {})
+    for strategy in strategies:
+        app.strategy_sessions[strategy] = session_key
+    return session_key
 
 @app.route('/')
 def index():
@@ -29,20 +106,51 @@ def run_backtest():
         num_ticks = int(data.get('num_ticks', 1000))
         initial_capital = float(data.get('initial_capital', 10000))
         strategies = data.get('strategies', ['Mean_Reversion', 'Breakout_Win20', 'Spread'])
+        # Optional: the same seed reruns on the same data (and hits the dataset cache)
+        seed = int(data['seed']) if data.get('seed') is not None else None
         
         # Ensure results directory exists
         RESULTS_DIR.mkdir(exist_ok=True)
         
-        # Create temporary directory for this backtest run
+        # Create temporary directory for this backtest run (docker and server write their result files there)
         import tempfile
-        import shutil
         temp_dir = tempfile.mkdtemp(prefix='backtest_')
         temp_results_dir = Path(temp_dir) / 'results'
         temp_results_dir.mkdir(exist_ok=True)
+        app.temp_dirs = getattr(app, 'temp_dirs', {})
+        
+        # Fast path: the persistent server keeps datasets resident and answers in milliseconds
+        start_time = time.time()
+        served = run_on_server(num_ticks, initial_capital, strategies, temp_results_dir.absolute(), seed)
+        if served is not None:
+            events, done = served
+            results = {}
+            server_results = {}
+            for strategy, event in events.items():
+                stats = dict(event['stats'])
+                pnl = event.get('pnl', {'index': [], 'pnl': []})
+                stats['FinalPnL'] = pnl['pnl'][-1] if pnl['pnl'] else initial_capital
+                results[strategy] = {'statistics': stats, 'has_pnl': bool(pnl['pnl'])}
+                server_results[strategy] = {'stats': event['stats'], 'index': pnl['index'], 'pnl': pnl['pnl']}
+            
+            # Statistics and chart points are kept in memory, the full series in the temp directory
+            session_key = new_session(strategies)
+            app.server_results = getattr(app, 'server_results', {})
+            app.server_results[session_key] = server_results
+            app.temp_dirs[session_key] = temp_dir
+            return jsonify({
+                'success': True,
+                'results': results,
+                'elapsed_time': time.time() - start_time,
+                'output': f"Served by {BACKTEST_SERVER} (seed {done['seed']:.0f}, dataset {'cached' if done['cached'] else 'generated'})",
+                'session_key': session_key
+            })
         
         # Run Docker container to execute backtest
-        # CSV files will be generated in temp_results directory, not in project results/
-        # Pass parameters via environment variables so C++ code can read them
+        # Result files will be generated in temp_results directory, not in project results/
+        # Pass parameters via environment variables so C++ code can read them.
+        # PnL comes back as binary columns (no per-tick CSV to format and parse), at full resolution
+        # for downloads and decimated for the chart
         cmd = [
             'docker', 'run', '--rm',
             '-v', f'{temp_results_dir.absolute()}:/app/temp_results',
@@ -50,9 +158,12 @@ def run_backtest():
             '-e', f'NUM_TICKS={num_ticks}',
             '-e', f'INITIAL_CAPITAL={initial_capital}',
             '-e', 'WEB_INTERFACE=1',  # Disable verbose console output
+            '-e', 'RESULT_FORMAT=binary',
+            '-e', f'RESULT_MAX_POINTS={CHART_POINTS}',
+            *(['-e', f'SEED={seed}'] if seed is not None else []),
             'backtest-engine',
             'sh', '-c',
-            './build/BacktestEngine && (mv *.csv temp_results/ 2>/dev/null || true)'
+            './build/BacktestEngine && (mv *.csv *.bin temp_results/ 2>/dev/null || true)'
         ]
         
         start_time = time.time()
@@ -70,11 +181,11 @@ def run_backtest():
                 'error': result.stderr
             }), 500
         
-        # Read results from CSV files in temp directory
+        # Read results from the files in temp directory
         results = {}
         for strategy in strategies:
             stats_file = temp_results_dir / f'{strategy}_statistics.csv'
-            pnl_file = temp_results_dir / f'{strategy}_pnl.csv'
+            pnl_file = temp_results_dir / f'{strategy}_results.bin'
             
             stats = {}
             if stats_file.exists():
@@ -86,11 +197,9 @@ def run_backtest():
             # Get final PnL from PnL file
             final_pnl = 10000.0  # Default
             if pnl_file.exists():
-                with open(pnl_file, 'r') as f:
-                    reader = csv.DictReader(f)
-                    pnl_values = [float(row['PnL']) for row in reader]
-                    if pnl_values:
-                        final_pnl = pnl_values[-1]
+                pnl_values = read_result_file(pnl_file)['columns']['pnl']
+                if pnl_values:
+                    final_pnl = pnl_values[-1]
             
             stats['FinalPnL'] = final_pnl
             results[strategy] = {
@@ -100,13 +209,8 @@ def run_backtest():
         
         # Store temp directory path for this session
         # Files will be served from temp directory, not saved to results/
-        import hashlib
-        session_key = hashlib.md5(f"{time.time()}{strategies}".encode()).hexdigest()
-        app.temp_dirs = getattr(app, 'temp_dirs', {})
+        session_key = new_session(strategies)
         app.temp_dirs[session_key] = temp_dir
-        app.strategy_sessions = getattr(app, 'strategy_sessions', {})
-        for strategy in strategies:
-            app.strategy_sessions[strategy] = session_key
         
         return jsonify({
             'success': True,
@@ -131,25 +235,22 @@ def run_backtest():
 def get_pnl_data(strategy):
     """Get P&L data for charting"""
     try:
-        # Get from temp directory (not from results/)
-        session_key = app.strategy_sessions.get(strategy)
-        if session_key and session_key in app.temp_dirs:
+        # Get from the server results in memory, or from temp directory (not from results/)
+        session_key = getattr(app, 'strategy_sessions', {}).get(strategy)
+        served = getattr(app, 'server_results', {}).get(session_key, {}).get(strategy)
+        if served is not None:
+            return jsonify({'index': served['index'], 'pnl': served['pnl']})
+        if session_key and session_key in getattr(app, 'temp_dirs', {}):
             temp_dir = app.temp_dirs[session_key]
-            pnl_file = Path(temp_dir) / 'results' / f'{strategy}_pnl.csv'
+            pnl_file = Path(temp_dir) / 'results' / f'{strategy}_results.bin'
         else:
             return jsonify({'error': 'Session not found. Please run backtest first.'}), 404
         
         if not pnl_file.exists():
             return jsonify({'error': 'File not found'}), 404
         
-        data = {'index': [], 'pnl': []}
-        with open(pnl_file, 'r') as f:
-            reader = csv.DictReader(f)
-            for row in reader:
-                data['index'].append(int(row['Index']))
-                data['pnl'].append(float(row['PnL']))
-        
-        return jsonify(data)
+        columns = read_result_file(pnl_file)['columns']
+        return jsonify({'index': columns['chart_index'].tolist(), 'pnl': columns['chart_pnl'].tolist()})
     except Exception as e:
         return jsonify({'error': str(e)}), 500
 
@@ -176,23 +277,31 @@ def download_file(strategy, file_type):
     """Download CSV file from temp directory"""
     try:
         if file_type == 'pnl':
+            # Converted from the binary results (every tick, not just the points of the chart)
             filename = f'{strategy}_pnl.csv'
+            source_name = f'{strategy}_results.bin'
         elif file_type == 'statistics':
             filename = f'{strategy}_statistics.csv'
+            source_name = filename
         else:
             return jsonify({'error': 'Invalid file type'}), 400
         
-        # Get file from temp directory (not from results/)
-        session_key = app.strategy_sessions.get(strategy)
-        if not session_key or session_key not in app.temp_dirs:
+        # Get from the server results in memory, or from temp directory (not from results/)
+        session_key = getattr(app, 'strategy_sessions', {}).get(strategy)
+        served = getattr(app, 'server_results', {}).get(session_key, {}).get(strategy)
+        if served is not None and file_type == 'statistics':
+            return csv_response(stats_to_csv(served['stats']), filename)
+        if not session_key or session_key not in getattr(app, 'temp_dirs', {}):
             return jsonify({'error': 'Session not found. Please run backtest first.'}), 404
         
         temp_dir = app.temp_dirs[session_key]
-        file_path = Path(temp_dir) / 'results' / filename
+        file_path = Path(temp_dir) / 'results' / source_name
         
         if not file_path.exists():
             return jsonify({'error': 'File not found. Please run backtest first.'}), 404
         
+        if file_path.suffix == '.bin':
+            return csv_response(pnl_to_csv(read_result_file(file_path)), filename)
         return send_file(file_path, as_attachment=True, download_name=filename)
     except Exception as e:
         return jsonify({'error': str(e)}), 500
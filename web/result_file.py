@@ -0,0 +1,71 @@
+"""
+Reader for the binary result files written by the backtest engine
+(<strategy>_results.bin, see Core/ResultFile.h for the layout)
+
+Every column is one contiguous array in the file, so it is loaded with a
+single array.frombytes() call instead of parsing one CSV line per tick.
+"""
+
+import struct
+from array import array
+
+MAGIC = b'BTRSLTS\0'
+VERSION = 2
+
+_HEADER = struct.Struct('=8sIIQQ')           # magic, version, columnCount, seriesCount, maxPoints
+_COLUMN = struct.Struct('=16sIIQQ')          # name, type, reserved, count, offset
+_TYPECODES = {1: 'd', 2: 'Q', 3: 'H', 4: 'b'}  # ResultColumnType -> array typecode
+
+
+def read_result_file(path):
+    """
+    Reads a result file
+
+    Returns a dict with:
+    - 'series_count': number of PnL values recorded in the run
+    - 'max_points': decimation limit of the chart columns (0 = no chart columns)
+    - 'columns': column name -> array of values
+      (index, pnl, return: every tick; fill_time, fill_order, fill_price,
+      fill_volume, fill_side, fill_symbol, fill_fee: every execution;
+      chart_index, chart_pnl: the decimated PnL, if max_points is set)
+
+    Raises ValueError if the file is not a result file of a supported version.
+    """
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if len(data) < _HEADER.size:
+        raise ValueError(f'{path}: file too short for a result file header')
+    magic, version, column_count, series_count, max_points = _HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError(f'{path}: not a result file')
+    if version != VERSION:
+        raise ValueError(f'{path}: unsupported result file version {version}')
+
+    columns = {}
+    for c in range(column_count):
+        name, type_id, _, count, offset = _COLUMN.unpack_from(data, _HEADER.size + c * _COLUMN.size)
+        typecode = _TYPECODES.get(type_id)
+        if typecode is None:
+            raise ValueError(f'{path}: unknown column type {type_id}')
+        values = array(typecode)
+        end = offset + count * values.itemsize
+        if end > len(data):
+            raise ValueError(f'{path}: column runs past the end of the file')
+        values.frombytes(data[offset:end])
+        columns[name.rstrip(b'\0').decode()] = values
+
+    return {'series_count': series_count, 'max_points': max_points, 'columns': columns}
+
+
+def series_to_csv(index, pnl):
+    """Formats PnL points as the engine's <strategy>_pnl.csv"""
+    lines = ['Index,PnL']
+    lines.extend(f'{i},{p:g}' for i, p in zip(index, pnl))
+    return '\n'.join(lines) + '\n'
+
+
+def pnl_to_csv(result):
+    """Formats the index and pnl columns of a result file as the engine's <strategy>_pnl.csv"""
+    columns = result['columns']
+    return series_to_csv(columns['index'], columns['pnl'])